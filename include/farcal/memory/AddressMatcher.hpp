@@ -0,0 +1,131 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace farcal::memory {
+
+// Tests scanned values against a sorted set of target addresses. A branch-free range check
+// against [lowest, highest] target rejects most slots when the targets sit close together (a
+// class's vftables in one image); the survivors are confirmed against up to kInlineTargets
+// targets directly, or for larger sets through a one-bit-per-bucket hash filter and then a binary
+// search.
+class AddressMatcher {
+ public:
+  static constexpr std::size_t kBlockSlots    = 64;
+  static constexpr std::size_t kInlineTargets = 8;
+  static constexpr std::size_t npos           = static_cast<std::size_t>(-1);
+
+  // `sorted_targets` must be sorted and outlive the matcher. An empty set matches nothing.
+  explicit AddressMatcher(const std::vector<std::uintptr_t>& sorted_targets)
+      : m_targets(sorted_targets) {
+    if (sorted_targets.empty()) {
+      return;
+    }
+    m_inline = sorted_targets.size() <= kInlineTargets;
+    // Unused inline lanes repeat the first target, so they never add matches of their own.
+    for (std::size_t i = 0; i < kInlineTargets; ++i) {
+      m_lanes[i] = sorted_targets[i < sorted_targets.size() ? i : 0];
+    }
+    m_low  = sorted_targets.front();
+    m_span = sorted_targets.back() - m_low;
+
+    if (!m_inline) {
+      // About 16 buckets per target keeps false positives near 6%.
+      const std::size_t buckets = std::bit_ceil((std::max)(std::size_t{1024}, sorted_targets.size() * 16));
+      m_filterShift             = 64 - std::countr_zero(buckets);
+      m_filter.assign(buckets / 64, 0);
+      for (const std::uintptr_t target : sorted_targets) {
+        const std::size_t bucket = bucketOf(target);
+        m_filter[bucket / 64] |= std::uint64_t{1} << (bucket % 64);
+      }
+    }
+  }
+
+  bool empty() const { return m_targets.empty(); }
+
+  // Bit `j` is set when the pointer at `data + j * stride` is one of the targets, count <= 64.
+  std::uint64_t match(const std::uint8_t* data, std::size_t count, std::size_t stride = sizeof(std::uintptr_t)) const {
+    if (empty()) {
+      return 0;
+    }
+    // The common pointer-aligned case gets a constant stride.
+    std::uint64_t mask = stride == sizeof(std::uintptr_t) ? rangeMask(data, count, sizeof(std::uintptr_t))
+                                                          : rangeMask(data, count, stride);
+    if (m_span == 0) {
+      return mask;
+    }
+
+    std::uint64_t confirmed = 0;
+    while (mask != 0) {
+      const auto j = static_cast<std::size_t>(std::countr_zero(mask));
+      mask &= mask - 1;
+      if (containsInRange(load(data + j * stride))) {
+        confirmed |= std::uint64_t{1} << j;
+      }
+    }
+    return confirmed;
+  }
+
+  // Index of `value` in the target set, or npos.
+  std::size_t find(std::uintptr_t value) const {
+    if (!contains(value)) {
+      return npos;
+    }
+    return static_cast<std::size_t>(std::lower_bound(m_targets.begin(), m_targets.end(), value) - m_targets.begin());
+  }
+
+  bool contains(std::uintptr_t value) const {
+    return !empty() && value - m_low <= m_span && containsInRange(value);
+  }
+
+ private:
+  // Branch-free so the compiler can vectorize it.
+  std::uint64_t rangeMask(const std::uint8_t* data, std::size_t count, std::size_t stride) const {
+    std::uint64_t mask = 0;
+    for (std::size_t j = 0; j < count; ++j) {
+      mask |= std::uint64_t{(load(data + j * stride) - m_low) <= m_span} << j;
+    }
+    return mask;
+  }
+
+  bool containsInRange(std::uintptr_t value) const {
+    if (!m_inline) {
+      const std::size_t bucket = bucketOf(value);
+      if ((m_filter[bucket / 64] >> (bucket % 64) & 1) == 0) {
+        return false;
+      }
+      return std::binary_search(m_targets.begin(), m_targets.end(), value);
+    }
+    bool equal = false;
+    for (const std::uintptr_t lane : m_lanes) {
+      equal |= value == lane;
+    }
+    return equal;
+  }
+
+  std::size_t bucketOf(std::uintptr_t value) const {
+    return static_cast<std::size_t>((static_cast<std::uint64_t>(value) * 0x9E3779B97F4A7C15ull) >> m_filterShift);
+  }
+
+  static std::uintptr_t load(const std::uint8_t* data) {
+    std::uintptr_t value = 0;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+  }
+
+  const std::vector<std::uintptr_t>&          m_targets;
+  std::array<std::uintptr_t, kInlineTargets> m_lanes{};
+  bool                                        m_inline = true;
+  std::uintptr_t                              m_low    = 0;
+  std::uintptr_t                              m_span   = 0;
+  std::vector<std::uint64_t>                  m_filter;
+  int                                         m_filterShift = 64;
+};
+
+}  // namespace farcal::memory
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace farcal::memory {
+
+struct ChunkScanOptions {
+  std::size_t max_results    = 0;  // 0: no cap
+  std::size_t worker_threads = 0;  // 0: one per hardware thread
+  std::size_t batch_size     = 4096;
+  std::size_t buffer_size    = 0;  // scratch bytes handed to each worker
+  // Sort the results before delivering them. Batches are then held back until the scan completes,
+  // and max_results keeps the first results in that order.
+  bool        ordered = false;
+};
+
+// The worker loop the chunk-parallel finders (InstanceFinder, XrefFinder) share. Workers claim
+// chunk indices in [0, chunk_count) from a shared counter and call
+// `scan_chunk(index, buffer, emit)`, where `buffer` is the worker's own scratch and `emit(result)`
+// keeps a result; emit returns false once the cap is reached, and scan_chunk returns false to stop
+// the worker.
+//
+// Unordered results go to `on_batch(std::vector<Result>&&)` from the worker threads, one call at a
+// time. Ordered results are sorted with `less` and delivered from the calling thread.
+template <typename Result, typename Less, typename ScanChunk, typename BatchCallback>
+void runChunkScan(std::size_t             chunk_count,
+                  const ChunkScanOptions& options,
+                  Less                    less,
+                  ScanChunk&&             scan_chunk,
+                  BatchCallback&&         on_batch) {
+  if (chunk_count == 0) {
+    return;
+  }
+
+  const std::size_t requested = options.worker_threads == 0
+                                    ? static_cast<std::size_t>((std::max)(1u, std::thread::hardware_concurrency()))
+                                    : options.worker_threads;
+  const std::size_t workers     = (std::max)(std::size_t{1}, (std::min)(requested, chunk_count));
+  const std::size_t batch_size  = (std::max)(std::size_t{1}, options.batch_size);
+  const std::size_t max_results =
+      options.max_results == 0 ? (std::numeric_limits<std::size_t>::max)() : options.max_results;
+  // Which results the cap keeps must not depend on the order workers finish chunks in, so an
+  // ordered scan collects everything and truncates after sorting.
+  const std::size_t worker_cap = options.ordered ? (std::numeric_limits<std::size_t>::max)() : max_results;
+
+  std::atomic<std::size_t> next_chunk{0};
+  std::atomic<std::size_t> found{0};
+  std::mutex               emit_mutex;
+  std::vector<Result>      held;
+
+  const auto flush = [&](std::vector<Result>& pending) {
+    if (pending.empty()) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(emit_mutex);
+    if (options.ordered) {
+      held.insert(held.end(), pending.begin(), pending.end());
+    } else {
+      on_batch(std::move(pending));
+    }
+    pending.clear();
+  };
+
+  const auto run = [&]() {
+    std::vector<std::uint8_t> buffer(options.buffer_size);
+    std::vector<Result>       pending;
+    pending.reserve(batch_size);
+
+    // Workers claim results from the shared cap before keeping them, so the cap is exact.
+    const auto emit = [&](const Result& result) {
+      if (found.fetch_add(1, std::memory_order_relaxed) >= worker_cap) {
+        return false;
+      }
+      pending.push_back(result);
+      if (pending.size() >= batch_size) {
+        flush(pending);
+      }
+      return true;
+    };
+
+    for (std::size_t index = next_chunk.fetch_add(1, std::memory_order_relaxed); index < chunk_count;
+         index             = next_chunk.fetch_add(1, std::memory_order_relaxed)) {
+      if (found.load(std::memory_order_relaxed) >= worker_cap || !scan_chunk(index, buffer, emit)) {
+        break;
+      }
+    }
+    flush(pending);
+  };
+
+  if (workers == 1) {
+    run();
+  } else {
+    std::vector<std::future<void>> futures;
+    futures.reserve(workers - 1);
+    for (std::size_t worker_index = 1; worker_index < workers; ++worker_index) {
+      futures.emplace_back(std::async(std::launch::async, run));
+    }
+    run();
+    for (auto& future : futures) {
+      future.get();
+    }
+  }
+
+  if (options.ordered) {
+    std::sort(held.begin(), held.end(), less);
+    if (held.size() > max_results) {
+      held.resize(max_results);
+    }
+    for (std::size_t offset = 0; offset < held.size(); offset += batch_size) {
+      const std::size_t count = (std::min)(batch_size, held.size() - offset);
+      on_batch(std::vector<Result>(held.begin() + static_cast<std::ptrdiff_t>(offset),
+                                   held.begin() + static_cast<std::ptrdiff_t>(offset + count)));
+    }
+  }
+}
+
+}  // namespace farcal::memory
@@ -0,0 +1,205 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace farcal::memory {
+
+// Inheritance graph of the types an RTTI scan found, as built by RttiScanner::extract_hierarchy.
+// Classes are addressed by index and list their direct bases. The reverse (subclass) adjacency is
+// built on the first subclass query and kept as offset/index arrays, so walking every subclass of
+// a class touches only contiguous memory.
+//
+// Not thread-safe: the first subclass query after a change rebuilds the reverse adjacency.
+class ClassHierarchy {
+ public:
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+  struct Base {
+    std::size_t  index = npos;
+    // Offset of the base subobject in the derived class. For virtual bases, which have no fixed
+    // offset, it is where the offset is found instead: the vbptr offset on MSVC (with the slot in
+    // vbtable_offset), the vtable offset of the virtual base offset on Itanium.
+    std::int64_t offset         = 0;
+    std::int32_t vbtable_offset = -1;
+    bool         is_virtual     = false;
+    bool         is_public      = true;
+  };
+
+  struct Class {
+    std::uintptr_t              type_descriptor = 0;
+    std::string                 name;
+    std::vector<std::uintptr_t> vftables;
+    std::vector<Base>           bases;  // direct bases, in declaration order
+    // False when the class is only known as somebody's base, or its RTTI could not be read.
+    bool                        resolved = false;
+  };
+
+  std::size_t size() const { return m_classes.size(); }
+  bool        empty() const { return m_classes.empty(); }
+
+  const Class&              operator[](std::size_t index) const { return m_classes[index]; }
+  const std::vector<Class>& classes() const { return m_classes; }
+
+  std::size_t find(std::uintptr_t type_descriptor) const {
+    const auto it = m_index.find(type_descriptor);
+    return it == m_index.end() ? npos : it->second;
+  }
+
+  // Classes named `name`, either in full or by its last `::` component.
+  std::vector<std::size_t> findByName(std::string_view name) const {
+    std::vector<std::size_t> matches;
+    if (name.empty()) {
+      return matches;
+    }
+    for (std::size_t i = 0; i < m_classes.size(); ++i) {
+      const std::string_view full = m_classes[i].name;
+      if (full == name
+          || (full.size() > name.size() + 2 && full.ends_with(name)
+              && full.substr(full.size() - name.size() - 2, 2) == "::")) {
+        matches.push_back(i);
+      }
+    }
+    return matches;
+  }
+
+  // Index of the class with `type_descriptor`, added with `name` when it is not known yet.
+  std::size_t add(std::uintptr_t type_descriptor, std::string name) {
+    const auto [it, inserted] = m_index.try_emplace(type_descriptor, m_classes.size());
+    if (inserted) {
+      Class entry;
+      entry.type_descriptor = type_descriptor;
+      entry.name            = std::move(name);
+      m_classes.push_back(std::move(entry));
+      m_subclass_offsets.clear();
+    }
+    return it->second;
+  }
+
+  void setVftables(std::size_t index, std::vector<std::uintptr_t> vftables) {
+    m_classes[index].vftables = std::move(vftables);
+  }
+
+  void setBases(std::size_t index, std::vector<Base> bases) {
+    m_classes[index].bases    = std::move(bases);
+    m_classes[index].resolved = true;
+    m_subclass_offsets.clear();
+  }
+
+  std::span<const std::size_t> directSubclassesOf(std::size_t index) {
+    buildSubclassIndex();
+    return std::span<const std::size_t>(m_subclasses.data() + m_subclass_offsets[index],
+                                        m_subclass_offsets[index + 1] - m_subclass_offsets[index]);
+  }
+
+  // Every class deriving from `index`, directly or not, breadth first and each once.
+  std::vector<std::size_t> allSubclassesOf(std::size_t index, bool include_self = false) {
+    buildSubclassIndex();
+    return walk(index, include_self, [this](std::size_t node) {
+      return std::span<const std::size_t>(m_subclasses.data() + m_subclass_offsets[node],
+                                          m_subclass_offsets[node + 1] - m_subclass_offsets[node]);
+    });
+  }
+
+  std::vector<std::size_t> allBasesOf(std::size_t index, bool include_self = false) const {
+    std::vector<std::size_t> bases;
+    std::vector<bool>        seen(m_classes.size(), false);
+    std::vector<std::size_t> pending{index};
+    seen[index] = true;
+    if (include_self) {
+      bases.push_back(index);
+    }
+    while (!pending.empty()) {
+      const std::size_t node = pending.back();
+      pending.pop_back();
+      for (const Base& base : m_classes[node].bases) {
+        if (!seen[base.index]) {
+          seen[base.index] = true;
+          bases.push_back(base.index);
+          pending.push_back(base.index);
+        }
+      }
+    }
+    return bases;
+  }
+
+  bool isDerivedFrom(std::size_t derived, std::size_t base) const {
+    const auto bases = allBasesOf(derived);
+    return std::find(bases.begin(), bases.end(), base) != bases.end();
+  }
+
+  // Vftables of `index` and, optionally, of all its subclasses; what InstanceFinder takes to find
+  // every object that is an `index`.
+  std::vector<std::uintptr_t> vftablesOf(std::size_t index, bool include_subclasses) {
+    std::vector<std::uintptr_t> vftables = m_classes[index].vftables;
+    if (include_subclasses) {
+      for (const std::size_t subclass : allSubclassesOf(index)) {
+        const auto& more = m_classes[subclass].vftables;
+        vftables.insert(vftables.end(), more.begin(), more.end());
+      }
+    }
+    std::sort(vftables.begin(), vftables.end());
+    vftables.erase(std::unique(vftables.begin(), vftables.end()), vftables.end());
+    return vftables;
+  }
+
+ private:
+  void buildSubclassIndex() {
+    if (!m_subclass_offsets.empty()) {
+      return;
+    }
+
+    // Counting sort of (base, derived) edges into one array, grouped by base.
+    m_subclass_offsets.assign(m_classes.size() + 1, 0);
+    for (const Class& entry : m_classes) {
+      for (const Base& base : entry.bases) {
+        ++m_subclass_offsets[base.index + 1];
+      }
+    }
+    for (std::size_t i = 1; i < m_subclass_offsets.size(); ++i) {
+      m_subclass_offsets[i] += m_subclass_offsets[i - 1];
+    }
+
+    m_subclasses.assign(m_subclass_offsets.back(), npos);
+    std::vector<std::size_t> cursor(m_subclass_offsets.begin(), m_subclass_offsets.end() - 1);
+    for (std::size_t derived = 0; derived < m_classes.size(); ++derived) {
+      for (const Base& base : m_classes[derived].bases) {
+        m_subclasses[cursor[base.index]++] = derived;
+      }
+    }
+  }
+
+  template <typename Next>
+  std::vector<std::size_t> walk(std::size_t index, bool include_self, Next&& next) const {
+    std::vector<std::size_t> order;
+    std::vector<bool>        seen(m_classes.size(), false);
+    seen[index] = true;
+    order.push_back(index);
+    for (std::size_t i = 0; i < order.size(); ++i) {
+      for (const std::size_t neighbour : next(order[i])) {
+        if (!seen[neighbour]) {
+          seen[neighbour] = true;
+          order.push_back(neighbour);
+        }
+      }
+    }
+    if (!include_self) {
+      order.erase(order.begin());
+    }
+    return order;
+  }
+
+  std::vector<Class>                              m_classes;
+  std::unordered_map<std::uintptr_t, std::size_t> m_index;
+  std::vector<std::size_t>                        m_subclass_offsets;  // empty until first needed
+  std::vector<std::size_t>                        m_subclasses;
+};
+
+}  // namespace farcal::memory
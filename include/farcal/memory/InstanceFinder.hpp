@@ -0,0 +1,139 @@
+#pragma once
+
+#include "farcal/memory/AddressMatcher.hpp"
+#include "farcal/memory/ChunkScan.hpp"
+#include "farcal/memory/MemoryReader.hpp"
+#include "farcal/memory/MemoryRegions.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace farcal::memory {
+
+// Finds live objects of polymorphic classes: every pointer-aligned slot in writable memory that
+// holds one of the given vftable addresses (e.g. RttiScanner::TypeInfo::vftables) is the start
+// of an instance, or of a base-class subobject for secondary vftables.
+class InstanceFinder {
+ public:
+  struct Instance {
+    std::uintptr_t address = 0;
+    std::uintptr_t vftable = 0;
+  };
+
+  struct ScanOptions {
+    std::size_t max_results    = 0;
+    std::size_t worker_threads = 0;
+    std::size_t batch_size     = 4096;
+    // Deliver results in address order. Batches are then held back until the scan completes
+    // instead of streaming as chunks finish, and max_results keeps the lowest addresses, so the
+    // whole of memory is scanned before the cap applies.
+    bool        sort_by_address = false;
+    // Skip writable sections of loaded images (globals and static objects) and other file-backed
+    // mappings, leaving heaps, stacks and anonymous allocations.
+    bool        heap_only = true;
+  };
+
+  explicit InstanceFinder(const MemoryReader* reader = nullptr) : m_reader(reader) {}
+
+  void setReader(const MemoryReader* reader) { m_reader = reader; }
+
+  std::vector<Instance> find_all(const std::vector<std::uintptr_t>& vftables) const {
+    return find_all(vftables, ScanOptions{});
+  }
+
+  std::vector<Instance> find_all(const std::vector<std::uintptr_t>& vftables,
+                                 const ScanOptions&                 options) const {
+    std::vector<Instance> results;
+    find_all_batched(vftables, options, [&results](std::vector<Instance>&& batch) {
+      results.insert(results.end(), batch.begin(), batch.end());
+    });
+    return results;
+  }
+
+  // Streams instances to `on_batch(std::vector<Instance>&&)` as chunks are scanned. Batches come
+  // from worker threads, one call at a time.
+  template <typename BatchCallback>
+  void find_all_batched(const std::vector<std::uintptr_t>& vftables,
+                        const ScanOptions&                 options,
+                        BatchCallback&&                    on_batch) const {
+    if (m_reader == nullptr || !m_reader->attached() || vftables.empty()) {
+      return;
+    }
+
+    std::vector<std::uintptr_t> targets = vftables;
+    std::sort(targets.begin(), targets.end());
+    targets.erase(std::unique(targets.begin(), targets.end()), targets.end());
+    const AddressMatcher matcher(targets);
+
+    std::vector<Chunk> chunks;
+    for (const auto& region : queryMemoryRegions(*m_reader)) {
+      if (region.writable && !(options.heap_only && region.fileBacked)) {
+        appendChunks(chunks, region.base, region.size);
+      }
+    }
+    if (chunks.empty()) {
+      return;
+    }
+
+    ChunkScanOptions scan_options;
+    scan_options.max_results    = options.max_results;
+    scan_options.worker_threads = options.worker_threads;
+    scan_options.batch_size     = options.batch_size;
+    scan_options.buffer_size    = kChunkSize;
+    scan_options.ordered        = options.sort_by_address;
+
+    const auto by_address = [](const Instance& a, const Instance& b) { return a.address < b.address; };
+    const auto scan_chunk = [&](std::size_t index, std::vector<std::uint8_t>& buffer, auto& emit) {
+      const Chunk& chunk = chunks[index];
+      // Unreadable pages come back zero-filled and so never match a vftable.
+      if (!readChunk(*m_reader, chunk.base, buffer.data(), chunk.size)) {
+        return true;
+      }
+
+      const std::size_t slot_count = chunk.size / sizeof(std::uintptr_t);
+      for (std::size_t block = 0; block < slot_count; block += AddressMatcher::kBlockSlots) {
+        const std::size_t   block_slots = (std::min)(AddressMatcher::kBlockSlots, slot_count - block);
+        const std::uint8_t* data        = buffer.data() + block * sizeof(std::uintptr_t);
+        std::uint64_t       mask        = matcher.match(data, block_slots);
+
+        while (mask != 0) {
+          const std::size_t slot = static_cast<std::size_t>(std::countr_zero(mask));
+          mask &= mask - 1;
+
+          std::uintptr_t vftable = 0;
+          std::memcpy(&vftable, data + slot * sizeof(std::uintptr_t), sizeof(vftable));
+          if (!emit(Instance{chunk.base + static_cast<std::uintptr_t>((block + slot) * sizeof(std::uintptr_t)),
+                             vftable})) {
+            return false;
+          }
+        }
+      }
+      return true;
+    };
+
+    runChunkScan<Instance>(chunks.size(), scan_options, by_address, scan_chunk, on_batch);
+  }
+
+ private:
+  // Regions are page-aligned, so chunks of whole pages never split a pointer slot.
+  struct Chunk {
+    std::uintptr_t base = 0;
+    std::size_t    size = 0;
+  };
+
+  static constexpr std::size_t kChunkSize = 1024 * 1024;
+
+  static void appendChunks(std::vector<Chunk>& chunks, std::uintptr_t base, std::size_t size) {
+    for (std::size_t offset = 0; offset < size; offset += kChunkSize) {
+      chunks.push_back({base + static_cast<std::uintptr_t>(offset), (std::min)(kChunkSize, size - offset)});
+    }
+  }
+
+  const MemoryReader* m_reader = nullptr;
+};
+
+}  // namespace farcal::memory
@@ -0,0 +1,831 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace farcal::memory {
+
+// Demangles the Itanium C++ ABI <type> strings that std::type_info::name() returns on GCC and
+// Clang ("N4game6PlayerE" -> "game::Player"). It covers what class type names contain: nested and
+// local names, templates with type and literal arguments, substitutions, qualified, pointer, array
+// and function types, unnamed types and lambdas. A string is only accepted when it parses
+// completely, which also makes it a validator for candidate names read out of a process.
+class ItaniumDemangler {
+ public:
+  static std::optional<std::string> demangleType(std::string_view mangled) {
+    // GCC marks types with internal linkage with a leading '*' (compare by address, not by name).
+    if (!mangled.empty() && mangled.front() == '*') {
+      mangled.remove_prefix(1);
+    }
+    if (mangled.empty()) {
+      return std::nullopt;
+    }
+
+    ItaniumDemangler parser(mangled);
+    auto             type = parser.parseType();
+    if (!type.has_value() || parser.m_pos != mangled.size()) {
+      return std::nullopt;
+    }
+    return type->text();
+  }
+
+ private:
+  // Types are kept as a declarator split around the spot where a pointer or reference goes, so
+  // "int [3]" becomes "int (*) [3]" and "void ()" becomes "void (*)()" when a pointer is applied.
+  struct Type {
+    std::string left;
+    std::string right;
+    bool        grouped = false;  // `left` ends inside the "(*" of a function or array declarator
+
+    std::string text() const {
+      std::string out = left + right;
+      while (!out.empty() && out.back() == ' ') {
+        out.pop_back();
+      }
+      return out;
+    }
+  };
+
+  static constexpr std::size_t kMaxDepth = 64;
+
+  explicit ItaniumDemangler(std::string_view input) : m_in(input) {}
+
+  bool atEnd() const { return m_pos >= m_in.size(); }
+  char peek(std::size_t ahead = 0) const {
+    return m_pos + ahead < m_in.size() ? m_in[m_pos + ahead] : '\0';
+  }
+  bool consume(char ch) {
+    if (peek() != ch) {
+      return false;
+    }
+    ++m_pos;
+    return true;
+  }
+  bool consume(std::string_view prefix) {
+    if (m_in.substr(m_pos, prefix.size()) != prefix) {
+      return false;
+    }
+    m_pos += prefix.size();
+    return true;
+  }
+
+  static Type plain(std::string text) { return Type{std::move(text), {}, false}; }
+
+  std::optional<std::size_t> parseNumber() {
+    if (atEnd() || peek() < '0' || peek() > '9') {
+      return std::nullopt;
+    }
+    std::size_t value = 0;
+    while (!atEnd() && peek() >= '0' && peek() <= '9') {
+      value = value * 10 + static_cast<std::size_t>(peek() - '0');
+      if (value > m_in.size()) {
+        return std::nullopt;
+      }
+      ++m_pos;
+    }
+    return value;
+  }
+
+  // <seq-id> is base 36 with digits and upper-case letters; an empty id means 0, others are +1.
+  std::optional<std::size_t> parseSeqId() {
+    std::size_t value = 0;
+    bool        any   = false;
+    while (!atEnd() && peek() != '_') {
+      const char ch = peek();
+      std::size_t digit = 0;
+      if (ch >= '0' && ch <= '9') {
+        digit = static_cast<std::size_t>(ch - '0');
+      } else if (ch >= 'A' && ch <= 'Z') {
+        digit = static_cast<std::size_t>(ch - 'A') + 10;
+      } else {
+        return std::nullopt;
+      }
+      value = value * 36 + digit;
+      any   = true;
+      ++m_pos;
+    }
+    if (!consume('_')) {
+      return std::nullopt;
+    }
+    return any ? value + 1 : 0;
+  }
+
+  std::optional<std::string> parseSourceName() {
+    const auto length = parseNumber();
+    if (!length.has_value() || *length == 0 || m_pos + *length > m_in.size()) {
+      return std::nullopt;
+    }
+    std::string_view name = m_in.substr(m_pos, *length);
+    for (const char ch : name) {
+      const bool ok = ch == '_' || ch == '$' || ch == '.' || (ch >= '0' && ch <= '9')
+                      || (ch >= 'A' && ch <= 'Z') || (ch >= 'a' && ch <= 'z');
+      if (!ok) {
+        return std::nullopt;
+      }
+    }
+    m_pos += *length;
+    if (name.substr(0, 10) == "_GLOBAL__N") {
+      return std::string("(anonymous namespace)");
+    }
+    return std::string(name);
+  }
+
+  static std::optional<std::string_view> operatorName(std::string_view code) {
+    static constexpr std::pair<std::string_view, std::string_view> kOperators[] = {
+        {"nw", "operator new"},  {"na", "operator new[]"}, {"dl", "operator delete"},
+        {"da", "operator delete[]"}, {"ps", "operator+"},  {"ng", "operator-"},
+        {"ad", "operator&"},     {"de", "operator*"},      {"co", "operator~"},
+        {"pl", "operator+"},     {"mi", "operator-"},      {"ml", "operator*"},
+        {"dv", "operator/"},     {"rm", "operator%"},      {"an", "operator&"},
+        {"or", "operator|"},     {"eo", "operator^"},      {"aS", "operator="},
+        {"pL", "operator+="},    {"mI", "operator-="},     {"mL", "operator*="},
+        {"dV", "operator/="},    {"rM", "operator%="},     {"aN", "operator&="},
+        {"oR", "operator|="},    {"eO", "operator^="},     {"ls", "operator<<"},
+        {"rs", "operator>>"},    {"lS", "operator<<="},    {"rS", "operator>>="},
+        {"eq", "operator=="},    {"ne", "operator!="},     {"lt", "operator<"},
+        {"gt", "operator>"},     {"le", "operator<="},     {"ge", "operator>="},
+        {"ss", "operator<=>"},   {"nt", "operator!"},      {"aa", "operator&&"},
+        {"oo", "operator||"},    {"pp", "operator++"},     {"mm", "operator--"},
+        {"cm", "operator,"},     {"pm", "operator->*"},    {"pt", "operator->"},
+        {"cl", "operator()"},    {"ix", "operator[]"}};
+    for (const auto& [mangled, name] : kOperators) {
+      if (mangled == code) {
+        return name;
+      }
+    }
+    return std::nullopt;
+  }
+
+  // <unqualified-name>: source names, operators, constructors/destructors (named after `scope`),
+  // unnamed types and closures, each optionally followed by ABI tags.
+  std::optional<std::string> parseUnqualifiedName(const std::string& scope) {
+    // GCC prefixes names with internal linkage with 'L' inside local-name encodings.
+    if (peek() == 'L' && peek(1) >= '1' && peek(1) <= '9') {
+      ++m_pos;
+    }
+
+    std::optional<std::string> name;
+    const char                 ch = peek();
+    if (ch >= '1' && ch <= '9') {
+      name = parseSourceName();
+    } else if (ch == 'C' && (peek(1) >= '1' && peek(1) <= '5')) {
+      m_pos += 2;
+      name = lastComponent(scope);
+    } else if (ch == 'D' && (peek(1) >= '0' && peek(1) <= '5')) {
+      m_pos += 2;
+      name = "~" + lastComponent(scope);
+    } else if (ch == 'U' && peek(1) == 't') {
+      m_pos += 2;
+      const auto index = parseDiscriminatorIndex();
+      if (!index.has_value()) {
+        return std::nullopt;
+      }
+      name = "{unnamed type#" + std::to_string(*index) + "}";
+    } else if (ch == 'U' && peek(1) == 'l') {
+      m_pos += 2;
+      std::string params;
+      if (!parseParameterList(params)) {
+        return std::nullopt;
+      }
+      const auto index = parseDiscriminatorIndex();
+      if (!index.has_value()) {
+        return std::nullopt;
+      }
+      name = "{lambda(" + params + ")#" + std::to_string(*index) + "}";
+    } else if (ch == 'c' && peek(1) == 'v') {
+      m_pos += 2;
+      const auto target = parseType();
+      if (!target.has_value()) {
+        return std::nullopt;
+      }
+      name = "operator " + target->text();
+    } else if (ch >= 'a' && ch <= 'z') {
+      const auto op = operatorName(m_in.substr(m_pos, 2));
+      if (!op.has_value()) {
+        return std::nullopt;
+      }
+      m_pos += 2;
+      name = std::string(*op);
+    }
+    if (!name.has_value()) {
+      return std::nullopt;
+    }
+
+    while (consume('B')) {
+      const auto tag = parseSourceName();
+      if (!tag.has_value()) {
+        return std::nullopt;
+      }
+      *name += "[abi:" + *tag + "]";
+    }
+    return name;
+  }
+
+  // "[<number>] _" after unnamed types and closures; numbering starts at 1 for the first one.
+  std::optional<std::size_t> parseDiscriminatorIndex() {
+    std::size_t index = 1;
+    if (!atEnd() && peek() != '_') {
+      const auto number = parseNumber();
+      if (!number.has_value()) {
+        return std::nullopt;
+      }
+      index = *number + 2;
+    }
+    if (!consume('_')) {
+      return std::nullopt;
+    }
+    return index;
+  }
+
+  static std::string lastComponent(const std::string& scope) {
+    std::size_t depth = 0;
+    for (std::size_t i = scope.size(); i > 0; --i) {
+      const char ch = scope[i - 1];
+      if (ch == '>') {
+        ++depth;
+      } else if (ch == '<' && depth > 0) {
+        --depth;
+      } else if (ch == ':' && depth == 0 && i >= 2 && scope[i - 2] == ':') {
+        return stripTemplateArgs(scope.substr(i));
+      }
+    }
+    return stripTemplateArgs(scope);
+  }
+
+  static std::string stripTemplateArgs(const std::string& name) {
+    const auto open = name.find('<');
+    return open == std::string::npos ? name : name.substr(0, open);
+  }
+
+  // Parameter types up to the closing 'E'; a lone "v" is an empty list.
+  bool parseParameterList(std::string& out) {
+    std::vector<std::string> params;
+    while (!consume('E')) {
+      if (atEnd()) {
+        return false;
+      }
+      const auto type = parseType();
+      if (!type.has_value()) {
+        return false;
+      }
+      params.push_back(type->text());
+    }
+    if (params.size() == 1 && params.front() == "void") {
+      params.clear();
+    }
+    for (std::size_t i = 0; i < params.size(); ++i) {
+      out += (i == 0 ? "" : ", ") + params[i];
+    }
+    return true;
+  }
+
+  std::optional<std::string> parseTemplateArgs() {
+    if (!consume('I')) {
+      return std::nullopt;
+    }
+    std::vector<std::string> args;
+    while (!consume('E')) {
+      if (atEnd()) {
+        return std::nullopt;
+      }
+      const auto arg = parseTemplateArg();
+      if (!arg.has_value()) {
+        return std::nullopt;
+      }
+      args.push_back(*arg);
+    }
+    m_templateArgs = args;
+
+    std::string out = "<";
+    bool        first = true;
+    for (const auto& arg : args) {
+      // An empty pack prints nothing, not an empty argument.
+      if (!arg.empty()) {
+        out += (first ? "" : ", ") + arg;
+        first = false;
+      }
+    }
+    if (out.back() == '>') {
+      out.push_back(' ');
+    }
+    out.push_back('>');
+    return out;
+  }
+
+  std::optional<std::string> parseTemplateArg() {
+    if (peek() == 'L') {
+      return parseLiteral();
+    }
+    if (consume('J')) {
+      std::string pack;
+      while (!consume('E')) {
+        if (atEnd()) {
+          return std::nullopt;
+        }
+        const auto arg = parseTemplateArg();
+        if (!arg.has_value()) {
+          return std::nullopt;
+        }
+        pack += (pack.empty() ? "" : ", ") + *arg;
+      }
+      return pack;
+    }
+    if (consume('X')) {
+      // Expressions are not rendered; skip to the matching 'E'.
+      std::size_t depth = 1;
+      while (!atEnd() && depth > 0) {
+        const char ch = m_in[m_pos++];
+        if (ch == 'E') {
+          --depth;
+        } else if (ch == 'X' || ch == 'I' || ch == 'L' || ch == 'J') {
+          ++depth;
+        }
+      }
+      return depth == 0 ? std::optional<std::string>("(expression)") : std::nullopt;
+    }
+    const auto type = parseType();
+    if (!type.has_value()) {
+      return std::nullopt;
+    }
+    return type->text();
+  }
+
+  // L <type> <value> E, or L _Z <encoding> E for the address of an entity.
+  std::optional<std::string> parseLiteral() {
+    if (!consume('L')) {
+      return std::nullopt;
+    }
+    if (consume("_Z")) {
+      const auto name = parseName();
+      if (!name.has_value() || !consume('E')) {
+        return std::nullopt;
+      }
+      return "&" + *name;
+    }
+
+    const auto type = parseType();
+    if (!type.has_value()) {
+      return std::nullopt;
+    }
+    const bool  negative = consume('n');
+    std::string value;
+    while (!atEnd() && peek() != 'E') {
+      value.push_back(m_in[m_pos++]);
+    }
+    if (!consume('E') || value.empty()) {
+      return std::nullopt;
+    }
+
+    const std::string type_text = type->text();
+    if (type_text == "bool") {
+      return std::string(value == "0" ? "false" : "true");
+    }
+    const std::string number = (negative ? "-" : "") + value;
+    if (type_text == "int") {
+      return number;
+    }
+    if (type_text == "unsigned int") {
+      return number + "u";
+    }
+    if (type_text == "long") {
+      return number + "l";
+    }
+    if (type_text == "unsigned long") {
+      return number + "ul";
+    }
+    return "(" + type_text + ")" + number;
+  }
+
+  std::optional<Type> parseSubstitution() {
+    if (!consume('S')) {
+      return std::nullopt;
+    }
+    static constexpr std::pair<char, std::string_view> kAbbreviations[] = {
+        {'a', "std::allocator"},
+        {'b', "std::basic_string"},
+        {'s', "std::string"},
+        {'i', "std::istream"},
+        {'o', "std::ostream"},
+        {'d', "std::iostream"}};
+    for (const auto& [code, name] : kAbbreviations) {
+      if (consume(code)) {
+        return plain(std::string(name));
+      }
+    }
+    const auto index = parseSeqId();
+    if (!index.has_value() || *index >= m_substitutions.size()) {
+      return std::nullopt;
+    }
+    return m_substitutions[*index];
+  }
+
+  // <nested-name> ::= N [<CV-qualifiers>] [<ref-qualifier>] <prefix component>+ E
+  std::optional<std::string> parseNestedName() {
+    if (!consume('N')) {
+      return std::nullopt;
+    }
+    bool const_member = false;
+    while (peek() == 'r' || peek() == 'V' || peek() == 'K' || peek() == 'R' || peek() == 'O') {
+      const_member = const_member || peek() == 'K';
+      ++m_pos;
+    }
+
+    std::string scope;
+    bool        first = true;
+    while (!consume('E')) {
+      if (atEnd()) {
+        return std::nullopt;
+      }
+      if (peek() == 'I') {
+        if (first) {
+          return std::nullopt;
+        }
+        const auto args = parseTemplateArgs();
+        if (!args.has_value()) {
+          return std::nullopt;
+        }
+        scope += *args;
+      } else if (peek() == 'S' && first) {
+        if (consume("St")) {
+          const auto name = parseUnqualifiedName(scope);
+          if (!name.has_value()) {
+            return std::nullopt;
+          }
+          scope = "std::" + *name;
+        } else {
+          const auto substitution = parseSubstitution();
+          if (!substitution.has_value()) {
+            return std::nullopt;
+          }
+          scope = substitution->text();
+          first = false;
+          continue;
+        }
+      } else if (peek() == 'T' && first) {
+        const auto param = parseTemplateParam();
+        if (!param.has_value()) {
+          return std::nullopt;
+        }
+        scope = *param;
+      } else {
+        const auto name = parseUnqualifiedName(scope);
+        if (!name.has_value()) {
+          return std::nullopt;
+        }
+        scope = first ? *name : scope + "::" + *name;
+      }
+      first = false;
+      m_substitutions.push_back(plain(scope));
+    }
+    if (first) {
+      return std::nullopt;
+    }
+    m_constMember = const_member;
+    return scope;
+  }
+
+  std::optional<std::string> parseTemplateParam() {
+    if (!consume('T')) {
+      return std::nullopt;
+    }
+    const auto index = parseSeqId();
+    if (!index.has_value()) {
+      return std::nullopt;
+    }
+    if (*index < m_templateArgs.size()) {
+      return m_templateArgs[*index];
+    }
+    return "T" + std::to_string(*index);
+  }
+
+  // <local-name> ::= Z <function encoding> E <entity name> [<discriminator>]
+  std::optional<std::string> parseLocalName() {
+    if (!consume('Z')) {
+      return std::nullopt;
+    }
+    const auto function = parseName();
+    if (!function.has_value()) {
+      return std::nullopt;
+    }
+    const bool const_member = m_constMember;
+
+    // Template functions mangle their return type first; it is not part of the printed name.
+    const bool has_template_args = !function->empty() && function->back() == '>';
+    if (has_template_args && !parseType().has_value()) {
+      return std::nullopt;
+    }
+
+    std::string params;
+    if (!parseParameterList(params)) {
+      return std::nullopt;
+    }
+
+    std::string entity;
+    if (consume('s')) {
+      entity = "string literal";
+    } else {
+      const auto name = parseName();
+      if (!name.has_value()) {
+        return std::nullopt;
+      }
+      entity = *name;
+    }
+
+    if (consume('_')) {
+      if (consume('_')) {
+        if (!parseNumber().has_value() || !consume('_')) {
+          return std::nullopt;
+        }
+      } else if (!parseNumber().has_value()) {
+        return std::nullopt;
+      }
+    }
+    return *function + "(" + params + ")" + (const_member ? " const" : "") + "::" + entity;
+  }
+
+  // <name>: nested, local, or unscoped (optionally std::-qualified) with optional template args.
+  std::optional<std::string> parseName() {
+    if (peek() == 'N') {
+      return parseNestedName();
+    }
+    if (peek() == 'Z') {
+      return parseLocalName();
+    }
+
+    std::string name;
+    if (peek() == 'S' && peek(1) != 't') {
+      const auto substitution = parseSubstitution();
+      if (!substitution.has_value() || peek() != 'I') {
+        return std::nullopt;
+      }
+      name = substitution->text();
+    } else {
+      const bool std_scope = consume("St");
+      const auto unqualified = parseUnqualifiedName({});
+      if (!unqualified.has_value()) {
+        return std::nullopt;
+      }
+      name = (std_scope ? "std::" : "") + *unqualified;
+      if (peek() == 'I') {
+        m_substitutions.push_back(plain(name));
+      }
+    }
+
+    if (peek() == 'I') {
+      const auto args = parseTemplateArgs();
+      if (!args.has_value()) {
+        return std::nullopt;
+      }
+      name += *args;
+    }
+    return name;
+  }
+
+  static std::optional<std::string_view> builtinType(char code) {
+    switch (code) {
+      case 'v': return "void";
+      case 'w': return "wchar_t";
+      case 'b': return "bool";
+      case 'c': return "char";
+      case 'a': return "signed char";
+      case 'h': return "unsigned char";
+      case 's': return "short";
+      case 't': return "unsigned short";
+      case 'i': return "int";
+      case 'j': return "unsigned int";
+      case 'l': return "long";
+      case 'm': return "unsigned long";
+      case 'x': return "long long";
+      case 'y': return "unsigned long long";
+      case 'n': return "__int128";
+      case 'o': return "unsigned __int128";
+      case 'f': return "float";
+      case 'd': return "double";
+      case 'e': return "long double";
+      case 'g': return "__float128";
+      case 'z': return "...";
+      default: return std::nullopt;
+    }
+  }
+
+  static std::optional<std::string_view> extendedBuiltinType(char code) {
+    switch (code) {
+      case 'n': return "decltype(nullptr)";
+      case 's': return "char16_t";
+      case 'i': return "char32_t";
+      case 'u': return "char8_t";
+      case 'a': return "auto";
+      case 'c': return "decltype(auto)";
+      case 'h': return "half";
+      default: return std::nullopt;
+    }
+  }
+
+  std::optional<Type> parseType() {
+    if (++m_depth > kMaxDepth || atEnd()) {
+      return std::nullopt;
+    }
+    auto type = parseTypeBody();
+    --m_depth;
+    return type;
+  }
+
+  std::optional<Type> parseTypeBody() {
+    const char ch = peek();
+
+    if (const auto builtin = builtinType(ch); builtin.has_value()) {
+      ++m_pos;
+      return plain(std::string(*builtin));
+    }
+    if (ch == 'u') {
+      ++m_pos;
+      const auto name = parseSourceName();
+      if (!name.has_value()) {
+        return std::nullopt;
+      }
+      return plain(*name);
+    }
+    if (ch == 'D') {
+      if (const auto builtin = extendedBuiltinType(peek(1)); builtin.has_value()) {
+        m_pos += 2;
+        return plain(std::string(*builtin));
+      }
+      if (peek(1) == 'p') {
+        m_pos += 2;
+        auto inner = parseType();
+        if (!inner.has_value()) {
+          return std::nullopt;
+        }
+        inner->left += "...";
+        return addSubstitution(*inner);
+      }
+      return std::nullopt;
+    }
+
+    if (ch == 'K' || ch == 'V' || ch == 'r') {
+      ++m_pos;
+      auto inner = parseType();
+      if (!inner.has_value()) {
+        return std::nullopt;
+      }
+      const char* qualifier = ch == 'K' ? " const" : ch == 'V' ? " volatile" : " restrict";
+      // A qualified pointer to function or array keeps the qualifier inside the parentheses.
+      if (inner->right.empty() || inner->grouped) {
+        inner->left += qualifier;
+      } else {
+        inner->right += qualifier;
+      }
+      return addSubstitution(*inner);
+    }
+
+    if (ch == 'P' || ch == 'R' || ch == 'O') {
+      ++m_pos;
+      auto inner = parseType();
+      if (!inner.has_value()) {
+        return std::nullopt;
+      }
+      const char* declarator = ch == 'P' ? "*" : ch == 'R' ? "&" : "&&";
+      if (inner->right.empty() || inner->grouped) {
+        inner->left += declarator;
+      } else {
+        inner->left += std::string("(") + declarator;
+        inner->right   = (inner->right.front() == '[' ? ") " : ")") + inner->right;
+        inner->grouped = true;
+      }
+      return addSubstitution(*inner);
+    }
+
+    if (ch == 'F') {
+      ++m_pos;
+      consume('Y');
+      const auto result = parseType();
+      if (!result.has_value()) {
+        return std::nullopt;
+      }
+      std::string params;
+      std::vector<std::string> list;
+      while (!consume('E')) {
+        if (atEnd()) {
+          return std::nullopt;
+        }
+        if ((peek() == 'R' || peek() == 'O') && peek(1) == 'E') {
+          ++m_pos;
+          continue;
+        }
+        const auto param = parseType();
+        if (!param.has_value()) {
+          return std::nullopt;
+        }
+        list.push_back(param->text());
+      }
+      if (list.size() == 1 && list.front() == "void") {
+        list.clear();
+      }
+      for (std::size_t i = 0; i < list.size(); ++i) {
+        params += (i == 0 ? "" : ", ") + list[i];
+      }
+      return addSubstitution(Type{result->text() + " ", "(" + params + ")", false});
+    }
+
+    if (ch == 'A') {
+      ++m_pos;
+      std::string dimension;
+      while (!atEnd() && peek() != '_') {
+        dimension.push_back(m_in[m_pos++]);
+      }
+      if (!consume('_')) {
+        return std::nullopt;
+      }
+      auto element = parseType();
+      if (!element.has_value()) {
+        return std::nullopt;
+      }
+      if (element->right.empty()) {
+        element->left += " ";
+      }
+      element->right = "[" + dimension + "]" + element->right;
+      return addSubstitution(*element);
+    }
+
+    if (ch == 'M') {
+      ++m_pos;
+      const auto owner = parseType();
+      if (!owner.has_value()) {
+        return std::nullopt;
+      }
+      auto member = parseType();
+      if (!member.has_value()) {
+        return std::nullopt;
+      }
+      if (member->right.empty()) {
+        member->left += " " + owner->text() + "::*";
+      } else {
+        member->left += "(" + owner->text() + "::*";
+        member->right   = (member->right.front() == '[' ? ") " : ")") + member->right;
+        member->grouped = true;
+      }
+      return addSubstitution(*member);
+    }
+
+    if (ch == 'T') {
+      const auto param = parseTemplateParam();
+      if (!param.has_value()) {
+        return std::nullopt;
+      }
+      Type type = plain(*param);
+      if (peek() == 'I') {
+        addSubstitution(type);
+        const auto args = parseTemplateArgs();
+        if (!args.has_value()) {
+          return std::nullopt;
+        }
+        type.left += *args;
+      }
+      return addSubstitution(type);
+    }
+
+    if (ch == 'S' && peek(1) != 't') {
+      const auto substitution = parseSubstitution();
+      if (!substitution.has_value()) {
+        return std::nullopt;
+      }
+      if (peek() != 'I') {
+        return substitution;
+      }
+      const auto args = parseTemplateArgs();
+      if (!args.has_value()) {
+        return std::nullopt;
+      }
+      return addSubstitution(plain(substitution->text() + *args));
+    }
+
+    // <class-enum-type>
+    const bool nested_or_local = ch == 'N' || ch == 'Z';
+    const auto name            = parseName();
+    if (!name.has_value()) {
+      return std::nullopt;
+    }
+    if (nested_or_local && ch == 'N') {
+      // The complete nested name was already recorded as its last prefix.
+      return plain(*name);
+    }
+    return addSubstitution(plain(*name));
+  }
+
+  Type addSubstitution(Type type) {
+    m_substitutions.push_back(type);
+    return type;
+  }
+
+  std::string_view         m_in;
+  std::size_t              m_pos         = 0;
+  std::size_t              m_depth       = 0;
+  bool                     m_constMember = false;
+  std::vector<Type>        m_substitutions;
+  std::vector<std::string> m_templateArgs;
+};
+
+}  // namespace farcal::memory
@@ -13,6 +13,11 @@
 #define NOMINMAX
 #endif
 #include <windows.h>
+#else
+#include <cstdio>
+#include <string>
+#include <sys/types.h>
+#include <sys/uio.h>
 #endif
 
 namespace farcal::memory
@@ -70,7 +75,12 @@ namespace farcal::memory
 
         bool valid() const noexcept
         {
+#ifdef _WIN32
             return m_nativeHandle != nullptr;
+#else
+            // Linux has no process handle; the id itself is what process_vm_readv addresses.
+            return m_id != 0;
+#endif
         }
 
         void reset() noexcept
@@ -136,8 +146,22 @@ namespace farcal::memory
             m_process.set(processId, processHandle);
             return true;
 #else
-            (void)processId;
-            return false;
+            // Attaching succeeds when the first readable mapping can actually be read, which is
+            // what ptrace access checks (and Yama) decide for process_vm_readv.
+            const auto probe = firstReadableMapping(processId);
+            if (!probe.has_value())
+            {
+                return false;
+            }
+            m_process.set(processId, nullptr);
+            std::uint8_t byte = 0;
+            if (!readBytes(*probe, &byte, sizeof(byte)))
+            {
+                m_process.reset();
+                return false;
+            }
+            m_canWrite = true;
+            return true;
 #endif
         }
 
@@ -174,10 +198,10 @@ namespace farcal::memory
                 &bytesRead);
             return ok != FALSE && bytesRead == static_cast<SIZE_T>(size);
 #else
-            (void)address;
-            (void)outBuffer;
-            (void)size;
-            return false;
+            iovec local{outBuffer, size};
+            iovec remote{reinterpret_cast<void *>(address), size};
+            const ssize_t bytesRead = ::process_vm_readv(static_cast<pid_t>(m_process.id()), &local, 1, &remote, 1, 0);
+            return bytesRead == static_cast<ssize_t>(size);
 #endif
         }
 
@@ -198,10 +222,12 @@ namespace farcal::memory
                 &bytesWritten);
             return ok != FALSE && bytesWritten == static_cast<SIZE_T>(size);
 #else
-            (void)address;
-            (void)inBuffer;
-            (void)size;
-            return false;
+            // Unlike WriteProcessMemory, process_vm_writev honours page protections, so writes to
+            // read-only pages fail.
+            iovec local{const_cast<void *>(inBuffer), size};
+            iovec remote{reinterpret_cast<void *>(address), size};
+            const ssize_t bytesWritten = ::process_vm_writev(static_cast<pid_t>(m_process.id()), &local, 1, &remote, 1, 0);
+            return bytesWritten == static_cast<ssize_t>(size);
 #endif
         }
 
@@ -231,6 +257,33 @@ namespace farcal::memory
         }
 
     private:
+#ifndef _WIN32
+        static std::optional<std::uintptr_t> firstReadableMapping(Process::Id processId)
+        {
+            const std::string path = "/proc/" + std::to_string(processId) + "/maps";
+            std::FILE *maps = std::fopen(path.c_str(), "r");
+            if (maps == nullptr)
+            {
+                return std::nullopt;
+            }
+
+            std::optional<std::uintptr_t> address;
+            unsigned long long start = 0;
+            unsigned long long end = 0;
+            char perms[8]{};
+            char line[512];
+            while (!address.has_value() && std::fgets(line, sizeof(line), maps) != nullptr)
+            {
+                if (std::sscanf(line, "%llx-%llx %7s", &start, &end, perms) == 3 && perms[0] == 'r')
+                {
+                    address = static_cast<std::uintptr_t>(start);
+                }
+            }
+            std::fclose(maps);
+            return address;
+        }
+#endif
+
         Process m_process;
         bool m_canWrite = false;
     };
@@ -0,0 +1,163 @@
+#pragma once
+
+#include "farcal/memory/MemoryReader.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#ifndef _WIN32
+#include <cstdio>
+#include <string>
+#endif
+
+namespace farcal::memory
+{
+
+    // A committed range of the target's address space and what it may be used for.
+    struct MemoryRegion
+    {
+        std::uintptr_t base = 0;
+        std::size_t size = 0;
+        bool readable = false;
+        bool writable = false;
+        bool executable = false;
+        // Windows: a section of a loaded image (MEM_IMAGE). Linux: a mapping of a file.
+        bool fileBacked = false;
+
+        std::uintptr_t end() const noexcept
+        {
+            const std::uintptr_t limit = (std::numeric_limits<std::uintptr_t>::max)();
+            return size > limit - base ? limit : base + static_cast<std::uintptr_t>(size);
+        }
+    };
+
+    // Committed regions of the attached process in ascending address order. Guard and no-access
+    // pages are reported as unreadable rather than left out, so callers filter on the flags.
+    inline std::vector<MemoryRegion> queryMemoryRegions(const MemoryReader &reader)
+    {
+        std::vector<MemoryRegion> regions;
+        if (!reader.attached())
+        {
+            return regions;
+        }
+
+#ifdef _WIN32
+        const HANDLE process = reader.process().nativeHandle();
+
+        SYSTEM_INFO systemInfo{};
+        ::GetSystemInfo(&systemInfo);
+
+        std::uintptr_t cursor = reinterpret_cast<std::uintptr_t>(systemInfo.lpMinimumApplicationAddress);
+        const std::uintptr_t maxAddress = reinterpret_cast<std::uintptr_t>(systemInfo.lpMaximumApplicationAddress);
+
+        while (cursor < maxAddress)
+        {
+            MEMORY_BASIC_INFORMATION mbi{};
+            if (::VirtualQueryEx(process, reinterpret_cast<LPCVOID>(cursor), &mbi, sizeof(mbi)) == 0)
+            {
+                // Unqueryable addresses do not end the walk; step over a page and keep going.
+                cursor += 0x1000;
+                continue;
+            }
+
+            const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(mbi.BaseAddress);
+            const std::uintptr_t next = base + static_cast<std::uintptr_t>(mbi.RegionSize);
+
+            if (mbi.State == MEM_COMMIT)
+            {
+                const DWORD protect = mbi.Protect & 0xFF;
+                const bool accessible = (mbi.Protect & (PAGE_GUARD | PAGE_NOACCESS)) == 0;
+
+                MemoryRegion region;
+                region.base = base;
+                region.size = static_cast<std::size_t>(mbi.RegionSize);
+                region.readable = accessible
+                    && (protect == PAGE_READONLY || protect == PAGE_READWRITE || protect == PAGE_WRITECOPY
+                        || protect == PAGE_EXECUTE_READ || protect == PAGE_EXECUTE_READWRITE
+                        || protect == PAGE_EXECUTE_WRITECOPY);
+                region.writable = accessible
+                    && (protect == PAGE_READWRITE || protect == PAGE_WRITECOPY || protect == PAGE_EXECUTE_READWRITE
+                        || protect == PAGE_EXECUTE_WRITECOPY);
+                region.executable = protect == PAGE_EXECUTE || protect == PAGE_EXECUTE_READ
+                    || protect == PAGE_EXECUTE_READWRITE || protect == PAGE_EXECUTE_WRITECOPY;
+                region.fileBacked = mbi.Type == MEM_IMAGE;
+                regions.push_back(region);
+            }
+
+            if (next <= cursor)
+            {
+                break;
+            }
+            cursor = next;
+        }
+#else
+        const std::string path = "/proc/" + std::to_string(reader.process().id()) + "/maps";
+        std::FILE *maps = std::fopen(path.c_str(), "r");
+        if (maps == nullptr)
+        {
+            return regions;
+        }
+
+        char line[4096];
+        while (std::fgets(line, sizeof(line), maps) != nullptr)
+        {
+            unsigned long long start = 0;
+            unsigned long long end = 0;
+            char perms[8]{};
+            int pathStart = 0;
+            if (std::sscanf(line, "%llx-%llx %7s %*s %*s %*s %n", &start, &end, perms, &pathStart) < 3 || end <= start)
+            {
+                continue;
+            }
+
+            MemoryRegion region;
+            region.base = static_cast<std::uintptr_t>(start);
+            region.size = static_cast<std::size_t>(end - start);
+            region.readable = perms[0] == 'r';
+            region.writable = perms[0] == 'r' && perms[1] == 'w';
+            region.executable = perms[2] == 'x';
+            region.fileBacked = pathStart > 0 && line[pathStart] == '/';
+            regions.push_back(region);
+        }
+        std::fclose(maps);
+#endif
+
+        std::sort(regions.begin(), regions.end(), [](const MemoryRegion &lhs, const MemoryRegion &rhs)
+                  { return lhs.base < rhs.base; });
+        return regions;
+    }
+
+    // Reads [base, base + size) in one call, falling back to page-sized reads when part of it is
+    // unreadable. Unreadable pages are zero-filled; false only when no page could be read at all.
+    inline bool readChunk(const MemoryReader &reader, std::uintptr_t base, std::uint8_t *buffer, std::size_t size)
+    {
+        constexpr std::size_t kPageSize = 4096;
+
+        if (reader.readBytes(base, buffer, size))
+        {
+            return true;
+        }
+
+        bool anyRead = false;
+        for (std::size_t offset = 0; offset < size;)
+        {
+            const std::uintptr_t address = base + static_cast<std::uintptr_t>(offset);
+            const std::size_t step = (std::min)(size - offset, kPageSize - static_cast<std::size_t>(address % kPageSize));
+            if (reader.readBytes(address, buffer + offset, step))
+            {
+                anyRead = true;
+            }
+            else
+            {
+                std::memset(buffer + offset, 0, step);
+            }
+            offset += step;
+        }
+        return anyRead;
+    }
+
+} // namespace farcal::memory
@@ -0,0 +1,411 @@
+#pragma once
+
+#include "farcal/memory/MemoryReader.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifdef _WIN32
+#  ifndef WIN32_LEAN_AND_MEAN
+#    define WIN32_LEAN_AND_MEAN
+#  endif
+#  include <windows.h>
+#  include <tlhelp32.h>
+#endif
+
+namespace farcal::memory {
+
+enum class ModuleFormat {
+  Pe = 0,
+  Elf
+};
+
+// A PE section, or an ELF PT_LOAD segment (section headers are usually not mapped, so segments are
+// the finest layout that can be read out of a running process). ELF segments are named after their
+// permissions, e.g. "r-x".
+struct ModuleSection {
+  std::string    name;
+  std::uintptr_t base       = 0;
+  std::size_t    size       = 0;
+  bool           readable   = false;
+  bool           writable   = false;
+  bool           executable = false;
+};
+
+struct ModuleInfo {
+  std::string                name;
+  std::string                path;
+  std::uintptr_t             base   = 0;
+  std::size_t                size   = 0;
+  ModuleFormat               format = ModuleFormat::Pe;
+  std::vector<ModuleSection> sections;
+  // Identifies the build rather than the mapping: a hash of the PE TimeDateStamp, CheckSum and
+  // SizeOfImage, or of the ELF GNU build-id (of the ELF and program headers when there is none).
+  std::uint64_t              header_hash = 0;
+};
+
+// Lists the images loaded in the attached process and reads their layout from the PE or ELF headers
+// in the target's memory: Toolhelp module snapshots on Windows, /proc/<pid>/maps on Linux.
+class ModuleEnumerator {
+ public:
+  explicit ModuleEnumerator(const MemoryReader* reader = nullptr) : m_reader(reader) {}
+
+  void setReader(const MemoryReader* reader) { m_reader = reader; }
+
+  // Modules sorted by base address. Images whose headers cannot be read or parsed are skipped.
+  std::vector<ModuleInfo> enumerate() const {
+    std::vector<ModuleInfo> modules;
+    if (m_reader == nullptr || !m_reader->attached()) {
+      return modules;
+    }
+
+    for (ModuleInfo& module : listLoadedImages()) {
+      if (parseHeaders(module)) {
+        modules.push_back(std::move(module));
+      }
+    }
+
+    std::sort(modules.begin(), modules.end(), [](const ModuleInfo& a, const ModuleInfo& b) {
+      return a.base < b.base;
+    });
+    return modules;
+  }
+
+  // Case-insensitive match against the module file name, as Windows loaders compare them.
+  static bool nameMatches(const ModuleInfo& module, std::string_view name) {
+    if (module.name.size() != name.size()) {
+      return false;
+    }
+    for (std::size_t i = 0; i < name.size(); ++i) {
+      if (foldAscii(module.name[i]) != foldAscii(name[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  static constexpr std::size_t kHeaderReadSize = 4096;
+
+  static char foldAscii(char ch) {
+    return (ch >= 'A' && ch <= 'Z') ? static_cast<char>(ch - 'A' + 'a') : ch;
+  }
+
+  static std::uint64_t hashBytes(std::uint64_t hash, const void* data, std::size_t size) {
+    const auto* bytes = static_cast<const std::uint8_t*>(data);
+    for (std::size_t i = 0; i < size; ++i) {
+      hash = (hash ^ bytes[i]) * 0x100000001B3ull;
+    }
+    return hash;
+  }
+
+  static constexpr std::uint64_t kHashSeed = 0xCBF29CE484222325ull;
+
+  template <typename T>
+  static T readField(const std::uint8_t* data, std::size_t offset) {
+    T value{};
+    std::memcpy(&value, data + offset, sizeof(T));
+    return value;
+  }
+
+#ifdef _WIN32
+  static std::string wideToUtf8(const wchar_t* text) {
+    const int required = ::WideCharToMultiByte(CP_UTF8, 0, text, -1, nullptr, 0, nullptr, nullptr);
+    if (required <= 1) {
+      return {};
+    }
+    std::string out(static_cast<std::size_t>(required), '\0');
+    ::WideCharToMultiByte(CP_UTF8, 0, text, -1, out.data(), required, nullptr, nullptr);
+    out.pop_back();
+    return out;
+  }
+#endif
+
+  // Name, path, base and mapped size of every loaded image; sections are filled in from headers.
+  std::vector<ModuleInfo> listLoadedImages() const {
+    std::vector<ModuleInfo> images;
+
+#ifdef _WIN32
+    const HANDLE snapshot = ::CreateToolhelp32Snapshot(TH32CS_SNAPMODULE | TH32CS_SNAPMODULE32,
+                                                       static_cast<DWORD>(m_reader->process().id()));
+    if (snapshot == INVALID_HANDLE_VALUE) {
+      return images;
+    }
+
+    MODULEENTRY32W entry{};
+    entry.dwSize = sizeof(entry);
+    if (::Module32FirstW(snapshot, &entry) != FALSE) {
+      do {
+        ModuleInfo module;
+        module.name = wideToUtf8(entry.szModule);
+        module.path = wideToUtf8(entry.szExePath);
+        module.base = reinterpret_cast<std::uintptr_t>(entry.modBaseAddr);
+        module.size = static_cast<std::size_t>(entry.modBaseSize);
+        images.push_back(std::move(module));
+      } while (::Module32NextW(snapshot, &entry) != FALSE);
+    }
+    ::CloseHandle(snapshot);
+#else
+    // A file is an image candidate when it has a mapping of file offset 0; its extent runs to the
+    // end of the last mapping of the same file.
+    const std::string path = "/proc/" + std::to_string(m_reader->process().id()) + "/maps";
+    std::FILE*        maps = std::fopen(path.c_str(), "r");
+    if (maps == nullptr) {
+      return images;
+    }
+
+    struct Extent {
+      std::uintptr_t base       = 0;
+      std::uintptr_t end        = 0;
+      bool           has_header = false;
+    };
+    std::map<std::string, Extent> extents;
+
+    char line[4096];
+    while (std::fgets(line, sizeof(line), maps) != nullptr) {
+      unsigned long long start      = 0;
+      unsigned long long end        = 0;
+      unsigned long long offset     = 0;
+      int                path_start = 0;
+      if (std::sscanf(line, "%llx-%llx %*s %llx %*s %*s %n", &start, &end, &offset, &path_start) < 3
+          || path_start <= 0 || line[path_start] != '/') {
+        continue;
+      }
+      std::string file(line + path_start);
+      while (!file.empty() && (file.back() == '\n' || file.back() == '\r')) {
+        file.pop_back();
+      }
+
+      Extent& extent = extents[file];
+      if (offset == 0 && !extent.has_header) {
+        extent.base       = static_cast<std::uintptr_t>(start);
+        extent.has_header = true;
+      }
+      extent.end = (std::max)(extent.end, static_cast<std::uintptr_t>(end));
+    }
+    std::fclose(maps);
+
+    for (const auto& [file, extent] : extents) {
+      if (!extent.has_header || extent.end <= extent.base) {
+        continue;
+      }
+      ModuleInfo module;
+      module.path = file;
+      module.name = file.substr(file.find_last_of('/') + 1);
+      module.base = extent.base;
+      module.size = static_cast<std::size_t>(extent.end - extent.base);
+      images.push_back(std::move(module));
+    }
+#endif
+
+    return images;
+  }
+
+  bool parseHeaders(ModuleInfo& module) const {
+    std::uint8_t      header[kHeaderReadSize]{};
+    const std::size_t header_size = (std::min)(kHeaderReadSize, module.size);
+    if (header_size < 64 || !m_reader->readBytes(module.base, header, header_size)) {
+      return false;
+    }
+
+    if (header[0] == 'M' && header[1] == 'Z') {
+      return parsePe(module, header, header_size);
+    }
+    if (header[0] == 0x7F && header[1] == 'E' && header[2] == 'L' && header[3] == 'F') {
+      return parseElf(module, header, header_size);
+    }
+    return false;
+  }
+
+  static bool parsePe(ModuleInfo& module, const std::uint8_t* header, std::size_t header_size) {
+    constexpr std::uint32_t kSectionExecute    = 0x20000000;
+    constexpr std::uint32_t kSectionRead       = 0x40000000;
+    constexpr std::uint32_t kSectionWrite      = 0x80000000;
+    constexpr std::size_t   kSectionHeaderSize = 40;
+
+    const auto nt_offset = static_cast<std::size_t>(readField<std::uint32_t>(header, 0x3C));
+    if (nt_offset + 24 > header_size || std::memcmp(header + nt_offset, "PE\0\0", 4) != 0) {
+      return false;
+    }
+
+    const auto        section_count = readField<std::uint16_t>(header, nt_offset + 6);
+    const auto        optional_size = readField<std::uint16_t>(header, nt_offset + 20);
+    const std::size_t optional      = nt_offset + 24;
+    if (optional + 60 <= header_size) {
+      // SizeOfImage sits at the same offset in PE32 and PE32+ optional headers.
+      const auto image_size = readField<std::uint32_t>(header, optional + 56);
+      if (image_size != 0) {
+        module.size = static_cast<std::size_t>(image_size);
+      }
+    }
+
+    // TimeDateStamp and CheckSum (also at the same offset in both optional header formats).
+    module.header_hash = hashBytes(kHashSeed, header + nt_offset + 8, 4);
+    if (optional + 68 <= header_size) {
+      module.header_hash = hashBytes(module.header_hash, header + optional + 56, 12);
+    }
+
+    const std::size_t table = optional + optional_size;
+    for (std::size_t i = 0; i < section_count; ++i) {
+      const std::size_t entry = table + i * kSectionHeaderSize;
+      if (entry + kSectionHeaderSize > header_size) {
+        break;
+      }
+
+      const char* raw_name        = reinterpret_cast<const char*>(header + entry);
+      const auto  virtual_size    = readField<std::uint32_t>(header, entry + 8);
+      const auto  virtual_address = readField<std::uint32_t>(header, entry + 12);
+      const auto  raw_size        = readField<std::uint32_t>(header, entry + 16);
+      const auto  characteristics = readField<std::uint32_t>(header, entry + 36);
+
+      ModuleSection section;
+      section.name       = std::string(raw_name, std::find(raw_name, raw_name + 8, '\0'));
+      section.base       = module.base + virtual_address;
+      section.size       = static_cast<std::size_t>(virtual_size != 0 ? virtual_size : raw_size);
+      section.readable   = (characteristics & kSectionRead) != 0;
+      section.writable   = (characteristics & kSectionWrite) != 0;
+      section.executable = (characteristics & kSectionExecute) != 0;
+      if (section.size != 0 && virtual_address < module.size) {
+        section.size = (std::min)(section.size, module.size - virtual_address);
+        module.sections.push_back(std::move(section));
+      }
+    }
+
+    module.format = ModuleFormat::Pe;
+    return true;
+  }
+
+  bool parseElf(ModuleInfo& module, const std::uint8_t* header, std::size_t header_size) const {
+    constexpr std::uint32_t kPtLoad  = 1;
+    constexpr std::uint32_t kPtNote  = 4;
+    constexpr std::uint32_t kFlagX   = 1;
+    constexpr std::uint32_t kFlagW   = 2;
+    constexpr std::uint32_t kFlagR   = 4;
+    constexpr std::uint8_t  kClass64 = 2;
+
+    const bool is64 = header[4] == kClass64;
+    if (header_size < (is64 ? 64u : 52u)) {
+      return false;
+    }
+
+    const std::uint64_t ph_offset =
+        is64 ? readField<std::uint64_t>(header, 32) : readField<std::uint32_t>(header, 28);
+    const std::size_t ph_entry_size = readField<std::uint16_t>(header, is64 ? 54 : 42);
+    const std::size_t ph_count      = readField<std::uint16_t>(header, is64 ? 56 : 44);
+    if (ph_count == 0 || ph_entry_size < (is64 ? 56u : 32u) || ph_offset >= module.size) {
+      return false;
+    }
+
+    std::vector<std::uint8_t> table(ph_entry_size * ph_count);
+    if (!m_reader->readBytes(
+            module.base + static_cast<std::uintptr_t>(ph_offset), table.data(), table.size())) {
+      return false;
+    }
+
+    struct Segment {
+      std::uint64_t vaddr = 0;
+      std::uint64_t size  = 0;
+      std::uint32_t flags = 0;
+    };
+    std::vector<Segment> segments;
+    std::vector<Segment> notes;
+    for (std::size_t i = 0; i < ph_count; ++i) {
+      const std::uint8_t* entry = table.data() + i * ph_entry_size;
+      const auto          type  = readField<std::uint32_t>(entry, 0);
+      if (type == kPtNote) {
+        notes.push_back({is64 ? readField<std::uint64_t>(entry, 16) : readField<std::uint32_t>(entry, 8),
+                         is64 ? readField<std::uint64_t>(entry, 40) : readField<std::uint32_t>(entry, 20),
+                         0});
+      }
+      if (type != kPtLoad) {
+        continue;
+      }
+      Segment segment;
+      segment.flags = readField<std::uint32_t>(entry, is64 ? 4 : 24);
+      segment.vaddr = is64 ? readField<std::uint64_t>(entry, 16) : readField<std::uint32_t>(entry, 8);
+      segment.size  = is64 ? readField<std::uint64_t>(entry, 40) : readField<std::uint32_t>(entry, 20);
+      if (segment.size != 0) {
+        segments.push_back(segment);
+      }
+    }
+    if (segments.empty()) {
+      return false;
+    }
+
+    // The first PT_LOAD maps file offset 0, so its page-aligned address is where the image starts;
+    // the difference to the actual mapping is the load bias (0 for non-PIE executables).
+    constexpr std::uint64_t kPageMask = 0xFFF;
+    const std::uintptr_t    bias =
+        module.base - static_cast<std::uintptr_t>(segments.front().vaddr & ~kPageMask);
+
+    std::uintptr_t end = module.base;
+    for (const Segment& segment : segments) {
+      ModuleSection section;
+      section.readable   = (segment.flags & kFlagR) != 0;
+      section.writable   = (segment.flags & kFlagW) != 0;
+      section.executable = (segment.flags & kFlagX) != 0;
+      section.name       = {section.readable ? 'r' : '-',
+                            section.writable ? 'w' : '-',
+                            section.executable ? 'x' : '-'};
+      section.base       = bias + static_cast<std::uintptr_t>(segment.vaddr);
+      section.size       = static_cast<std::size_t>(segment.size);
+      end                = (std::max)(end, section.base + section.size);
+      module.sections.push_back(std::move(section));
+    }
+
+    module.size   = static_cast<std::size_t>(end - module.base);
+    module.format = ModuleFormat::Elf;
+
+    module.header_hash = 0;
+    for (const Segment& note : notes) {
+      if (readBuildId(bias + static_cast<std::uintptr_t>(note.vaddr), note.size, module.header_hash)) {
+        break;
+      }
+    }
+    if (module.header_hash == 0) {
+      module.header_hash = hashBytes(hashBytes(kHashSeed, header, is64 ? 64 : 52), table.data(), table.size());
+    }
+    return true;
+  }
+
+  // Hashes the descriptor of the NT_GNU_BUILD_ID note in the PT_NOTE segment at `address`.
+  bool readBuildId(std::uintptr_t address, std::uint64_t size, std::uint64_t& hash) const {
+    constexpr std::uint32_t kNtGnuBuildId = 3;
+    constexpr std::uint64_t kMaxNoteSize  = 4096;
+
+    std::vector<std::uint8_t> data(static_cast<std::size_t>((std::min)(size, kMaxNoteSize)));
+    if (data.empty() || !m_reader->readBytes(address, data.data(), data.size())) {
+      return false;
+    }
+
+    const auto align4 = [](std::size_t value) { return (value + 3) & ~std::size_t{3}; };
+    for (std::size_t offset = 0; offset + 12 <= data.size();) {
+      const std::size_t name_size = readField<std::uint32_t>(data.data(), offset);
+      const std::size_t desc_size = readField<std::uint32_t>(data.data(), offset + 4);
+      const auto        type      = readField<std::uint32_t>(data.data(), offset + 8);
+      const std::size_t name      = offset + 12;
+      const std::size_t desc      = name + align4(name_size);
+      if (name_size > data.size() || desc_size > data.size() || desc + desc_size > data.size()) {
+        return false;
+      }
+      if (type == kNtGnuBuildId && name_size == 4 && std::memcmp(data.data() + name, "GNU", 4) == 0
+          && desc_size != 0) {
+        hash = hashBytes(kHashSeed, data.data() + desc, desc_size);
+        return true;
+      }
+      offset = desc + align4(desc_size);
+    }
+    return false;
+  }
+
+  const MemoryReader* m_reader = nullptr;
+};
+
+}  // namespace farcal::memory
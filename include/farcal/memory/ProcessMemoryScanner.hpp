@@ -4,8 +4,12 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <filesystem>
 #include <functional>
+#include <memory>
 #include <optional>
+#include <span>
+#include <stop_token>
 #include <string>
 #include <vector>
 
@@ -39,15 +43,81 @@ struct ScanSettings {
   std::size_t   alignment = 1;
 };
 
-struct ScanEntry {
-  std::uintptr_t           address = 0;
-  std::vector<std::uint8_t> previousValue;
-  std::vector<std::uint8_t> currentValue;
+// Finds pointer-sized slots that point at `targetAddress` or up to `maxOffset` bytes before it,
+// i.e. candidate base pointers of a structure containing the target.
+struct PointerScanSettings {
+  std::uintptr_t targetAddress   = 0;
+  std::size_t    maxOffset       = 0x1000;
+  bool           includeReadOnly = false;
+};
+
+// Column-oriented result storage: one address column plus two packed value columns with a
+// fixed stride, so scan kernels can walk plain arrays instead of per-entry heap buffers. A set
+// loaded from a session file borrows its columns from the file mapping until it is modified.
+class ScanResultSet final {
+ public:
+  void clear() noexcept;
+  void reset(std::size_t valueSize);
+  void reserve(std::size_t count);
+  void push(std::uintptr_t address, const std::uint8_t* previous, const std::uint8_t* current);
+
+  [[nodiscard]] std::size_t size() const noexcept {
+    return m_mapped.has_value() ? m_mapped->count : m_addresses.size();
+  }
+  [[nodiscard]] bool           empty() const noexcept { return size() == 0; }
+  [[nodiscard]] bool           mapped() const noexcept { return m_mapped.has_value(); }
+  [[nodiscard]] std::size_t    valueSize() const noexcept { return m_valueSize; }
+  [[nodiscard]] std::uintptr_t address(std::size_t index) const { return addresses()[index]; }
+  [[nodiscard]] std::span<const std::uint8_t> previousValue(std::size_t index) const;
+  [[nodiscard]] std::span<const std::uint8_t> currentValue(std::size_t index) const;
+
+  [[nodiscard]] std::span<const std::uintptr_t> addresses() const noexcept;
+  [[nodiscard]] std::span<const std::uint8_t>   previousColumn() const noexcept;
+  [[nodiscard]] std::span<const std::uint8_t>   currentColumn() const noexcept;
+
+ private:
+  friend class ProcessMemoryScanner;
+
+  struct MappedColumns {
+    std::shared_ptr<const void> backing;
+    const std::uintptr_t*       addresses = nullptr;
+    const std::uint8_t*         previous  = nullptr;
+    const std::uint8_t*         current   = nullptr;
+    std::size_t                 count     = 0;
+  };
+
+  void detach();
+
+  std::size_t                  m_valueSize = 0;
+  std::vector<std::uintptr_t>  m_addresses;
+  std::vector<std::uint8_t>    m_previous;
+  std::vector<std::uint8_t>    m_current;
+  std::optional<MappedColumns> m_mapped;
+};
+
+struct ScanProgress {
+  std::uint64_t bytesDone      = 0;
+  std::uint64_t bytesTotal     = 0;
+  std::size_t   resultCount    = 0;
+  double        bytesPerSecond = 0.0;
+  double        etaSeconds     = 0.0;
 };
 
 class ProcessMemoryScanner final {
  public:
-  using ProgressCallback = std::function<void(std::size_t, std::size_t)>;
+  using ProgressCallback = std::function<void(const ScanProgress&)>;
+  // Invoked on the scanning thread with the results gathered so far; entries from `firstNewIndex`
+  // onward were added since the previous call. The set is only valid for the duration of the call.
+  using ResultsCallback =
+      std::function<void(const ScanResultSet& partial, std::size_t firstNewIndex)>;
+
+  // Optional hooks for a running scan. Progress and results are throttled; a stop request makes
+  // the scan return false promptly and leaves the previous result set in place.
+  struct Observer {
+    ProgressCallback progress;
+    ResultsCallback  results;
+    std::stop_token  stopToken;
+  };
 
   explicit ProcessMemoryScanner(const MemoryReader* reader = nullptr);
 
@@ -56,16 +126,27 @@ class ProcessMemoryScanner final {
 
   [[nodiscard]] bool firstScan(const ScanSettings& settings,
                                const std::string&  query,
-                               ProgressCallback    progress = {});
+                               const Observer&     observer = {});
   [[nodiscard]] bool nextScan(const ScanSettings& settings,
                               const std::string&  query,
-                              ProgressCallback    progress = {});
+                              const Observer&     observer = {});
+  // Replaces the results with every pointer matching `settings`; the set behaves like a pointer-width
+  // integer scan, so Next Scan can narrow it further (e.g. Unchanged Value across restarts).
+  [[nodiscard]] bool pointerScan(const PointerScanSettings& settings, const Observer& observer = {});
   [[nodiscard]] bool undo();
 
-  [[nodiscard]] const std::vector<ScanEntry>& results() const noexcept;
+  // Session files store the settings, the current result set and the undo chain as raw columns,
+  // so loading maps the file instead of parsing it. A compact export keeps only the current
+  // addresses (delta-encoded) and values; it loads without history or previous values.
+  [[nodiscard]] bool saveSession(const std::filesystem::path& path);
+  [[nodiscard]] bool exportCompact(const std::filesystem::path& path);
+  [[nodiscard]] bool loadSession(const std::filesystem::path& path);
+
+  [[nodiscard]] const ScanResultSet&          results() const noexcept;
   [[nodiscard]] std::size_t                   resultCount() const noexcept;
   [[nodiscard]] const ScanSettings&           lastSettings() const noexcept;
   [[nodiscard]] const std::string&            lastError() const noexcept;
+  [[nodiscard]] bool                          lastScanCancelled() const noexcept;
 
  private:
   struct Region {
@@ -80,32 +161,36 @@ class ProcessMemoryScanner final {
   [[nodiscard]] bool scanAllRegionsExact(const ScanSettings&          settings,
                                          const std::vector<Region>&   regions,
                                          const std::vector<std::uint8_t>& queryBytes,
-                                         std::vector<ScanEntry>&      outEntries,
-                                         const ProgressCallback&       progress);
+                                         ScanResultSet&               outEntries,
+                                         const Observer&              observer);
+  // `kernel` is a first-scan kernel from ScanKernels.hpp; only ProcessMemoryScanner.cpp calls this.
+  template <typename Kernel>
+  [[nodiscard]] bool scanRegions(const std::vector<Region>&       regions,
+                                 Kernel                           kernel,
+                                 const std::vector<std::uint8_t>& queryBytes,
+                                 std::size_t                      valueSize,
+                                 ScanResultSet&                   outEntries,
+                                 const Observer&                  observer);
   [[nodiscard]] bool rescanExisting(const ScanSettings&    settings,
                                     const std::vector<std::uint8_t>& queryBytes,
-                                    const ProgressCallback& progress);
+                                    ScanResultSet&         outEntries,
+                                    const Observer&        observer);
+  void gatherValues(const std::uintptr_t* addresses,
+                    std::size_t           count,
+                    std::size_t           valueSize,
+                    std::uint8_t*         outValues,
+                    std::uint8_t*         outReadable) const;
+  bool checkCancelled(const Observer& observer);
 
   [[nodiscard]] static std::size_t valueSizeFromSettings(const ScanSettings& settings,
                                                          std::size_t         queryByteLength = 0);
-  [[nodiscard]] static bool        isNumericType(ScanValueType valueType);
-  [[nodiscard]] bool               matchesCondition(const ScanSettings&            settings,
-                                                    const std::vector<std::uint8_t>& queryBytes,
-                                                    const std::vector<std::uint8_t>& previous,
-                                                    const std::vector<std::uint8_t>& current) const;
-  [[nodiscard]] bool               compareAsString(const ScanSettings&            settings,
-                                                   const std::vector<std::uint8_t>& left,
-                                                   const std::vector<std::uint8_t>& right) const;
-
-  template <typename T>
-  [[nodiscard]] static bool compareNumeric(ScanType scanType, const std::vector<std::uint8_t>& previous,
-                                           const std::vector<std::uint8_t>& current);
 
   const MemoryReader* m_reader = nullptr;
-  std::vector<ScanEntry> m_results;
-  std::vector<std::vector<ScanEntry>> m_history;
+  ScanResultSet              m_results;
+  std::vector<ScanResultSet> m_history;
   ScanSettings m_lastSettings{};
   std::string  m_lastError;
+  bool         m_lastScanCancelled = false;
 };
 
 } // namespace farcal::memory
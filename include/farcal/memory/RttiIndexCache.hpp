@@ -0,0 +1,249 @@
+#pragma once
+
+#include "farcal/memory/ModuleEnumerator.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+namespace farcal::memory {
+
+// On-disk RTTI index, one file per module build. Entries are stored as offsets from the module base
+// so a later attach can rebase them onto wherever the same build is loaded. A file is only used
+// when the module's name, size and header hash (PE timestamp/checksum, ELF build-id) and the
+// options fingerprint of the scan that produced it all match.
+class RttiIndexCache {
+ public:
+  struct Type {
+    std::uint64_t              type_descriptor = 0;
+    std::string                name;
+    std::vector<std::uint64_t> vftables;
+  };
+
+  explicit RttiIndexCache(std::filesystem::path directory = {}) : m_directory(std::move(directory)) {}
+
+  const std::filesystem::path& directory() const { return m_directory; }
+
+  std::filesystem::path pathFor(const ModuleInfo& module) const {
+    std::string file;
+    for (const char ch : module.name) {
+      const bool safe = (ch >= '0' && ch <= '9') || (ch >= 'A' && ch <= 'Z') || (ch >= 'a' && ch <= 'z')
+                        || ch == '.' || ch == '_' || ch == '-';
+      file.push_back(safe ? ch : '_');
+    }
+    char suffix[64]{};
+    std::snprintf(suffix,
+                  sizeof(suffix),
+                  "-%llx-%016llx.fcrtti",
+                  static_cast<unsigned long long>(module.size),
+                  static_cast<unsigned long long>(module.header_hash));
+    return m_directory / (file + suffix);
+  }
+
+  // The cached index of `module`, or nullopt when there is none for this build and fingerprint.
+  std::optional<std::vector<Type>> load(const ModuleInfo& module, std::uint64_t options_hash) const {
+    if (m_directory.empty()) {
+      return std::nullopt;
+    }
+
+    std::ifstream in(pathFor(module), std::ios::binary);
+    if (!in) {
+      return std::nullopt;
+    }
+    const std::vector<std::uint8_t> data((std::istreambuf_iterator<char>(in)),
+                                         std::istreambuf_iterator<char>());
+
+    Header header{};
+    if (data.size() < sizeof(Header)) {
+      return std::nullopt;
+    }
+    std::memcpy(&header, data.data(), sizeof(Header));
+    if (header.magic != kMagic || header.version != kVersion
+        || header.pointer_size != sizeof(std::uintptr_t) || header.module_size != module.size
+        || header.header_hash != module.header_hash || header.options_hash != options_hash) {
+      return std::nullopt;
+    }
+
+    Cursor cursor{data, sizeof(Header)};
+    std::string name;
+    if (!cursor.readString(header.name_size, name) || name != module.name) {
+      return std::nullopt;
+    }
+
+    std::vector<Type> types;
+    types.reserve(static_cast<std::size_t>((std::min)(header.type_count, std::uint64_t{1} << 20)));
+    for (std::uint64_t i = 0; i < header.type_count; ++i) {
+      Record record{};
+      Type   type;
+      if (!cursor.read(record) || !cursor.readString(record.name_size, type.name)
+          || record.type_descriptor >= module.size
+          || !cursor.fits(std::uint64_t{record.vftable_count} * sizeof(std::uint64_t))) {
+        return std::nullopt;
+      }
+      type.type_descriptor = record.type_descriptor;
+      type.vftables.resize(record.vftable_count);
+      if (!cursor.readArray(type.vftables.data(), type.vftables.size())
+          || std::any_of(type.vftables.begin(), type.vftables.end(), [&](std::uint64_t vftable) {
+               return vftable >= module.size;
+             })) {
+        return std::nullopt;
+      }
+      types.push_back(std::move(type));
+    }
+    if (cursor.offset != data.size()) {
+      return std::nullopt;
+    }
+    return types;
+  }
+
+  // Writes the index of `module` next to the others; a sibling temporary file is renamed over the
+  // previous index so a reader never sees a partial one.
+  bool store(const ModuleInfo& module, std::uint64_t options_hash, const std::vector<Type>& types) const {
+    if (m_directory.empty()) {
+      return false;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(m_directory, error);
+
+    const std::filesystem::path path      = pathFor(module);
+    std::filesystem::path       temporary = path;
+    temporary += ".tmp";
+
+    {
+      std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+      if (!out) {
+        return false;
+      }
+
+      Header header{};
+      header.magic        = kMagic;
+      header.version      = kVersion;
+      header.pointer_size = sizeof(std::uintptr_t);
+      header.name_size    = static_cast<std::uint32_t>(module.name.size());
+      header.module_size  = module.size;
+      header.header_hash  = module.header_hash;
+      header.options_hash = options_hash;
+      header.type_count   = types.size();
+      writePod(out, header);
+      out.write(module.name.data(), static_cast<std::streamsize>(module.name.size()));
+
+      for (const Type& type : types) {
+        Record record{};
+        record.type_descriptor = type.type_descriptor;
+        record.name_size       = static_cast<std::uint32_t>(type.name.size());
+        record.vftable_count   = static_cast<std::uint32_t>(type.vftables.size());
+        writePod(out, record);
+        out.write(type.name.data(), static_cast<std::streamsize>(type.name.size()));
+        out.write(reinterpret_cast<const char*>(type.vftables.data()),
+                  static_cast<std::streamsize>(type.vftables.size() * sizeof(std::uint64_t)));
+      }
+
+      out.flush();
+      if (!out) {
+        out.close();
+        std::filesystem::remove(temporary, error);
+        return false;
+      }
+    }
+
+    std::filesystem::rename(temporary, path, error);
+    if (error) {
+      std::filesystem::remove(temporary, error);
+      return false;
+    }
+    return true;
+  }
+
+  // FNV-1a, used to fingerprint the scan options an index was built with.
+  static std::uint64_t hashBytes(std::uint64_t hash, const void* data, std::size_t size) {
+    const auto* bytes = static_cast<const std::uint8_t*>(data);
+    for (std::size_t i = 0; i < size; ++i) {
+      hash = (hash ^ bytes[i]) * 0x100000001B3ull;
+    }
+    return hash;
+  }
+
+  static constexpr std::uint64_t kHashSeed = 0xCBF29CE484222325ull;
+
+ private:
+  // Layout (native endianness): Header | module name | per type: Record, name, vftable offsets.
+  static constexpr std::array<char, 8> kMagic{'F', 'C', 'R', 'T', 'T', 'I', '\0', '\0'};
+  static constexpr std::uint32_t       kVersion = 1;
+
+  struct Header {
+    std::array<char, 8> magic{};
+    std::uint32_t       version      = 0;
+    std::uint32_t       pointer_size = 0;
+    std::uint32_t       name_size    = 0;
+    std::uint32_t       reserved     = 0;
+    std::uint64_t       module_size  = 0;
+    std::uint64_t       header_hash  = 0;
+    std::uint64_t       options_hash = 0;
+    std::uint64_t       type_count   = 0;
+  };
+
+  struct Record {
+    std::uint64_t type_descriptor = 0;
+    std::uint32_t name_size       = 0;
+    std::uint32_t vftable_count   = 0;
+  };
+
+  static_assert(std::is_trivially_copyable_v<Header>);
+  static_assert(std::is_trivially_copyable_v<Record>);
+
+  // Bounds-checked reads from the loaded file.
+  struct Cursor {
+    const std::vector<std::uint8_t>& data;
+    std::size_t                      offset = 0;
+
+    bool fits(std::uint64_t size) const { return size <= data.size() - offset; }
+
+    template <typename T>
+    bool read(T& value) {
+      return readArray(&value, 1);
+    }
+
+    template <typename T>
+    bool readArray(T* values, std::size_t count) {
+      if (count == 0) {
+        return true;
+      }
+      if (count > data.size() / sizeof(T) || !fits(count * sizeof(T))) {
+        return false;
+      }
+      std::memcpy(values, data.data() + offset, count * sizeof(T));
+      offset += count * sizeof(T);
+      return true;
+    }
+
+    bool readString(std::uint64_t size, std::string& out) {
+      if (!fits(size)) {
+        return false;
+      }
+      out.assign(reinterpret_cast<const char*>(data.data() + offset), static_cast<std::size_t>(size));
+      offset += static_cast<std::size_t>(size);
+      return true;
+    }
+  };
+
+  template <typename T>
+  static void writePod(std::ofstream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  std::filesystem::path m_directory;
+};
+
+}  // namespace farcal::memory
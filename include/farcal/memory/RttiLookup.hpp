@@ -0,0 +1,159 @@
+#pragma once
+
+#include "farcal/memory/RttiScanner.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace farcal::memory {
+
+// Vftable-to-type reverse index in front of RttiScanner's per-address resolution. Seeded from a
+// completed find_all, every known vftable resolves with a single hash lookup; unknown vftables are
+// resolved through the scanner once and remembered, including the ones whose memory was read and
+// turned out not to be a vftable, so repeated annotations of the same pointers cost no further
+// reads. Failures to read are retried on the next lookup.
+//
+// Not thread-safe: each thread that annotates keeps its own lookup.
+class RttiLookup {
+ public:
+  explicit RttiLookup(const RttiScanner* scanner = nullptr, bool demangle = true)
+      : m_scanner(scanner), m_demangle(demangle) {}
+
+  void setScanner(const RttiScanner* scanner) {
+    m_scanner = scanner;
+    clear();
+  }
+
+  // Forgets every resolved and seeded vftable, e.g. after attaching to another process.
+  void clear() {
+    m_vftables.clear();
+    m_names.clear();
+    m_name_index.clear();
+  }
+
+  // Adds the vftables of a find_all result. Names are taken as the scan produced them, so the scan
+  // should use the same demangle setting as this lookup.
+  void seed(const std::vector<RttiScanner::TypeInfo>& types) {
+    std::size_t vftable_count = 0;
+    for (const auto& type : types) {
+      vftable_count += type.vftables.size();
+    }
+    m_vftables.reserve(m_vftables.size() + vftable_count);
+
+    for (const auto& type : types) {
+      if (type.vftables.empty()) {
+        continue;
+      }
+      const std::uint32_t name = intern(type.demangled_name);
+      for (const std::uintptr_t vftable : type.vftables) {
+        m_vftables.insert_or_assign(vftable, name);
+      }
+    }
+  }
+
+  std::size_t size() const { return m_vftables.size(); }
+
+  // Same contract as RttiScanner::get_rtti_of_vftable.
+  std::optional<std::string_view> nameOfVftable(std::uintptr_t vftable_address) {
+    const auto it = m_vftables.find(vftable_address);
+    if (it != m_vftables.end()) {
+      return nameAt(it->second);
+    }
+
+    if (m_scanner == nullptr) {
+      return std::nullopt;
+    }
+    if (const auto resolved = m_scanner->get_rtti_of_vftable(vftable_address, m_demangle);
+        resolved.has_value()) {
+      const std::uint32_t name = intern(*resolved);
+      m_vftables.emplace(vftable_address, name);
+      return nameAt(name);
+    }
+    if (readAsNonVftable(vftable_address)) {
+      m_vftables.emplace(vftable_address, kNoName);
+    }
+    return std::nullopt;
+  }
+
+  // Same contract as RttiScanner::get_rtti_of_address: `address` is tried as a vftable first, then
+  // as an object whose first slot points at one.
+  std::optional<std::string> nameOfAddress(std::uintptr_t address) {
+    if (m_scanner == nullptr || m_scanner->reader() == nullptr || !m_scanner->reader()->attached()
+        || address == 0) {
+      return std::nullopt;
+    }
+
+    const auto direct = nameOfVftable(address);
+    if (direct.has_value() && !RttiScanner::isGenericTypeInfoName(*direct)) {
+      return std::string(*direct);
+    }
+
+    std::optional<std::string_view> by_object;
+    const auto object_vftable = m_scanner->reader()->read<std::uintptr_t>(address);
+    if (object_vftable.has_value() && *object_vftable != 0 && *object_vftable != address) {
+      by_object = nameOfVftable(*object_vftable);
+      if (by_object.has_value() && !RttiScanner::isGenericTypeInfoName(*by_object)) {
+        return std::string(*by_object);
+      }
+    }
+
+    if (direct.has_value() && !direct->empty()) {
+      return std::string(*direct);
+    }
+    if (by_object.has_value() && !by_object->empty()) {
+      return std::string(*by_object);
+    }
+    return std::nullopt;
+  }
+
+ private:
+  static constexpr std::uint32_t kNoName = 0xFFFFFFFFu;
+
+  // Whether a failed resolution of `vftable_address` came from memory that was read and is not
+  // RTTI, rather than from a read error or a module that is not mapped (yet): the slot before the
+  // vftable is readable and either null or pointing at readable memory, the COL (or type_info)
+  // whose records live in the same module. Only such failures are remembered.
+  bool readAsNonVftable(std::uintptr_t vftable_address) const {
+    const MemoryReader* reader = m_scanner->reader();
+    if (reader == nullptr || !reader->attached() || vftable_address < sizeof(std::uintptr_t)) {
+      return false;
+    }
+    const auto slot = reader->read<std::uintptr_t>(vftable_address - sizeof(std::uintptr_t));
+    if (!slot.has_value()) {
+      return false;
+    }
+    return *slot == 0 || reader->read<std::uintptr_t>(*slot).has_value();
+  }
+
+  std::optional<std::string_view> nameAt(std::uint32_t index) const {
+    if (index == kNoName) {
+      return std::nullopt;
+    }
+    return std::string_view(m_names[index]);
+  }
+
+  std::uint32_t intern(const std::string& name) {
+    const auto [it, inserted] = m_name_index.try_emplace(name, static_cast<std::uint32_t>(m_names.size()));
+    if (inserted) {
+      m_names.push_back(name);
+    }
+    return it->second;
+  }
+
+  const RttiScanner* m_scanner  = nullptr;
+  bool               m_demangle = true;
+
+  // Vftable address to index into m_names, or kNoName for addresses known not to resolve.
+  std::unordered_map<std::uintptr_t, std::uint32_t> m_vftables;
+  std::deque<std::string>                           m_names;  // stable addresses for string_views
+  std::unordered_map<std::string, std::uint32_t>    m_name_index;
+};
+
+}  // namespace farcal::memory
@@ -1,26 +1,36 @@
 #pragma once
 
+#include "farcal/memory/AddressMatcher.hpp"
+#include "farcal/memory/ClassHierarchy.hpp"
+#include "farcal/memory/ItaniumDemangler.hpp"
 #include "farcal/memory/MemoryReader.hpp"
+#include "farcal/memory/MemoryRegions.hpp"
+#include "farcal/memory/ModuleEnumerator.hpp"
+#include "farcal/memory/RttiIndexCache.hpp"
 #include "q_lit.hpp"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <iterator>
 #include <limits>
+#include <mutex>
 #include <optional>
+#include <span>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
-#ifdef _WIN32
-#  ifndef WIN32_LEAN_AND_MEAN
-#    define WIN32_LEAN_AND_MEAN
-#  endif
-#  include <windows.h>
-#endif
-
 namespace farcal::memory {
 
 class RttiScanner {
@@ -31,6 +41,21 @@ class RttiScanner {
     std::vector<std::uintptr_t> vftables;
   };
 
+  // Vftables found for a type that was already delivered by find_all_batched: every vftable the
+  // scan knows for it, keyed by its type descriptor (the type_info object on Itanium).
+  struct VftableUpdate {
+    std::uintptr_t              type_descriptor = 0;
+    std::vector<std::uintptr_t> vftables;
+  };
+
+  // Which RTTI layout to look for. Auto picks MSVC for PE modules and Itanium (GCC, Clang) for ELF
+  // modules, or the platform's own ABI when the scan is not scoped to modules.
+  enum class Abi {
+    Auto = 0,
+    Msvc,
+    Itanium,
+  };
+
   struct ScanOptions {
     std::size_t max_results                   = 0;
     std::size_t max_candidates                = 0;
@@ -40,50 +65,45 @@ class RttiScanner {
     bool        require_executable_first_slot = true;
     bool        include_writable_regions      = false;
     bool        demangle_names                = true;
+    std::size_t worker_threads                = 0;
+    // Scan only the RTTI-bearing sections of loaded images: .rdata/.data on PE, non-executable
+    // PT_LOAD segments on ELF. When off, or when no module can be enumerated, every committed region
+    // is scanned and include_writable_regions decides whether writable ones are part of it.
+    bool                     scope_to_module_sections = true;
+    // Module names (case-insensitive) to scan when scoped; empty scans every loaded module.
+    std::vector<std::string> modules;
+    Abi                      abi = Abi::Auto;
+    // When set and the scan is scoped to modules, each module's results are loaded from (or saved
+    // to) an RttiIndexCache in this directory, so only builds not seen before are scanned.
+    std::filesystem::path    cache_directory;
   };
 
   explicit RttiScanner(const MemoryReader* reader = nullptr) : m_reader(reader) {}
 
   void setReader(const MemoryReader* reader) { m_reader = reader; }
 
-  std::vector<TypeInfo> find_all() const { return find_all(ScanOptions{}); }
-
-  std::vector<TypeInfo> find_all(const ScanOptions& options) const {
-    std::vector<TypeInfo> results;
-    if (m_reader == nullptr || !m_reader->attached()) {
-      return results;
-    }
-
-    auto regions = queryRegions();
-    if (regions.empty()) {
-      return results;
-    }
-
-    const std::size_t max_results =
-        options.max_results == 0 ? std::size_t{60000} : options.max_results;
-    const std::size_t max_name_len =
-        options.max_name_length == 0 ? std::size_t{256} : options.max_name_length;
-    const std::size_t max_vftables =
-        options.max_vftables_per_type == 0 ? std::size_t{16} : options.max_vftables_per_type;
-    const std::size_t stride =
-        options.pointer_stride == 0 ? sizeof(std::uintptr_t) : options.pointer_stride;
-    const std::size_t max_candidates =
-        options.max_candidates == 0 ? std::size_t{4000000} : options.max_candidates;
-
-    std::unordered_map<std::uintptr_t, std::size_t> type_to_index;
-    type_to_index.reserve((std::min)(max_results, std::size_t{65536}));
-    results.reserve((std::min)(max_results, std::size_t{65536}));
-
-    discoverTypeDescriptors(regions, options, max_name_len, max_results, type_to_index, results);
+  const MemoryReader* reader() const { return m_reader; }
 
-    if (results.empty()) {
-      return results;
-    }
-
-    discoverVftables(
-        regions, options, stride, max_candidates, max_vftables, type_to_index, results);
+  std::vector<TypeInfo> find_all() const { return find_all(ScanOptions{}); }
 
-    return results;
+  std::vector<TypeInfo> find_all(const ScanOptions& options) const { return findAll(options, nullptr); }
+
+  // Streams the result of find_all as it is discovered. Types go to
+  // `on_types(std::vector<TypeInfo>&&)` as the type phase finds them, without vftables, or with
+  // all of them when loaded from an index cache; once the vftable phase is done, the vftables of
+  // each type go to `on_vftables(std::vector<VftableUpdate>&&)`. An update never precedes its type.
+  // Batches may come from worker threads, one call at a time, and are not in address order.
+  template <typename TypeBatchCallback, typename VftableBatchCallback>
+  void find_all_batched(const ScanOptions&     options,
+                        std::size_t            batch_size,
+                        TypeBatchCallback&&    on_types,
+                        VftableBatchCallback&& on_vftables) const {
+    BatchSink sink(
+        batch_size,
+        [&on_types](std::vector<TypeInfo>&& batch) { on_types(std::move(batch)); },
+        [&on_vftables](std::vector<VftableUpdate>&& batch) { on_vftables(std::move(batch)); });
+    findAll(options, &sink);
+    sink.flush();
   }
 
   std::optional<std::string> get_rtti_of_address(std::uintptr_t address,
@@ -129,13 +149,12 @@ class RttiScanner {
     }
 
     const auto td = resolveTypeDescriptorFromCol(*m_reader, *col_ptr);
-    if (!td.has_value() || *td < sizeof(std::uintptr_t) * 2) {
-      return std::nullopt;
-    }
-
-    const auto decorated = readDecoratedNameFromProcess(*td + (sizeof(std::uintptr_t) * 2), 256);
+    const auto decorated = td.has_value() && *td >= sizeof(std::uintptr_t) * 2
+                               ? readDecoratedNameFromProcess(*td + (sizeof(std::uintptr_t) * 2), 256)
+                               : std::nullopt;
     if (!decorated.has_value() || !looksLikeRttiDecoratedName(*decorated)) {
-      return std::nullopt;
+      // The slot before an Itanium vtable's first entry is its type_info pointer instead.
+      return getItaniumRttiOfVtable(vftable_address, demangle);
     }
 
     if (!demangle) {
@@ -145,135 +164,227 @@ class RttiScanner {
     return demangleFast(*decorated);
   }
 
- private:
-  struct MemoryRegion {
-    std::uintptr_t base       = 0;
-    std::size_t    size       = 0;
-    std::uint32_t  protection = 0;
-    std::uint32_t  state      = 0;
-  };
+  // Base classes of every type in `types` (a find_all result, whose names are taken as they are)
+  // from the RTTI records the scan skipped: the ClassHierarchyDescriptor and BaseClassArray behind
+  // each COL on MSVC, the __si/__vmi_class_type_info base lists on Itanium. The data sections of
+  // the modules holding the types are copied in one parallel pass and the records resolved from
+  // that copy; bases the scan did not report are added as unresolved classes.
+  ClassHierarchy extract_hierarchy(const std::vector<TypeInfo>& types,
+                                   bool                         demangle     = true,
+                                   std::size_t                  worker_count = 0) const {
+    ClassHierarchy hierarchy;
+    if (m_reader == nullptr || !m_reader->attached() || types.empty()) {
+      return hierarchy;
+    }
 
-  static bool isReadableProtection(std::uint32_t protection) {
-#ifdef _WIN32
-    if ((protection & PAGE_GUARD) != 0 || (protection & PAGE_NOACCESS) != 0) {
-      return false;
+    for (const TypeInfo& type : types) {
+      const std::size_t index = hierarchy.add(type.type_descriptor, type.demangled_name);
+      hierarchy.setVftables(index, type.vftables);
     }
-    const std::uint32_t base = protection & 0xFF;
-    return base == PAGE_READONLY || base == PAGE_READWRITE || base == PAGE_WRITECOPY
-           || base == PAGE_EXECUTE_READ || base == PAGE_EXECUTE_READWRITE
-           || base == PAGE_EXECUTE_WRITECOPY;
-#else
-    (void)protection;
-    return false;
-#endif
-  }
 
-  static bool isExecutableProtection(std::uint32_t protection) {
+    const auto modules = ModuleEnumerator(m_reader).enumerate();
+    std::vector<const ModuleInfo*> sorted_modules;
+    for (const ModuleInfo& module : modules) {
+      sorted_modules.push_back(&module);
+    }
+    std::sort(sorted_modules.begin(), sorted_modules.end(), [](const ModuleInfo* a, const ModuleInfo* b) {
+      return a->base < b->base;
+    });
+
+    std::vector<const ModuleInfo*> holding;
+    for (const TypeInfo& type : types) {
+      const ModuleInfo* module = moduleContaining(sorted_modules, type.type_descriptor);
+      if (module != nullptr && std::find(holding.begin(), holding.end(), module) == holding.end()) {
+        holding.push_back(module);
+      }
+    }
+    std::vector<AddressRange> ranges;
+    for (const ModuleInfo* module : holding) {
+      for (const ModuleSection* section : rttiDataSections(*module)) {
+        ranges.push_back({section->base, section->size});
+      }
+    }
+
+    const std::size_t workers =
+        worker_count == 0 ? static_cast<std::size_t>((std::max)(1u, std::thread::hardware_concurrency()))
+                          : worker_count;
+    SectionSnapshot snapshot(*this);
+    snapshot.load(std::move(ranges), workers);
+
+    std::unordered_map<std::uintptr_t, ClassTypeInfoKind> type_info_kinds;
+    for (const TypeInfo& type : types) {
+      const ModuleInfo* module = moduleContaining(sorted_modules, type.type_descriptor);
 #ifdef _WIN32
-    const std::uint32_t base = protection & 0xFF;
-    return base == PAGE_EXECUTE || base == PAGE_EXECUTE_READ || base == PAGE_EXECUTE_READWRITE
-           || base == PAGE_EXECUTE_WRITECOPY;
+      const bool itanium = module != nullptr && module->format == ModuleFormat::Elf;
 #else
-    (void)protection;
-    return false;
+      const bool itanium = module == nullptr || module->format == ModuleFormat::Elf;
 #endif
+      const std::size_t index = hierarchy.find(type.type_descriptor);
+      if (itanium) {
+        resolveItaniumBases(snapshot, hierarchy, index, demangle, type_info_kinds);
+      } else {
+        resolveMsvcBases(snapshot, hierarchy, index, demangle);
+      }
+    }
+    return hierarchy;
   }
 
-  static bool isWritableProtection(std::uint32_t protection) {
-#ifdef _WIN32
-    const std::uint32_t base = protection & 0xFF;
-    return base == PAGE_READWRITE || base == PAGE_WRITECOPY || base == PAGE_EXECUTE_READWRITE
-           || base == PAGE_EXECUTE_WRITECOPY;
-#else
-    (void)protection;
-    return false;
-#endif
+  // Names resolved through a vftable that belongs to type_info itself rather than to the object's
+  // class; get_rtti_of_address keeps looking when it sees one.
+  static bool isGenericTypeInfoName(std::string_view name) {
+    return name == ("type_info") || name == ("std::type_info") || name == ("class type_info")
+           || name == (".?AVtype_info@@") || name == ("?AVtype_info@@");
   }
 
-  static std::uintptr_t regionEnd(const MemoryRegion& region) {
-    const auto limit = (std::numeric_limits<std::uintptr_t>::max)();
-    if (region.base > limit - region.size) {
-      return limit;
+ private:
+  // Collects the two streams of find_all_batched into batches. Calls are serialized, so the type
+  // phase's workers add to it directly.
+  class BatchSink {
+   public:
+    BatchSink(std::size_t                                       batch_size,
+              std::function<void(std::vector<TypeInfo>&&)>      on_types,
+              std::function<void(std::vector<VftableUpdate>&&)> on_vftables)
+        : m_batch_size((std::max)(std::size_t{1}, batch_size)),
+          m_on_types(std::move(on_types)),
+          m_on_vftables(std::move(on_vftables)) {}
+
+    void addTypes(const TypeInfo* types, std::size_t count) {
+      if (count == 0) {
+        return;
+      }
+      std::lock_guard<std::mutex> lock(m_mutex);
+      for (std::size_t i = 0; i < count; ++i) {
+        m_types.push_back(types[i]);
+        if (m_types.size() >= m_batch_size) {
+          flushTypes();
+        }
+      }
     }
-    return region.base + static_cast<std::uintptr_t>(region.size);
-  }
 
-  static const MemoryRegion* findRegionForAddress(const std::vector<MemoryRegion>& regions,
-                                                  std::uintptr_t                   address) {
-    const auto it = std::upper_bound(
-        regions.begin(),
-        regions.end(),
-        address,
-        [](std::uintptr_t value, const MemoryRegion& region) { return value < region.base; });
+    void addVftables(const TypeInfo& type) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_updates.push_back({type.type_descriptor, type.vftables});
+      if (m_updates.size() >= m_batch_size) {
+        flushTypes();
+        flushUpdates();
+      }
+    }
 
-    if (it == regions.begin()) {
-      return nullptr;
+    void flush() {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      flushTypes();
+      flushUpdates();
     }
 
-    const MemoryRegion& candidate = *(it - 1);
-    if (address < candidate.base) {
-      return nullptr;
+   private:
+    void flushTypes() {
+      if (!m_types.empty()) {
+        m_on_types(std::move(m_types));
+        m_types.clear();
+      }
     }
-    const std::uintptr_t end = regionEnd(candidate);
-    if (address >= end) {
-      return nullptr;
+
+    void flushUpdates() {
+      if (!m_updates.empty()) {
+        m_on_vftables(std::move(m_updates));
+        m_updates.clear();
+      }
     }
-    return &candidate;
-  }
 
-  std::vector<MemoryRegion> queryRegions() const {
-    std::vector<MemoryRegion> regions;
+    std::size_t                                       m_batch_size;
+    std::function<void(std::vector<TypeInfo>&&)>      m_on_types;
+    std::function<void(std::vector<VftableUpdate>&&)> m_on_vftables;
+    std::mutex                                        m_mutex;
+    std::vector<TypeInfo>                             m_types;
+    std::vector<VftableUpdate>                        m_updates;
+  };
 
-#ifdef _WIN32
-    if (m_reader == nullptr || !m_reader->attached()) {
-      return regions;
+  static void emitVftables(BatchSink* sink, const std::vector<TypeInfo>& types) {
+    if (sink == nullptr) {
+      return;
+    }
+    for (const TypeInfo& type : types) {
+      if (!type.vftables.empty()) {
+        sink->addVftables(type);
+      }
     }
+  }
 
-    const HANDLE process = m_reader->process().nativeHandle();
-    if (process == nullptr) {
-      return regions;
+  // find_all, also streaming to `sink` when one is given.
+  std::vector<TypeInfo> findAll(const ScanOptions& options, BatchSink* sink) const {
+    std::vector<TypeInfo> results;
+    if (m_reader == nullptr || !m_reader->attached()) {
+      return results;
     }
 
-    SYSTEM_INFO systemInfo{};
-    ::GetSystemInfo(&systemInfo);
+    const std::size_t max_results =
+        options.max_results == 0 ? std::size_t{60000} : options.max_results;
+    const std::size_t max_name_len =
+        options.max_name_length == 0 ? std::size_t{256} : options.max_name_length;
+    const std::size_t max_vftables =
+        options.max_vftables_per_type == 0 ? std::size_t{16} : options.max_vftables_per_type;
+    const std::size_t stride =
+        options.pointer_stride == 0 ? sizeof(std::uintptr_t) : options.pointer_stride;
+    const std::size_t max_candidates =
+        options.max_candidates == 0 ? std::size_t{4000000} : options.max_candidates;
 
-    std::uintptr_t cursor =
-        reinterpret_cast<std::uintptr_t>(systemInfo.lpMinimumApplicationAddress);
-    const std::uintptr_t maxAddress =
-        reinterpret_cast<std::uintptr_t>(systemInfo.lpMaximumApplicationAddress);
+    const std::size_t worker_count =
+        options.worker_threads == 0
+            ? static_cast<std::size_t>((std::max)(1u, std::thread::hardware_concurrency()))
+            : options.worker_threads;
 
-    while (cursor < maxAddress) {
-      MEMORY_BASIC_INFORMATION mbi{};
-      const SIZE_T             queried =
-          ::VirtualQueryEx(process, reinterpret_cast<LPCVOID>(cursor), &mbi, sizeof(mbi));
-      if (queried == 0) {
-        cursor += 0x1000;
-        continue;
+    if (!options.cache_directory.empty() && options.scope_to_module_sections) {
+      auto modules = ModuleEnumerator(m_reader).enumerate();
+      if (!modules.empty()) {
+        return findAllCached(options, std::move(modules), max_results, sink);
       }
+    }
 
-      MemoryRegion region{};
-      region.base       = reinterpret_cast<std::uintptr_t>(mbi.BaseAddress);
-      region.size       = static_cast<std::size_t>(mbi.RegionSize);
-      region.protection = static_cast<std::uint32_t>(mbi.Protect);
-      region.state      = static_cast<std::uint32_t>(mbi.State);
+    std::vector<Chunk>        chunks;
+    std::vector<AddressRange> executable_ranges;
+    const Abi abi = planScan(options, chunks, executable_ranges);
+    if (chunks.empty()) {
+      return results;
+    }
 
-      const std::uintptr_t next = regionEnd(region);
-      if (next <= cursor) {
-        break;
+    if (abi == Abi::Itanium) {
+      discoverItaniumTypes(chunks, options, max_name_len, max_results, worker_count, results);
+      if (sink != nullptr) {
+        sink->addTypes(results.data(), results.size());
       }
-      cursor = next;
+      discoverItaniumVtables(executable_ranges,
+                             chunks,
+                             options,
+                             stride,
+                             max_candidates,
+                             max_vftables,
+                             worker_count,
+                             results);
+      emitVftables(sink, results);
+      return results;
+    }
 
-      if (region.state == MEM_COMMIT && region.size > 0) {
-        regions.push_back(region);
-      }
+    std::unordered_map<std::uintptr_t, std::size_t> type_to_index;
+    discoverTypeDescriptors(
+        chunks, options, max_name_len, max_results, worker_count, sink, type_to_index, results);
+
+    if (results.empty()) {
+      return results;
     }
 
-    std::sort(regions.begin(), regions.end(), [](const MemoryRegion& a, const MemoryRegion& b) {
-      return a.base < b.base;
-    });
-#endif
+    const ColTable cols = discoverCompleteObjectLocators(chunks, worker_count, type_to_index);
+    discoverVftables(executable_ranges,
+                     chunks,
+                     options,
+                     stride,
+                     max_candidates,
+                     max_vftables,
+                     worker_count,
+                     cols,
+                     results);
+    emitVftables(sink, results);
 
-    return regions;
+    return results;
   }
 
   static bool looksLikeRttiDecoratedName(const std::string& name) {
@@ -289,41 +400,96 @@ class RttiScanner {
     return true;
   }
 
-  static bool isGenericTypeInfoName(std::string_view name) {
-    return name == ("type_info") || name == ("std::type_info") || name == ("class type_info")
-           || name == (".?AVtype_info@@") || name == ("?AVtype_info@@");
-  }
-
   static bool isRttiNameByte(std::uint8_t ch) {
     return ch == '.' || ch == '?' || ch == '@' || ch == '$' || ch == '_' || (ch >= '0' && ch <= '9')
            || (ch >= 'A' && ch <= 'Z') || (ch >= 'a' && ch <= 'z');
   }
 
-  std::optional<std::string> readDecoratedNameFromProcess(std::uintptr_t address,
-                                                          std::size_t    max_len) const {
-    std::string out;
-    out.reserve((std::min)(max_len, std::size_t{256}));
+  // isRttiNameByte over a whole run, without early exits or short-circuiting so the loop
+  // vectorizes.
+  static bool allRttiNameBytes(const std::uint8_t* data, std::size_t size) {
+    unsigned invalid = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+      const std::uint8_t ch    = data[i];
+      const unsigned     digit = static_cast<std::uint8_t>(ch - '0') < 10 ? 1u : 0u;
+      const unsigned     alpha = static_cast<std::uint8_t>((ch | 0x20) - 'a') < 26 ? 1u : 0u;
+      const unsigned     punct = (ch == '.') | (ch == '?') | (ch == '@') | (ch == '$') | (ch == '_');
+      invalid |= (digit | alpha | punct) ^ 1u;
+    }
+    return invalid == 0;
+  }
+
+  // Bytes of `word` that are zero get their top bit set, all others are cleared; exact, unlike the
+  // (x - 0x01..) & ~x form, which can flag a 0x01 byte after a zero one.
+  static std::uint64_t zeroByteMask(std::uint64_t word) {
+    constexpr std::uint64_t kLow7 = 0x7F7F7F7F7F7F7F7Full;
+    return ~(((word & kLow7) + kLow7) | word | kLow7);
+  }
+
+  // First offset in [from, end) where ".?A" starts. Eight offsets are tested per step: words loaded
+  // at i, i + 1 and i + 2 are compared against '.', '?' and 'A' in every byte at once, so a lane
+  // survives only where all three match. Reads up to two bytes past `end`.
+  static std::size_t findTypeNameAnchor(const std::uint8_t* data, std::size_t from, std::size_t end) {
+    constexpr std::uint64_t kBytes = 0x0101010101010101ull;
+    std::size_t             i      = from;
+    if constexpr (std::endian::native == std::endian::little) {
+      for (; i + 8 <= end; i += 8) {
+        std::uint64_t first  = 0;
+        std::uint64_t second = 0;
+        std::uint64_t third  = 0;
+        std::memcpy(&first, data + i, 8);
+        std::memcpy(&second, data + i + 1, 8);
+        std::memcpy(&third, data + i + 2, 8);
+        const std::uint64_t match = zeroByteMask(first ^ (kBytes * '.')) & zeroByteMask(second ^ (kBytes * '?'))
+                                    & zeroByteMask(third ^ (kBytes * 'A'));
+        if (match != 0) {
+          return i + static_cast<std::size_t>(std::countr_zero(match)) / 8;
+        }
+      }
+    }
+    for (; i < end; ++i) {
+      if (data[i] == '.' && data[i + 1] == '?' && data[i + 2] == 'A') {
+        return i;
+      }
+    }
+    return end;
+  }
 
-    for (std::size_t i = 0; i < max_len; ++i) {
-      const auto c = m_reader->read<std::uint8_t>(address + i);
-      if (!c.has_value()) {
+  // Reads a NUL-terminated name up to the end of its page in one call (names rarely cross one)
+  // and continues page by page only when needed. `parse(data, size, offset, max_len)` returns the
+  // name once the bytes read so far hold a complete, valid one.
+  template <typename Parse>
+  std::optional<std::string> readNameFromProcess(std::uintptr_t address,
+                                                 std::size_t    max_len,
+                                                 Parse&&        parse) const {
+    constexpr std::size_t kPageSize = 4096;
+    std::string           buffer;
+    while (buffer.size() < max_len) {
+      const std::uintptr_t cursor = address + buffer.size();
+      const std::size_t    step   = (std::min)(max_len - buffer.size(),
+                                          kPageSize - static_cast<std::size_t>(cursor % kPageSize));
+      const std::size_t old_size = buffer.size();
+      buffer.resize(old_size + step);
+      if (!m_reader->readBytes(cursor, buffer.data() + old_size, step)) {
         return std::nullopt;
       }
-      if (*c == 0) {
-        if (out.empty()) {
-          return std::nullopt;
-        }
-        return out;
+      const auto name =
+          parse(reinterpret_cast<const std::uint8_t*>(buffer.data()), buffer.size(), 0, max_len);
+      if (name.has_value()) {
+        return std::string(*name);
       }
-      if (!isRttiNameByte(*c)) {
+      if (buffer.find('\0', old_size) != std::string::npos) {
         return std::nullopt;
       }
-      out.push_back(static_cast<char>(*c));
     }
-
     return std::nullopt;
   }
 
+  std::optional<std::string> readDecoratedNameFromProcess(std::uintptr_t address,
+                                                          std::size_t    max_len) const {
+    return readNameFromProcess(address, max_len, parseDecoratedNameInChunk);
+  }
+
   static std::optional<std::string> parseDecoratedNameInChunk(const std::uint8_t* data,
                                                               std::size_t         size,
                                                               std::size_t         offset,
@@ -332,23 +498,14 @@ class RttiScanner {
       return std::nullopt;
     }
 
-    std::string out;
-    out.reserve((std::min)(max_len, std::size_t{256}));
-    for (std::size_t i = 0; i < max_len && (offset + i) < size; ++i) {
-      const std::uint8_t ch = data[offset + i];
-      if (ch == 0) {
-        if (out.empty()) {
-          return std::nullopt;
-        }
-        return out;
-      }
-      if (!isRttiNameByte(ch)) {
-        return std::nullopt;
-      }
-      out.push_back(static_cast<char>(ch));
+    const std::uint8_t* start = data + offset;
+    const auto* terminator = static_cast<const std::uint8_t*>(
+        std::memchr(start, 0, (std::min)(max_len, size - offset)));
+    if (terminator == nullptr || terminator == start
+        || !allRttiNameBytes(start, static_cast<std::size_t>(terminator - start))) {
+      return std::nullopt;
     }
-
-    return std::nullopt;
+    return std::string(reinterpret_cast<const char*>(start), static_cast<std::size_t>(terminator - start));
   }
 
   static std::string demangleFast(std::string_view decorated) {
@@ -415,118 +572,419 @@ class RttiScanner {
       return std::nullopt;
     }
 
+    // The whole COL in one read rather than one per field.
+    std::uint8_t col[kColSize]{};
+    if (!reader.readBytes(col_address, col, sizeof(col))) {
+      return std::nullopt;
+    }
+
     if constexpr (sizeof(std::uintptr_t) == 8) {
-      const auto signature = reader.read<std::uint32_t>(col_address + 0);
-      const auto td_rva    = reader.read<std::int32_t>(col_address + 12);
-      const auto self_rva  = reader.read<std::int32_t>(col_address + 20);
-      if (!signature.has_value() || !td_rva.has_value() || !self_rva.has_value()
-          || *self_rva == 0) {
-        return std::nullopt;
-      }
-      if (*signature != 0 && *signature != 1) {
+      const auto signature = readValueFromBytes<std::uint32_t>(col);
+      const auto td_rva    = readValueFromBytes<std::int32_t>(col + 12);
+      const auto self_rva  = readValueFromBytes<std::int32_t>(col + 20);
+      if (self_rva == 0 || (signature != 0 && signature != 1)) {
         return std::nullopt;
       }
 
       const auto image_base =
-          static_cast<std::int64_t>(col_address) - static_cast<std::int64_t>(*self_rva);
-      const auto td_address = image_base + static_cast<std::int64_t>(*td_rva);
+          static_cast<std::int64_t>(col_address) - static_cast<std::int64_t>(self_rva);
+      const auto td_address = image_base + static_cast<std::int64_t>(td_rva);
       if (image_base <= 0 || td_address <= 0) {
         return std::nullopt;
       }
       return static_cast<std::uintptr_t>(td_address);
     } else {
-      const auto td_abs = reader.read<std::uint32_t>(col_address + 12);
-      if (!td_abs.has_value() || *td_abs == 0) {
+      const auto td_abs = readValueFromBytes<std::uint32_t>(col + 12);
+      if (td_abs == 0) {
         return std::nullopt;
       }
-      return static_cast<std::uintptr_t>(*td_abs);
+      return static_cast<std::uintptr_t>(td_abs);
     }
   }
 
-  void discoverTypeDescriptors(const std::vector<MemoryRegion>&                 regions,
-                               const ScanOptions&                               options,
-                               std::size_t                                      max_name_len,
-                               std::size_t                                      max_results,
-                               std::unordered_map<std::uintptr_t, std::size_t>& type_to_index,
-                               std::vector<TypeInfo>&                           results) const {
-    constexpr std::size_t kChunkSize = 1024 * 1024;
-    constexpr std::size_t kOverlap   = 512;
+  // All discovery phases split the scanned sections (or regions) into fixed-size chunks. A chunk
+  // owns the addresses in [base, base + size) and may read up to `overlap` bytes past them, so an
+  // anchor that straddles a chunk boundary is seen exactly once, by the chunk it starts in.
+  struct Chunk {
+    std::uintptr_t base    = 0;
+    std::size_t    size    = 0;
+    std::size_t    overlap = 0;
+  };
+
+  static constexpr std::size_t kChunkSize    = 1024 * 1024;
+  static constexpr std::size_t kChunkOverlap = 512;
 
-    std::vector<std::uint8_t> buffer(kChunkSize);
+  struct AddressRange {
+    std::uintptr_t base = 0;
+    std::size_t    size = 0;
+  };
+
+  static void appendChunks(std::vector<Chunk>& chunks, std::uintptr_t base, std::size_t size) {
+    const std::uintptr_t end = MemoryRegion{base, size}.end();
+    for (std::uintptr_t cursor = base; cursor < end;) {
+      const std::size_t chunk_size = static_cast<std::size_t>(
+          (std::min)(std::uint64_t(kChunkSize), std::uint64_t(end - cursor)));
+      const std::size_t overlap = static_cast<std::size_t>(
+          (std::min)(std::uint64_t(kChunkOverlap), std::uint64_t(end - cursor - chunk_size)));
+      chunks.push_back({cursor, chunk_size, overlap});
+      cursor += static_cast<std::uintptr_t>(chunk_size);
+    }
+  }
 
-    for (const auto& region : regions) {
-      if (!isReadableProtection(region.protection)) {
+  // Sections of `module` that can hold type descriptors, COLs and vftables. MSVC puts type
+  // descriptors in .data and COLs and vftables in .rdata; images without either (merged or renamed
+  // sections) fall back to every readable, non-executable section.
+  static std::vector<const ModuleSection*> rttiDataSections(const ModuleInfo& module) {
+    std::vector<const ModuleSection*> sections;
+    for (const auto& section : module.sections) {
+      if (!section.readable || section.executable) {
         continue;
       }
-      if (!options.include_writable_regions && isWritableProtection(region.protection)) {
-        continue;
+      if (module.format == ModuleFormat::Elf || section.name == ".rdata" || section.name == ".data") {
+        sections.push_back(&section);
+      }
+    }
+    if (sections.empty()) {
+      for (const auto& section : module.sections) {
+        if (section.readable && !section.executable) {
+          sections.push_back(&section);
+        }
       }
+    }
+    return sections;
+  }
+
+  static bool isSelectedModule(const ModuleInfo& module, const std::vector<std::string>& names) {
+    if (names.empty()) {
+      return true;
+    }
+    return std::any_of(names.begin(), names.end(), [&](const std::string& name) {
+      return ModuleEnumerator::nameMatches(module, name);
+    });
+  }
+
+  // Fingerprint of the options that change what a module's scan finds. The result cap is left out:
+  // an index is only stored when the scan that built it was not truncated by it.
+  static std::uint64_t cacheOptionsHash(const ScanOptions& options) {
+    const std::uint64_t fields[] = {
+        options.max_candidates,
+        options.pointer_stride,
+        options.max_name_length,
+        options.max_vftables_per_type,
+        options.require_executable_first_slot ? 1u : 0u,
+        options.demangle_names ? 1u : 0u,
+        static_cast<std::uint64_t>(options.abi),
+    };
+    return RttiIndexCache::hashBytes(RttiIndexCache::kHashSeed, fields, sizeof(fields));
+  }
 
-      const std::uintptr_t start = region.base;
-      const std::uintptr_t end   = regionEnd(region);
-      if (start >= end) {
+  static const ModuleInfo* moduleContaining(const std::vector<const ModuleInfo*>& modules,
+                                            std::uintptr_t                        address) {
+    const auto it = std::upper_bound(
+        modules.begin(), modules.end(), address, [](std::uintptr_t value, const ModuleInfo* module) {
+          return value < module->base;
+        });
+    if (it == modules.begin()) {
+      return nullptr;
+    }
+    const ModuleInfo* candidate = *(it - 1);
+    return address - candidate->base < candidate->size ? candidate : nullptr;
+  }
+
+  // Rebases cached modules onto their current base and scans the rest in one pass, whose results
+  // are then split by module and stored.
+  std::vector<TypeInfo> findAllCached(const ScanOptions&      options,
+                                      std::vector<ModuleInfo> modules,
+                                      std::size_t             max_results,
+                                      BatchSink*              sink) const {
+    const RttiIndexCache cache(options.cache_directory);
+    const std::uint64_t  options_hash = cacheOptionsHash(options);
+
+    std::vector<TypeInfo>           results;
+    std::vector<const ModuleInfo*>  missing;
+    for (const ModuleInfo& module : modules) {
+      if (!isSelectedModule(module, options.modules)) {
         continue;
       }
-
-      std::uintptr_t cursor = start;
-      while (cursor < end) {
-        const std::size_t to_read = static_cast<std::size_t>(
-            (std::min)(std::uint64_t(kChunkSize), std::uint64_t(end - cursor)));
-        if (to_read == 0) {
-          break;
+      auto cached = cache.load(module, options_hash);
+      if (!cached.has_value()) {
+        missing.push_back(&module);
+        continue;
+      }
+      for (auto& entry : *cached) {
+        TypeInfo info{};
+        info.type_descriptor = module.base + static_cast<std::uintptr_t>(entry.type_descriptor);
+        info.demangled_name  = std::move(entry.name);
+        info.vftables.reserve(entry.vftables.size());
+        for (const std::uint64_t offset : entry.vftables) {
+          info.vftables.push_back(module.base + static_cast<std::uintptr_t>(offset));
         }
+        results.push_back(std::move(info));
+      }
+    }
 
-        if (!m_reader->readBytes(cursor, buffer.data(), to_read)) {
-          const std::uintptr_t step = (std::min)(std::uintptr_t{4096}, end - cursor);
-          if (step == 0) {
-            break;
-          }
-          cursor += step;
+    const auto by_address = [](const TypeInfo& a, const TypeInfo& b) {
+      return a.type_descriptor < b.type_descriptor;
+    };
+    std::sort(results.begin(), results.end(), by_address);
+    if (results.size() > max_results) {
+      results.resize(max_results);
+    }
+    if (sink != nullptr) {
+      sink->addTypes(results.data(), results.size());
+    }
+
+    if (!missing.empty() && results.size() < max_results) {
+      ScanOptions scan = options;
+      scan.cache_directory.clear();
+      scan.modules.clear();
+      for (const ModuleInfo* module : missing) {
+        scan.modules.push_back(module->name);
+      }
+      // Cached types already count against the cap.
+      scan.max_results = max_results - results.size();
+      auto scanned     = findAll(scan, sink);
+
+      std::vector<std::vector<RttiIndexCache::Type>> per_module(missing.size());
+      for (const TypeInfo& info : scanned) {
+        const ModuleInfo* module = moduleContaining(missing, info.type_descriptor);
+        if (module == nullptr) {
           continue;
         }
-
-        for (std::size_t i = 0; i + 3 < to_read; ++i) {
-          if (buffer[i] != '.' || buffer[i + 1] != '?' || buffer[i + 2] != 'A') {
-            continue;
+        RttiIndexCache::Type entry;
+        entry.type_descriptor = info.type_descriptor - module->base;
+        entry.name            = info.demangled_name;
+        for (const std::uintptr_t vftable : info.vftables) {
+          if (vftable - module->base < module->size) {
+            entry.vftables.push_back(vftable - module->base);
           }
+        }
+        const auto index = static_cast<std::size_t>(
+            std::find(missing.begin(), missing.end(), module) - missing.begin());
+        per_module[index].push_back(std::move(entry));
+      }
 
-          const std::uintptr_t name_addr = cursor + static_cast<std::uintptr_t>(i);
-          if (name_addr < sizeof(std::uintptr_t) * 2) {
-            continue;
-          }
+      if (scanned.size() < scan.max_results) {
+        for (std::size_t i = 0; i < missing.size(); ++i) {
+          cache.store(*missing[i], options_hash, per_module[i]);
+        }
+      }
+      results.insert(results.end(),
+                     std::make_move_iterator(scanned.begin()),
+                     std::make_move_iterator(scanned.end()));
+      std::sort(results.begin(), results.end(), by_address);
+    }
+    return results;
+  }
 
-          std::optional<std::string> name =
-              parseDecoratedNameInChunk(buffer.data(), to_read, i, max_name_len);
-          if (!name.has_value()) {
-            name = readDecoratedNameFromProcess(name_addr, max_name_len);
+  // Decides which bytes the phases read and which ABI they look for. Executable ranges are
+  // collected from every module (or region) regardless of the selection, since vftable entries are
+  // checked against them.
+  Abi planScan(const ScanOptions&         options,
+               std::vector<Chunk>&        chunks,
+               std::vector<AddressRange>& executable_ranges) const {
+    if (options.scope_to_module_sections) {
+      const auto modules = ModuleEnumerator(m_reader).enumerate();
+      if (!modules.empty()) {
+        bool any_elf = false;
+        for (const auto& module : modules) {
+          for (const auto& section : module.sections) {
+            if (section.executable) {
+              executable_ranges.push_back({section.base, section.size});
+            }
           }
-          if (!name.has_value() || !looksLikeRttiDecoratedName(*name)) {
+          if (!isSelectedModule(module, options.modules)) {
             continue;
           }
-
-          const std::uintptr_t type_descriptor = name_addr - (sizeof(std::uintptr_t) * 2);
-          if (type_to_index.find(type_descriptor) != type_to_index.end()) {
-            continue;
+          any_elf = any_elf || module.format == ModuleFormat::Elf;
+          for (const ModuleSection* section : rttiDataSections(module)) {
+            appendChunks(chunks, section->base, section->size);
           }
+        }
+        sortRanges(executable_ranges);
+        if (options.abi != Abi::Auto) {
+          return options.abi;
+        }
+        return any_elf ? Abi::Itanium : Abi::Msvc;
+      }
+    }
+
+    for (const auto& region : queryMemoryRegions(*m_reader)) {
+      if (region.executable) {
+        executable_ranges.push_back({region.base, region.size});
+      }
+      if (!region.readable) {
+        continue;
+      }
+      if (!options.include_writable_regions && region.writable) {
+        continue;
+      }
+      appendChunks(chunks, region.base, region.size);
+    }
+    sortRanges(executable_ranges);
+    if (options.abi != Abi::Auto) {
+      return options.abi;
+    }
+#ifdef _WIN32
+    return Abi::Msvc;
+#else
+    return Abi::Itanium;
+#endif
+  }
 
-          TypeInfo info{};
-          info.type_descriptor = type_descriptor;
-          info.demangled_name  = options.demangle_names ? demangleFast(*name) : *name;
+  static void sortRanges(std::vector<AddressRange>& ranges) {
+    std::sort(ranges.begin(), ranges.end(), [](const AddressRange& a, const AddressRange& b) {
+      return a.base < b.base;
+    });
+  }
 
-          type_to_index.emplace(type_descriptor, results.size());
-          results.push_back(std::move(info));
+  static bool rangesContain(const std::vector<AddressRange>& ranges, std::uintptr_t address) {
+    const auto it = std::upper_bound(
+        ranges.begin(), ranges.end(), address, [](std::uintptr_t value, const AddressRange& range) {
+          return value < range.base;
+        });
+    if (it == ranges.begin()) {
+      return false;
+    }
+    const AddressRange& candidate = *(it - 1);
+    return address - candidate.base < candidate.size;
+  }
 
-          if (results.size() >= max_results) {
-            return;
-          }
+  // Runs `work(worker_index, chunk)` over all chunks on `worker_count` threads. Chunks are handed
+  // out one at a time from a shared counter, so large and small regions balance across threads;
+  // `work` returns false to stop its worker early.
+  template <typename Work>
+  static void forEachChunk(const std::vector<Chunk>& chunks, std::size_t worker_count, Work&& work) {
+    const std::size_t        workers = (std::max)(std::size_t{1}, (std::min)(worker_count, chunks.size()));
+    std::atomic<std::size_t> next_chunk{0};
+
+    const auto run = [&](std::size_t worker_index) {
+      for (std::size_t index = next_chunk.fetch_add(1, std::memory_order_relaxed); index < chunks.size();
+           index             = next_chunk.fetch_add(1, std::memory_order_relaxed)) {
+        if (!work(worker_index, chunks[index])) {
+          return;
         }
+      }
+    };
+
+    if (workers == 1) {
+      run(0);
+      return;
+    }
+
+    std::vector<std::future<void>> futures;
+    futures.reserve(workers - 1);
+    for (std::size_t worker_index = 1; worker_index < workers; ++worker_index) {
+      futures.emplace_back(std::async(std::launch::async, run, worker_index));
+    }
+    run(0);
+    for (auto& future : futures) {
+      future.get();
+    }
+  }
 
-        const std::size_t step = to_read > kOverlap ? (to_read - kOverlap) : to_read;
-        if (step == 0) {
+
+  // Per-thread state of the type descriptor phase; shards are merged once all chunks are done.
+  struct TypeShard {
+    std::unordered_map<std::uintptr_t, std::size_t> type_to_index;
+    std::vector<TypeInfo>                           types;
+  };
+
+  void discoverTypeDescriptors(const std::vector<Chunk>&                        chunks,
+                               const ScanOptions&                               options,
+                               std::size_t                                      max_name_len,
+                               std::size_t                                      max_results,
+                               std::size_t                                      worker_count,
+                               BatchSink*                                       sink,
+                               std::unordered_map<std::uintptr_t, std::size_t>& type_to_index,
+                               std::vector<TypeInfo>&                           results) const {
+    const std::size_t workers = (std::max)(std::size_t{1}, (std::min)(worker_count, chunks.size()));
+    std::vector<TypeShard>                 shards(workers);
+    std::vector<std::vector<std::uint8_t>> buffers(workers);
+    std::atomic<std::size_t>               found{0};
+
+    forEachChunk(chunks, workers, [&](std::size_t worker_index, const Chunk& chunk) {
+      TypeShard&                 shard  = shards[worker_index];
+      std::vector<std::uint8_t>& buffer = buffers[worker_index];
+      buffer.resize(kChunkSize + kChunkOverlap);
+
+      // Unreadable pages come back zero-filled, which neither phase can mistake for an anchor or
+      // a pointer.
+      const std::size_t to_read = chunk.size + chunk.overlap;
+      if (!readChunk(*m_reader, chunk.base, buffer.data(), to_read)) {
+        return true;
+      }
+
+      const std::size_t chunk_first = shard.types.size();
+      bool              keep_going  = true;
+      const std::size_t anchors_end = to_read > 3 ? (std::min)(chunk.size, to_read - 3) : 0;
+      for (std::size_t i = findTypeNameAnchor(buffer.data(), 0, anchors_end); i < anchors_end;
+           i             = findTypeNameAnchor(buffer.data(), i + 1, anchors_end)) {
+        const std::uintptr_t name_addr = chunk.base + static_cast<std::uintptr_t>(i);
+        if (name_addr < sizeof(std::uintptr_t) * 2) {
+          continue;
+        }
+
+        // The overlap holds any name that crosses into the next chunk. Only a name still running
+        // at the end of the buffer (past the overlap, or at the end of a region) is finished with
+        // reads from the process, and only when what was buffered of it is valid.
+        const std::size_t available = (std::min)(max_name_len, to_read - i);
+        std::optional<std::string> name;
+        if (std::memchr(buffer.data() + i, 0, available) != nullptr) {
+          name = parseDecoratedNameInChunk(buffer.data(), to_read, i, max_name_len);
+        } else if (available < max_name_len && allRttiNameBytes(buffer.data() + i, available)) {
+          name = readDecoratedNameFromProcess(name_addr, max_name_len);
+        }
+        if (!name.has_value() || !looksLikeRttiDecoratedName(*name)) {
+          continue;
+        }
+
+        const std::uintptr_t type_descriptor = name_addr - (sizeof(std::uintptr_t) * 2);
+        if (shard.type_to_index.find(type_descriptor) != shard.type_to_index.end()) {
+          continue;
+        }
+
+        // Claimed before it is kept, so no more than max_results types are ever streamed.
+        if (found.fetch_add(1, std::memory_order_relaxed) >= max_results) {
+          keep_going = false;
           break;
         }
-        cursor += static_cast<std::uintptr_t>(step);
+
+        TypeInfo info{};
+        info.type_descriptor = type_descriptor;
+        info.demangled_name  = options.demangle_names ? demangleFast(*name) : *name;
+
+        shard.type_to_index.emplace(type_descriptor, shard.types.size());
+        shard.types.push_back(std::move(info));
       }
+
+      if (sink != nullptr) {
+        sink->addTypes(shard.types.data() + chunk_first, shard.types.size() - chunk_first);
+      }
+      return keep_going && found.load(std::memory_order_relaxed) < max_results;
+    });
+
+    // Merge at the phase boundary: address order matches what a sequential scan produces.
+    std::size_t total = 0;
+    for (const auto& shard : shards) {
+      total += shard.types.size();
+    }
+    results.reserve(results.size() + total);
+    for (auto& shard : shards) {
+      results.insert(results.end(),
+                     std::make_move_iterator(shard.types.begin()),
+                     std::make_move_iterator(shard.types.end()));
+    }
+    std::sort(results.begin(), results.end(), [](const TypeInfo& a, const TypeInfo& b) {
+      return a.type_descriptor < b.type_descriptor;
+    });
+    if (results.size() > max_results) {
+      results.resize(max_results);
+    }
+
+    type_to_index.reserve(results.size());
+    for (std::size_t i = 0; i < results.size(); ++i) {
+      type_to_index.emplace(results[i].type_descriptor, i);
     }
   }
 
@@ -536,109 +994,855 @@ class RttiScanner {
     return value;
   }
 
-  void discoverVftables(const std::vector<MemoryRegion>&                       regions,
-                        const ScanOptions&                                     options,
-                        std::size_t                                            stride,
-                        std::size_t                                            max_candidates,
-                        std::size_t                                            max_vftables,
-                        const std::unordered_map<std::uintptr_t, std::size_t>& type_to_index,
-                        std::vector<TypeInfo>&                                 results) const {
-    constexpr std::size_t     kChunkSize = 1024 * 1024;
-    std::vector<std::uint8_t> buffer(kChunkSize);
+  template <typename T>
+  static T readValueFromBytes(const std::uint8_t* data) {
+    T value{};
+    std::memcpy(&value, data, sizeof(T));
+    return value;
+  }
+
+  // Complete object locators found in the buffered chunks, sorted by address, with the index of
+  // the type each one describes.
+  struct ColTable {
+    std::vector<std::uintptr_t> addresses;
+    std::vector<std::size_t>    type_indices;
+  };
 
-    std::size_t candidate_count = 0;
-    bool        stop            = false;
+  static constexpr std::size_t kColSize = sizeof(std::uintptr_t) == 8 ? 24 : 16;
 
-    for (const auto& region : regions) {
-      if (stop) {
-        break;
+  // Loaded images start on the 64 KiB allocation granularity, so a COL whose self RVA implies any
+  // other image base is noise.
+  static constexpr std::uintptr_t kImageBaseAlignment = 0x10000;
+
+  // Resolves a COL candidate from buffered bytes: signature 1 with image-relative type descriptor
+  // and self RVAs on x64, signature 0 with an absolute type descriptor pointer on x86.
+  static std::optional<std::uintptr_t> typeDescriptorFromColBytes(const std::uint8_t* data,
+                                                                  std::uintptr_t col_address) {
+    const auto signature = readValueFromBytes<std::uint32_t>(data);
+    if constexpr (sizeof(std::uintptr_t) == 8) {
+      if (signature != 1) {
+        return std::nullopt;
       }
-      if (!isReadableProtection(region.protection)) {
-        continue;
+      const auto self_rva = readValueFromBytes<std::int32_t>(data + 20);
+      if (self_rva <= 0 || static_cast<std::uintptr_t>(self_rva) > col_address) {
+        return std::nullopt;
       }
-      if (!options.include_writable_regions && isWritableProtection(region.protection)) {
-        continue;
+      const std::uintptr_t image_base = col_address - static_cast<std::uintptr_t>(self_rva);
+      if (image_base == 0 || (image_base & (kImageBaseAlignment - 1)) != 0) {
+        return std::nullopt;
+      }
+      const auto td_rva = readValueFromBytes<std::int32_t>(data + 12);
+      if (td_rva <= 0) {
+        return std::nullopt;
+      }
+      return image_base + static_cast<std::uintptr_t>(td_rva);
+    } else {
+      if (signature != 0) {
+        return std::nullopt;
+      }
+      const auto td_abs = readValueFromBytes<std::uint32_t>(data + 12);
+      if (td_abs == 0) {
+        return std::nullopt;
       }
+      return static_cast<std::uintptr_t>(td_abs);
+    }
+  }
 
-      const std::uintptr_t start = region.base;
-      const std::uintptr_t end   = regionEnd(region);
-      if (start >= end) {
-        continue;
+  // Phase two: every 4-byte aligned offset of every chunk is tried as a COL, entirely from the
+  // chunk buffer. Only candidates whose type descriptor is one of the known types are kept.
+  ColTable discoverCompleteObjectLocators(
+      const std::vector<Chunk>&                              chunks,
+      std::size_t                                            worker_count,
+      const std::unordered_map<std::uintptr_t, std::size_t>& type_to_index) const {
+    using Col = std::pair<std::uintptr_t, std::size_t>;
+
+    const std::size_t workers = (std::max)(std::size_t{1}, (std::min)(worker_count, chunks.size()));
+    std::vector<std::vector<Col>>          shards(workers);
+    std::vector<std::vector<std::uint8_t>> buffers(workers);
+
+    forEachChunk(chunks, workers, [&](std::size_t worker_index, const Chunk& chunk) {
+      std::vector<std::uint8_t>& buffer = buffers[worker_index];
+      buffer.resize(kChunkSize + kChunkOverlap);
+
+      const std::size_t to_read = chunk.size + (std::min)(chunk.overlap, kColSize);
+      if (to_read < kColSize || !readChunk(*m_reader, chunk.base, buffer.data(), to_read)) {
+        return true;
       }
 
-      std::uintptr_t cursor = start;
-      while (cursor < end) {
-        if (stop) {
-          break;
+      std::vector<Col>& cols  = shards[worker_index];
+      const std::size_t first = static_cast<std::size_t>((4 - chunk.base % 4) % 4);
+      for (std::size_t i = first; i < chunk.size && i + kColSize <= to_read; i += 4) {
+        const std::uintptr_t col_address = chunk.base + static_cast<std::uintptr_t>(i);
+        const auto           td          = typeDescriptorFromColBytes(buffer.data() + i, col_address);
+        if (!td.has_value()) {
+          continue;
         }
-
-        const std::size_t to_read = static_cast<std::size_t>(
-            (std::min)(std::uint64_t(kChunkSize), std::uint64_t(end - cursor)));
-        if (to_read < sizeof(std::uintptr_t)) {
-          break;
+        const auto type_it = type_to_index.find(*td);
+        if (type_it != type_to_index.end()) {
+          cols.emplace_back(col_address, type_it->second);
         }
+      }
+      return true;
+    });
 
-        if (!m_reader->readBytes(cursor, buffer.data(), to_read)) {
-          const std::uintptr_t step = (std::min)(std::uintptr_t{4096}, end - cursor);
-          if (step == 0) {
-            break;
-          }
-          cursor += step;
-          continue;
-        }
+    std::vector<Col> merged;
+    for (auto& shard : shards) {
+      merged.insert(merged.end(), shard.begin(), shard.end());
+    }
+    std::sort(merged.begin(), merged.end());
+
+    ColTable table;
+    table.addresses.reserve(merged.size());
+    table.type_indices.reserve(merged.size());
+    for (const auto& [address, type_index] : merged) {
+      table.addresses.push_back(address);
+      table.type_indices.push_back(type_index);
+    }
+    return table;
+  }
 
-        for (std::size_t i = 0; i + sizeof(std::uintptr_t) <= to_read; i += stride) {
-          ++candidate_count;
-          if (candidate_count >= max_candidates) {
-            stop = true;
-            break;
-          }
+  // Where the pointer that identifies a vtable sits relative to the scanned slot, and where the
+  // vtable's first entry (the address reported as the vftable) sits.
+  struct VtableLayout {
+    std::size_t match_offset = 0;
+    std::size_t entry_offset = 0;
+  };
 
-          const std::uintptr_t slot_address = cursor + static_cast<std::uintptr_t>(i);
-          const std::uintptr_t col_address  = readPointerFromBytes(buffer.data() + i);
-          if (col_address == 0) {
-            continue;
-          }
+  // Shared by both ABIs: every `stride`-aligned slot whose pointer at `match_offset` is in `matcher`
+  // and that `accept` approves becomes a vftable of type `type_indices[match]`. Slots, first entries
+  // and the executable check come from the chunk buffer and the planned executable ranges.
+  template <typename Accept>
+  void collectVtables(const std::vector<AddressRange>& executable_ranges,
+                      const std::vector<Chunk>&        chunks,
+                      const ScanOptions&               options,
+                      std::size_t                      stride,
+                      std::size_t                      max_candidates,
+                      std::size_t                      max_vftables,
+                      std::size_t                      worker_count,
+                      const AddressMatcher&            matcher,
+                      const std::vector<std::size_t>&  type_indices,
+                      VtableLayout                     layout,
+                      Accept&&                         accept,
+                      std::vector<TypeInfo>&           results) const {
+    // Each worker collects (vftable, type index) hits in its own shard, and the hits are applied
+    // in address order afterwards so the per-type cap keeps the same vftables a sequential scan
+    // would.
+    using Hit = std::pair<std::uintptr_t, std::size_t>;
+
+    if (matcher.empty()) {
+      return;
+    }
 
-          const auto td = resolveTypeDescriptorFromCol(*m_reader, col_address);
-          if (!td.has_value()) {
-            continue;
-          }
+    const std::size_t workers = (std::max)(std::size_t{1}, (std::min)(worker_count, chunks.size()));
+    std::vector<std::vector<Hit>>          shards(workers);
+    std::vector<std::vector<std::uint8_t>> buffers(workers);
+    std::atomic<std::size_t>               candidates{0};
 
-          const auto type_it = type_to_index.find(*td);
-          if (type_it == type_to_index.end()) {
-            continue;
-          }
+    // The overlap covers the matched pointer and the first vftable entry of the last slot.
+    const std::size_t slot_span =
+        (std::max)(layout.match_offset, layout.entry_offset) + sizeof(std::uintptr_t);
+
+    forEachChunk(chunks, workers, [&](std::size_t worker_index, const Chunk& chunk) {
+      std::vector<std::uint8_t>& buffer = buffers[worker_index];
+      buffer.resize(kChunkSize + kChunkOverlap);
+
+      if (chunk.size < sizeof(std::uintptr_t)) {
+        return true;
+      }
 
-          TypeInfo& type_info = results[type_it->second];
-          if (type_info.vftables.size() >= max_vftables) {
+      // Each chunk reserves its slots from the shared candidate budget up front.
+      const std::size_t slots   = (chunk.size + stride - 1) / stride;
+      const std::size_t claimed = candidates.fetch_add(slots, std::memory_order_relaxed);
+      if (claimed >= max_candidates) {
+        return false;
+      }
+      const std::size_t slot_limit = (std::min)(slots, max_candidates - claimed);
+
+      const std::size_t to_read = chunk.size + (std::min)(chunk.overlap, slot_span);
+      if (!readChunk(*m_reader, chunk.base, buffer.data(), to_read)) {
+        return true;
+      }
+
+      const std::size_t match_end = layout.match_offset + sizeof(std::uintptr_t);
+      const std::size_t readable_slots =
+          to_read < match_end ? 0 : (to_read - match_end) / stride + 1;
+      const std::size_t slot_count = (std::min)(slot_limit, readable_slots);
+
+      std::vector<Hit>& hits = shards[worker_index];
+      for (std::size_t block = 0; block < slot_count; block += AddressMatcher::kBlockSlots) {
+        const std::size_t block_slots = (std::min)(AddressMatcher::kBlockSlots, slot_count - block);
+        std::uint64_t     mask        = matcher.match(
+            buffer.data() + block * stride + layout.match_offset, block_slots, stride);
+
+        while (mask != 0) {
+          const std::size_t slot = block + static_cast<std::size_t>(std::countr_zero(mask));
+          mask &= mask - 1;
+
+          const std::size_t i     = slot * stride;
+          const std::size_t match =
+              matcher.find(readPointerFromBytes(buffer.data() + i + layout.match_offset));
+          if (!accept(buffer.data() + i, to_read - i)) {
             continue;
           }
 
-          const std::uintptr_t vftable_address = slot_address + sizeof(std::uintptr_t);
           if (options.require_executable_first_slot) {
-            const auto first_slot = m_reader->read<std::uintptr_t>(vftable_address);
-            if (!first_slot.has_value() || *first_slot == 0) {
+            if (i + layout.entry_offset + sizeof(std::uintptr_t) > to_read) {
               continue;
             }
-
-            const MemoryRegion* slot_region = findRegionForAddress(regions, *first_slot);
-            if (slot_region == nullptr || !isExecutableProtection(slot_region->protection)) {
+            const std::uintptr_t first_slot =
+                readPointerFromBytes(buffer.data() + i + layout.entry_offset);
+            if (first_slot == 0 || !rangesContain(executable_ranges, first_slot)) {
               continue;
             }
           }
 
-          const bool exists =
-              std::find(type_info.vftables.begin(), type_info.vftables.end(), vftable_address)
-              != type_info.vftables.end();
-          if (!exists) {
-            type_info.vftables.push_back(vftable_address);
+          hits.emplace_back(chunk.base + static_cast<std::uintptr_t>(i + layout.entry_offset),
+                            type_indices[match]);
+        }
+      }
+      return true;
+    });
+
+    std::vector<Hit> merged;
+    for (auto& shard : shards) {
+      merged.insert(merged.end(), shard.begin(), shard.end());
+    }
+    std::sort(merged.begin(), merged.end());
+
+    for (const auto& [vftable_address, type_index] : merged) {
+      TypeInfo& type_info = results[type_index];
+      if (type_info.vftables.size() >= max_vftables) {
+        continue;
+      }
+      if (std::find(type_info.vftables.begin(), type_info.vftables.end(), vftable_address)
+          == type_info.vftables.end()) {
+        type_info.vftables.push_back(vftable_address);
+      }
+    }
+  }
+
+  // Phase three: a vftable is the slot after a pointer to one of the COLs found above.
+  void discoverVftables(const std::vector<AddressRange>& executable_ranges,
+                        const std::vector<Chunk>&        chunks,
+                        const ScanOptions&               options,
+                        std::size_t                      stride,
+                        std::size_t                      max_candidates,
+                        std::size_t                      max_vftables,
+                        std::size_t                      worker_count,
+                        const ColTable&                  cols,
+                        std::vector<TypeInfo>&           results) const {
+    const AddressMatcher matcher(cols.addresses);
+    collectVtables(executable_ranges,
+                   chunks,
+                   options,
+                   stride,
+                   max_candidates,
+                   max_vftables,
+                   worker_count,
+                   matcher,
+                   cols.type_indices,
+                   VtableLayout{0, sizeof(std::uintptr_t)},
+                   [](const std::uint8_t*, std::size_t) { return true; },
+                   results);
+  }
+
+  // ---- Itanium C++ ABI (GCC, Clang) ----
+  //
+  // type_info objects for classes are {vptr, const char* name, ...}, where the vptr is the address
+  // point of the vtable of __cxxabiv1::__class_type_info, __si_class_type_info or
+  // __vmi_class_type_info and the name is the mangled type (the contents of the _ZTS symbol).
+  // Vtables are {offset-to-top, type_info*, entries...} and objects point at the first entry.
+
+  static bool isItaniumNameStart(std::uint8_t ch) {
+    return (ch >= '1' && ch <= '9') || ch == 'N' || ch == 'S' || ch == 'Z' || ch == '*';
+  }
+
+  static bool isItaniumNameByte(std::uint8_t ch) {
+    return ch == '_' || ch == '$' || ch == '.' || (ch >= '0' && ch <= '9') || (ch >= 'A' && ch <= 'Z')
+           || (ch >= 'a' && ch <= 'z');
+  }
+
+  // The mangled name starting at `offset`, up to its terminating NUL, or nullopt when a byte is not
+  // part of a mangled name or the string runs past `max_len`.
+  static std::optional<std::string_view> itaniumNameInChunk(const std::uint8_t* data,
+                                                            std::size_t         size,
+                                                            std::size_t         offset,
+                                                            std::size_t         max_len) {
+    const std::size_t limit = (std::min)(size, offset + max_len);
+    for (std::size_t i = offset; i < limit; ++i) {
+      const std::uint8_t ch = data[i];
+      if (ch == 0) {
+        if (i == offset) {
+          return std::nullopt;
+        }
+        return std::string_view(reinterpret_cast<const char*>(data + offset), i - offset);
+      }
+      if (!isItaniumNameByte(ch) && !(ch == '*' && i == offset)) {
+        return std::nullopt;
+      }
+    }
+    return std::nullopt;
+  }
+
+  std::optional<std::string> readItaniumNameFromProcess(std::uintptr_t address,
+                                                        std::size_t    max_len) const {
+    return readNameFromProcess(address, max_len, itaniumNameInChunk);
+  }
+
+  // The three type_info classes used for classes: no bases, one public non-virtual base at offset
+  // 0, anything else.
+  enum class ClassTypeInfoKind {
+    None = 0,
+    Class,
+    SingleInheritance,
+    VirtualOrMultipleInheritance,
+  };
+
+  // Which class type_info class `vptr` is the vtable address point of, decided from the name of
+  // that vtable's own type_info.
+  ClassTypeInfoKind classTypeInfoKind(std::uintptr_t vptr) const {
+    constexpr std::pair<std::string_view, ClassTypeInfoKind> kClassTypeInfoNames[] = {
+        {"N10__cxxabiv117__class_type_infoE", ClassTypeInfoKind::Class},
+        {"N10__cxxabiv120__si_class_type_infoE", ClassTypeInfoKind::SingleInheritance},
+        {"N10__cxxabiv121__vmi_class_type_infoE", ClassTypeInfoKind::VirtualOrMultipleInheritance}};
+    if (vptr < sizeof(std::uintptr_t) * 2) {
+      return ClassTypeInfoKind::None;
+    }
+    std::uintptr_t header[2]{};
+    if (!m_reader->readBytes(vptr - sizeof(header), header, sizeof(header)) || header[0] != 0
+        || header[1] == 0) {
+      return ClassTypeInfoKind::None;
+    }
+    const auto name_address = m_reader->read<std::uintptr_t>(header[1] + sizeof(std::uintptr_t));
+    if (!name_address.has_value()) {
+      return ClassTypeInfoKind::None;
+    }
+    const auto name = readItaniumNameFromProcess(*name_address, 64);
+    if (!name.has_value()) {
+      return ClassTypeInfoKind::None;
+    }
+    for (const auto& [class_name, kind] : kClassTypeInfoNames) {
+      if (*name == class_name) {
+        return kind;
+      }
+    }
+    return ClassTypeInfoKind::None;
+  }
+
+  bool isClassTypeInfoVtable(std::uintptr_t vptr) const {
+    return classTypeInfoKind(vptr) != ClassTypeInfoKind::None;
+  }
+
+  std::string itaniumDisplayName(std::string_view mangled, bool demangle) const {
+    if (!demangle) {
+      return std::string(mangled);
+    }
+    auto demangled = ItaniumDemangler::demangleType(mangled);
+    return demangled.has_value() ? std::move(*demangled) : std::string(mangled);
+  }
+
+  // Phases one and two: mangled class names in the chunk buffers, then the type_info objects that
+  // point at them. Names are only accepted when they demangle completely; type_info objects only
+  // when their vptr is a class type_info vtable (checked once per distinct vptr).
+  void discoverItaniumTypes(const std::vector<Chunk>& chunks,
+                            const ScanOptions&        options,
+                            std::size_t               max_name_len,
+                            std::size_t               max_results,
+                            std::size_t               worker_count,
+                            std::vector<TypeInfo>&    results) const {
+    using Name = std::pair<std::uintptr_t, std::string>;
+
+    const std::size_t workers = (std::max)(std::size_t{1}, (std::min)(worker_count, chunks.size()));
+    std::vector<std::vector<Name>>         name_shards(workers);
+    std::vector<std::vector<std::uint8_t>> buffers(workers);
+
+    // A name is owned by the chunk holding the NUL that precedes it.
+    forEachChunk(chunks, workers, [&](std::size_t worker_index, const Chunk& chunk) {
+      std::vector<std::uint8_t>& buffer = buffers[worker_index];
+      buffer.resize(kChunkSize + kChunkOverlap);
+
+      const std::size_t to_read = chunk.size + chunk.overlap;
+      if (!readChunk(*m_reader, chunk.base, buffer.data(), to_read)) {
+        return true;
+      }
+
+      for (std::size_t i = 0; i < chunk.size && i + 2 < to_read; ++i) {
+        if (buffer[i] != 0 || !isItaniumNameStart(buffer[i + 1])) {
+          continue;
+        }
+
+        const std::uintptr_t name_addr = chunk.base + static_cast<std::uintptr_t>(i + 1);
+        std::optional<std::string> mangled;
+        if (const auto in_chunk = itaniumNameInChunk(buffer.data(), to_read, i + 1, max_name_len);
+            in_chunk.has_value()) {
+          mangled = std::string(*in_chunk);
+        } else if (i + 1 + max_name_len > to_read) {
+          mangled = readItaniumNameFromProcess(name_addr, max_name_len);
+        }
+        if (!mangled.has_value()) {
+          continue;
+        }
+
+        auto demangled = ItaniumDemangler::demangleType(*mangled);
+        if (!demangled.has_value()) {
+          continue;
+        }
+        name_shards[worker_index].emplace_back(
+            name_addr, options.demangle_names ? std::move(*demangled) : std::move(*mangled));
+      }
+      return true;
+    });
+
+    std::vector<Name> names;
+    for (auto& shard : name_shards) {
+      names.insert(names.end(), std::make_move_iterator(shard.begin()), std::make_move_iterator(shard.end()));
+    }
+    if (names.empty()) {
+      return;
+    }
+    std::sort(names.begin(), names.end(), [](const Name& a, const Name& b) { return a.first < b.first; });
+
+    std::vector<std::uintptr_t> name_addresses;
+    name_addresses.reserve(names.size());
+    for (const auto& name : names) {
+      name_addresses.push_back(name.first);
+    }
+    const AddressMatcher name_matcher(name_addresses);
+
+    // {type_info address, vptr, name index}
+    struct Candidate {
+      std::uintptr_t type_info  = 0;
+      std::uintptr_t vptr       = 0;
+      std::size_t    name_index = 0;
+    };
+    std::vector<std::vector<Candidate>> candidate_shards(workers);
+
+    forEachChunk(chunks, workers, [&](std::size_t worker_index, const Chunk& chunk) {
+      std::vector<std::uint8_t>& buffer = buffers[worker_index];
+      buffer.resize(kChunkSize + kChunkOverlap);
+
+      const std::size_t to_read = chunk.size + (std::min)(chunk.overlap, sizeof(std::uintptr_t) * 2);
+      if (to_read < sizeof(std::uintptr_t) * 2 || !readChunk(*m_reader, chunk.base, buffer.data(), to_read)) {
+        return true;
+      }
+
+      const std::size_t first =
+          static_cast<std::size_t>((sizeof(std::uintptr_t) - chunk.base % sizeof(std::uintptr_t))
+                                   % sizeof(std::uintptr_t));
+      if (first + sizeof(std::uintptr_t) * 2 > to_read) {
+        return true;
+      }
+      const std::size_t slot_count = (std::min)(
+          (chunk.size - (std::min)(chunk.size, first) + sizeof(std::uintptr_t) - 1) / sizeof(std::uintptr_t),
+          (to_read - first - sizeof(std::uintptr_t) * 2) / sizeof(std::uintptr_t) + 1);
+
+      std::vector<Candidate>& out = candidate_shards[worker_index];
+      for (std::size_t block = 0; block < slot_count; block += AddressMatcher::kBlockSlots) {
+        const std::size_t   block_slots = (std::min)(AddressMatcher::kBlockSlots, slot_count - block);
+        const std::uint8_t* base = buffer.data() + first + block * sizeof(std::uintptr_t);
+        std::uint64_t mask = name_matcher.match(base + sizeof(std::uintptr_t), block_slots);
+
+        while (mask != 0) {
+          const std::size_t slot = static_cast<std::size_t>(std::countr_zero(mask));
+          mask &= mask - 1;
+
+          const std::uint8_t* object = base + slot * sizeof(std::uintptr_t);
+          const std::size_t   name_index =
+              name_matcher.find(readPointerFromBytes(object + sizeof(std::uintptr_t)));
+          const std::uintptr_t vptr = readPointerFromBytes(object);
+          if (vptr == 0) {
+            continue;
           }
+          out.push_back({chunk.base + static_cast<std::uintptr_t>(object - buffer.data()), vptr, name_index});
+        }
+      }
+      return true;
+    });
+
+    std::vector<Candidate> candidates;
+    for (auto& shard : candidate_shards) {
+      candidates.insert(candidates.end(), shard.begin(), shard.end());
+    }
+
+    std::vector<std::uintptr_t> vptrs;
+    for (const auto& candidate : candidates) {
+      vptrs.push_back(candidate.vptr);
+    }
+    std::sort(vptrs.begin(), vptrs.end());
+    vptrs.erase(std::unique(vptrs.begin(), vptrs.end()), vptrs.end());
+    std::vector<std::uintptr_t> class_vptrs;
+    for (const std::uintptr_t vptr : vptrs) {
+      if (isClassTypeInfoVtable(vptr)) {
+        class_vptrs.push_back(vptr);
+      }
+    }
+
+    std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+      return a.type_info < b.type_info;
+    });
+    for (const auto& candidate : candidates) {
+      if (results.size() >= max_results) {
+        break;
+      }
+      if (!std::binary_search(class_vptrs.begin(), class_vptrs.end(), candidate.vptr)) {
+        continue;
+      }
+      TypeInfo info{};
+      info.type_descriptor = candidate.type_info;
+      info.demangled_name  = names[candidate.name_index].second;
+      results.push_back(std::move(info));
+    }
+  }
+
+  // Phase three: a vtable is {offset-to-top, type_info*} followed by its entries. Primary vtables
+  // have offset-to-top 0, secondary ones a small negative, pointer-aligned offset.
+  void discoverItaniumVtables(const std::vector<AddressRange>& executable_ranges,
+                              const std::vector<Chunk>&        chunks,
+                              const ScanOptions&               options,
+                              std::size_t                      stride,
+                              std::size_t                      max_candidates,
+                              std::size_t                      max_vftables,
+                              std::size_t                      worker_count,
+                              std::vector<TypeInfo>&           results) const {
+    constexpr std::intptr_t kMaxOffsetToTop = 1 << 24;
+
+    std::vector<std::uintptr_t> type_infos;
+    std::vector<std::size_t>    type_indices;
+    type_infos.reserve(results.size());
+    type_indices.reserve(results.size());
+    for (std::size_t i = 0; i < results.size(); ++i) {
+      type_infos.push_back(results[i].type_descriptor);
+      type_indices.push_back(i);
+    }
+
+    const AddressMatcher matcher(type_infos);
+    collectVtables(executable_ranges,
+                   chunks,
+                   options,
+                   stride,
+                   max_candidates,
+                   max_vftables,
+                   worker_count,
+                   matcher,
+                   type_indices,
+                   VtableLayout{sizeof(std::uintptr_t), sizeof(std::uintptr_t) * 2},
+                   [](const std::uint8_t* slot, std::size_t) {
+                     const auto offset_to_top = static_cast<std::intptr_t>(readPointerFromBytes(slot));
+                     return offset_to_top == 0
+                            || (offset_to_top < 0 && offset_to_top > -kMaxOffsetToTop
+                                && offset_to_top % static_cast<std::intptr_t>(sizeof(std::uintptr_t)) == 0);
+                   },
+                   results);
+  }
+
+  std::optional<std::string> getItaniumRttiOfVtable(std::uintptr_t vtable_address, bool demangle) const {
+    if (vtable_address < sizeof(std::uintptr_t) * 2) {
+      return std::nullopt;
+    }
+    std::uintptr_t header[2]{};
+    if (!m_reader->readBytes(vtable_address - sizeof(header), header, sizeof(header)) || header[1] == 0) {
+      return std::nullopt;
+    }
+    std::uintptr_t type_info[2]{};
+    if (!m_reader->readBytes(header[1], type_info, sizeof(type_info)) || !isClassTypeInfoVtable(type_info[0])) {
+      return std::nullopt;
+    }
+    const auto mangled = readItaniumNameFromProcess(type_info[1], 256);
+    if (!mangled.has_value() || !ItaniumDemangler::demangleType(*mangled).has_value()) {
+      return std::nullopt;
+    }
+    return itaniumDisplayName(*mangled, demangle);
+  }
+
+  // ---- Class hierarchies ----
+
+  // Copies of whole data sections, read chunk by chunk on worker threads, so the many small RTTI
+  // records of a hierarchy resolve from memory. Reads outside them go to the process.
+  class SectionSnapshot {
+   public:
+    explicit SectionSnapshot(const RttiScanner& scanner) : m_scanner(scanner) {}
+
+    void load(std::vector<AddressRange> ranges, std::size_t worker_count) {
+      sortRanges(ranges);
+      std::vector<Chunk> chunks;
+      for (const AddressRange& range : ranges) {
+        if (!m_sections.empty() && range.base < m_sections.back().base + m_sections.back().bytes.size()) {
+          continue;
         }
+        m_sections.push_back({range.base, std::vector<std::uint8_t>(range.size)});
+        appendChunks(chunks, range.base, range.size);
+      }
+
+      forEachChunk(chunks, worker_count, [&](std::size_t, const Chunk& chunk) {
+        Section& section = m_sections[sectionIndex(chunk.base)];
+        readChunk(*m_scanner.m_reader, chunk.base, section.bytes.data() + (chunk.base - section.base), chunk.size);
+        return true;
+      });
+    }
+
+    // The buffered bytes from `address` to the end of its section, or an empty span.
+    std::span<const std::uint8_t> bytesFrom(std::uintptr_t address) const {
+      const std::size_t index = sectionIndex(address);
+      if (index == kNoSection) {
+        return {};
+      }
+      const Section&    section = m_sections[index];
+      const std::size_t offset  = static_cast<std::size_t>(address - section.base);
+      return std::span<const std::uint8_t>(section.bytes.data() + offset, section.bytes.size() - offset);
+    }
+
+    bool read(std::uintptr_t address, void* out, std::size_t size) const {
+      const auto bytes = bytesFrom(address);
+      if (bytes.size() >= size) {
+        std::memcpy(out, bytes.data(), size);
+        return true;
+      }
+      return m_scanner.m_reader->readBytes(address, out, size);
+    }
+
+    template <typename T>
+    std::optional<T> value(std::uintptr_t address) const {
+      T result{};
+      if (!read(address, &result, sizeof(T))) {
+        return std::nullopt;
+      }
+      return result;
+    }
+
+   private:
+    struct Section {
+      std::uintptr_t            base = 0;
+      std::vector<std::uint8_t> bytes;
+    };
+
+    static constexpr std::size_t kNoSection = static_cast<std::size_t>(-1);
+
+    std::size_t sectionIndex(std::uintptr_t address) const {
+      const auto it = std::upper_bound(
+          m_sections.begin(), m_sections.end(), address, [](std::uintptr_t value, const Section& section) {
+            return value < section.base;
+          });
+      if (it == m_sections.begin()) {
+        return kNoSection;
+      }
+      const auto index = static_cast<std::size_t>(it - m_sections.begin()) - 1;
+      return address - m_sections[index].base < m_sections[index].bytes.size() ? index : kNoSection;
+    }
+
+    const RttiScanner&   m_scanner;
+    std::vector<Section> m_sections;
+  };
+
+  // A type descriptor's display name, for bases the scan did not report.
+  std::string msvcTypeName(const SectionSnapshot& snapshot, std::uintptr_t type_descriptor, bool demangle) const {
+    const std::uintptr_t       name_address = type_descriptor + sizeof(std::uintptr_t) * 2;
+    const auto                 bytes        = snapshot.bytesFrom(name_address);
+    std::optional<std::string> name         = parseDecoratedNameInChunk(bytes.data(), bytes.size(), 0, 256);
+    if (!name.has_value()) {
+      name = readDecoratedNameFromProcess(name_address, 256);
+    }
+    if (!name.has_value() || !looksLikeRttiDecoratedName(*name)) {
+      return {};
+    }
+    return demangle ? demangleFast(*name) : *name;
+  }
+
+  std::string itaniumTypeName(const SectionSnapshot& snapshot, std::uintptr_t type_info, bool demangle) const {
+    const auto name_address = snapshot.value<std::uintptr_t>(type_info + sizeof(std::uintptr_t));
+    if (!name_address.has_value()) {
+      return {};
+    }
+    const auto                 bytes = snapshot.bytesFrom(*name_address);
+    std::optional<std::string> name;
+    if (const auto in_snapshot = itaniumNameInChunk(bytes.data(), bytes.size(), 0, 256); in_snapshot.has_value()) {
+      name = std::string(*in_snapshot);
+    } else {
+      name = readItaniumNameFromProcess(*name_address, 256);
+    }
+    return name.has_value() ? itaniumDisplayName(*name, demangle) : std::string{};
+  }
+
+  // Image-relative on x64, absolute on x86.
+  static std::uintptr_t msvcRecordAddress(std::uintptr_t image_base, std::int32_t value) {
+    if constexpr (sizeof(std::uintptr_t) == 8) {
+      return value <= 0 ? 0 : image_base + static_cast<std::uintptr_t>(value);
+    } else {
+      return static_cast<std::uintptr_t>(static_cast<std::uint32_t>(value));
+    }
+  }
+
+  // COL -> ClassHierarchyDescriptor -> BaseClassArray -> BaseClassDescriptors. The array lists the
+  // class itself and then every base depth first, each followed by its own bases
+  // (numContainedBases of them), so the direct bases are found by skipping over those subtrees.
+  void resolveMsvcBases(const SectionSnapshot& snapshot,
+                        ClassHierarchy&        hierarchy,
+                        std::size_t            index,
+                        bool                   demangle) const {
+    constexpr std::size_t   kChdSize               = 16;
+    constexpr std::size_t   kBcdSize               = 28;
+    constexpr std::uint32_t kMaxBaseClasses        = 4096;
+    constexpr std::uint32_t kBcdPrivateOrProtected = 0x04;
+
+    const ClassHierarchy::Class& entry = hierarchy[index];
+    if (entry.vftables.empty() || entry.vftables.front() < sizeof(std::uintptr_t)) {
+      return;
+    }
+    const std::uintptr_t type_descriptor = entry.type_descriptor;
+
+    const auto col_address = snapshot.value<std::uintptr_t>(entry.vftables.front() - sizeof(std::uintptr_t));
+    std::uint8_t col[kColSize]{};
+    if (!col_address.has_value() || !snapshot.read(*col_address, col, sizeof(col))
+        || typeDescriptorFromColBytes(col, *col_address) != type_descriptor) {
+      return;
+    }
+    std::uintptr_t image_base = 0;
+    if constexpr (sizeof(std::uintptr_t) == 8) {
+      image_base = *col_address - static_cast<std::uintptr_t>(readValueFromBytes<std::int32_t>(col + 20));
+    }
+
+    std::uint8_t chd[kChdSize]{};
+    const std::uintptr_t chd_address = msvcRecordAddress(image_base, readValueFromBytes<std::int32_t>(col + 16));
+    if (chd_address == 0 || !snapshot.read(chd_address, chd, sizeof(chd))) {
+      return;
+    }
+    const auto count = readValueFromBytes<std::uint32_t>(chd + 8);
+    const std::uintptr_t array_address = msvcRecordAddress(image_base, readValueFromBytes<std::int32_t>(chd + 12));
+    if (count == 0 || count > kMaxBaseClasses || array_address == 0) {
+      return;
+    }
+    std::vector<std::int32_t> array(count);
+    if (!snapshot.read(array_address, array.data(), array.size() * sizeof(std::int32_t))) {
+      return;
+    }
+
+    struct Descriptor {
+      std::uintptr_t type_descriptor = 0;
+      std::uint32_t  contained       = 0;
+      std::int32_t   mdisp           = 0;
+      std::int32_t   pdisp           = -1;
+      std::int32_t   vdisp           = 0;
+      std::uint32_t  attributes      = 0;
+    };
+    std::vector<Descriptor> descriptors(count);
+    for (std::uint32_t i = 0; i < count; ++i) {
+      std::uint8_t bcd[kBcdSize]{};
+      const std::uintptr_t bcd_address = msvcRecordAddress(image_base, array[i]);
+      if (bcd_address == 0 || !snapshot.read(bcd_address, bcd, sizeof(bcd))) {
+        return;
+      }
+      descriptors[i].type_descriptor = msvcRecordAddress(image_base, readValueFromBytes<std::int32_t>(bcd));
+      descriptors[i].contained       = readValueFromBytes<std::uint32_t>(bcd + 4);
+      descriptors[i].mdisp           = readValueFromBytes<std::int32_t>(bcd + 8);
+      descriptors[i].pdisp           = readValueFromBytes<std::int32_t>(bcd + 12);
+      descriptors[i].vdisp           = readValueFromBytes<std::int32_t>(bcd + 16);
+      descriptors[i].attributes      = readValueFromBytes<std::uint32_t>(bcd + 20);
+    }
+    if (descriptors[0].type_descriptor != type_descriptor) {
+      return;
+    }
+
+    std::vector<ClassHierarchy::Base> bases;
+    const std::size_t end = (std::min)(std::size_t{count}, std::size_t{1} + descriptors[0].contained);
+    for (std::size_t i = 1; i < end; i += std::size_t{1} + descriptors[i].contained) {
+      const Descriptor& descriptor = descriptors[i];
+      if (descriptor.type_descriptor == 0) {
+        return;
+      }
+      std::size_t base_index = hierarchy.find(descriptor.type_descriptor);
+      if (base_index == ClassHierarchy::npos) {
+        base_index = hierarchy.add(descriptor.type_descriptor,
+                                   msvcTypeName(snapshot, descriptor.type_descriptor, demangle));
+      }
 
-        cursor += static_cast<std::uintptr_t>(to_read);
+      ClassHierarchy::Base base;
+      base.index      = base_index;
+      base.is_virtual = descriptor.pdisp >= 0;
+      base.is_public  = (descriptor.attributes & kBcdPrivateOrProtected) == 0;
+      if (base.is_virtual) {
+        base.offset         = descriptor.pdisp;
+        base.vbtable_offset = descriptor.vdisp;
+      } else {
+        base.offset = descriptor.mdisp;
+      }
+      bases.push_back(base);
+    }
+    hierarchy.setBases(index, std::move(bases));
+  }
+
+  // __si_class_type_info adds one base type_info pointer; __vmi_class_type_info adds flags, a base
+  // count and {base type_info*, offset_flags} pairs, where offset_flags holds the offset above bit
+  // 8 and the virtual (1) and public (2) flags below it.
+  void resolveItaniumBases(const SectionSnapshot&                                 snapshot,
+                           ClassHierarchy&                                        hierarchy,
+                           std::size_t                                            index,
+                           bool                                                   demangle,
+                           std::unordered_map<std::uintptr_t, ClassTypeInfoKind>& kinds) const {
+    constexpr std::uint32_t kMaxBaseClasses = 4096;
+    constexpr std::intptr_t kVirtualMask    = 1;
+    constexpr std::intptr_t kPublicMask     = 2;
+    constexpr int           kOffsetShift    = 8;
+
+    const std::uintptr_t type_info = hierarchy[index].type_descriptor;
+    const auto           vptr      = snapshot.value<std::uintptr_t>(type_info);
+    if (!vptr.has_value()) {
+      return;
+    }
+    auto kind_it = kinds.find(*vptr);
+    if (kind_it == kinds.end()) {
+      kind_it = kinds.emplace(*vptr, classTypeInfoKind(*vptr)).first;
+    }
+
+    const auto add_base = [&](std::uintptr_t base_type_info) {
+      std::size_t base_index = hierarchy.find(base_type_info);
+      if (base_index == ClassHierarchy::npos) {
+        base_index = hierarchy.add(base_type_info, itaniumTypeName(snapshot, base_type_info, demangle));
+      }
+      return base_index;
+    };
+
+    const std::uintptr_t              fields = type_info + sizeof(std::uintptr_t) * 2;
+    std::vector<ClassHierarchy::Base> bases;
+    switch (kind_it->second) {
+      case ClassTypeInfoKind::None:
+        return;
+      case ClassTypeInfoKind::Class:
+        break;
+      case ClassTypeInfoKind::SingleInheritance: {
+        const auto base_type_info = snapshot.value<std::uintptr_t>(fields);
+        if (!base_type_info.has_value() || *base_type_info == 0) {
+          return;
+        }
+        ClassHierarchy::Base base;
+        base.index = add_base(*base_type_info);
+        bases.push_back(base);
+        break;
+      }
+      case ClassTypeInfoKind::VirtualOrMultipleInheritance: {
+        const auto count = snapshot.value<std::uint32_t>(fields + 4);
+        if (!count.has_value() || *count > kMaxBaseClasses) {
+          return;
+        }
+        std::vector<std::uintptr_t> pairs(std::size_t{*count} * 2);
+        if (!snapshot.read(fields + 8, pairs.data(), pairs.size() * sizeof(std::uintptr_t))) {
+          return;
+        }
+        for (std::uint32_t i = 0; i < *count; ++i) {
+          const std::uintptr_t base_type_info = pairs[i * 2];
+          const auto           offset_flags   = static_cast<std::intptr_t>(pairs[i * 2 + 1]);
+          if (base_type_info == 0) {
+            return;
+          }
+          ClassHierarchy::Base base;
+          base.index      = add_base(base_type_info);
+          base.offset     = offset_flags >> kOffsetShift;
+          base.is_virtual = (offset_flags & kVirtualMask) != 0;
+          base.is_public  = (offset_flags & kPublicMask) != 0;
+          bases.push_back(base);
+        }
+        break;
       }
     }
+    hierarchy.setBases(index, std::move(bases));
   }
 
   const MemoryReader* m_reader = nullptr;
@@ -0,0 +1,361 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace farcal::memory
+{
+
+    // The text filter of a string scan: an optional substring and an optional regular expression
+    // (ECMAScript syntax, matched anywhere in the string), both ASCII case-insensitive unless
+    // case_sensitive is set.
+    //
+    // The expression is compiled once. Literals every match must contain are pulled out of it, and
+    // together with the substring they reject runs from their raw bytes, before a run is converted
+    // or the expression is run, and whole chunks in which the rarest one never occurs. Only the
+    // few survivors reach the regex engine.
+    class StringFilter
+    {
+    public:
+        // Nullopt when `pattern` is not a valid expression.
+        [[nodiscard]] static std::optional<StringFilter> create(
+            std::string_view contains,
+            std::string_view pattern,
+            bool case_sensitive)
+        {
+            StringFilter filter;
+            filter.m_case_sensitive = case_sensitive;
+            filter.m_contains = case_sensitive ? std::string(contains) : fold(contains);
+
+            if (!pattern.empty())
+            {
+                auto flags = std::regex::ECMAScript | std::regex::optimize;
+                if (!case_sensitive)
+                {
+                    flags |= std::regex::icase;
+                }
+                try
+                {
+                    filter.m_pattern.emplace(pattern.begin(), pattern.end(), flags);
+                }
+                catch (const std::regex_error &)
+                {
+                    return std::nullopt;
+                }
+
+                for (auto &literal : requiredLiterals(pattern))
+                {
+                    filter.m_required.push_back(case_sensitive ? std::move(literal) : fold(literal));
+                }
+            }
+            if (!filter.m_contains.empty())
+            {
+                filter.m_required.push_back(filter.m_contains);
+            }
+            filter.prepareRequired();
+            return filter;
+        }
+
+        [[nodiscard]] static bool isValidPattern(std::string_view pattern)
+        {
+            return create({}, pattern, true).has_value();
+        }
+
+        [[nodiscard]] bool empty() const noexcept
+        {
+            return m_contains.empty() && !m_pattern.has_value();
+        }
+
+        // False when no string in data[0, size) can match: the longest required literal occurs in it
+        // neither as ASCII nor as UTF-16LE.
+        [[nodiscard]] bool mayMatchBlock(const std::uint8_t *data, std::size_t size) const
+        {
+            if (m_required.empty())
+            {
+                return true;
+            }
+            const char *first = reinterpret_cast<const char *>(data);
+            const char *last = first + size;
+            const bool fold_case = !m_case_sensitive;
+            const Searcher narrow(m_narrow.begin(), m_narrow.end(), ByteHash{fold_case}, ByteEqual{fold_case});
+            if (std::search(first, last, narrow) != last)
+            {
+                return true;
+            }
+            const Searcher wide(m_wide.begin(), m_wide.end(), ByteHash{fold_case}, ByteEqual{fold_case});
+            return std::search(first, last, wide) != last;
+        }
+
+        // False when the run of `count` characters at `bytes` cannot match, tested on its raw bytes:
+        // ASCII with stride 1, UTF-16LE with stride 2.
+        [[nodiscard]] bool mayMatchRun(const std::uint8_t *bytes, std::size_t count, std::size_t stride) const
+        {
+            for (const std::string &literal : m_required)
+            {
+                if (!containsLiteral(bytes, count, stride, literal))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // The full test, on the converted text.
+        [[nodiscard]] bool matches(std::string_view text) const
+        {
+            if (!m_contains.empty())
+            {
+                const bool found = m_case_sensitive
+                                       ? text.find(m_contains) != std::string_view::npos
+                                       : std::search(text.begin(), text.end(), m_contains.begin(), m_contains.end(), FoldEqual{}) != text.end();
+                if (!found)
+                {
+                    return false;
+                }
+            }
+            return !m_pattern.has_value() || std::regex_search(text.begin(), text.end(), *m_pattern);
+        }
+
+        // Literals that every match of `pattern` contains, found conservatively: maximal runs of
+        // plain characters at the top level of the expression. Anything it does not understand
+        // (classes, groups, escapes like \d, optional atoms) just ends a run, and a top-level
+        // alternation yields none.
+        [[nodiscard]] static std::vector<std::string> requiredLiterals(std::string_view pattern)
+        {
+            std::vector<std::string> literals;
+            std::string current;
+            const auto end_run = [&]()
+            {
+                if (!current.empty())
+                {
+                    literals.push_back(std::move(current));
+                    current.clear();
+                }
+            };
+
+            std::size_t i = 0;
+            while (i < pattern.size())
+            {
+                const char c = pattern[i];
+                std::optional<char> literal;
+                if (c == '\\' && i + 1 < pattern.size())
+                {
+                    const char escaped = pattern[i + 1];
+                    const bool is_class = std::string_view("dDwWsSbBnrtfv0123456789cxuk").find(escaped) != std::string_view::npos;
+                    if (!is_class)
+                    {
+                        literal = escaped;
+                    }
+                    // \xHH, \uHHHH, \cX and \k<name> run on past the escaped character.
+                    i += 2;
+                    if (escaped == 'x' || escaped == 'u' || escaped == 'c')
+                    {
+                        i = (std::min)(pattern.size(), i + (escaped == 'x' ? 2 : escaped == 'u' ? 4 : 1));
+                    }
+                    else if (escaped == 'k')
+                    {
+                        i = (std::min)(pattern.find('>', i), pattern.size() - 1) + 1;
+                    }
+                }
+                else if (c == '(' || c == '[')
+                {
+                    i = skipGroup(pattern, i);
+                }
+                else if (c == '|')
+                {
+                    return {};
+                }
+                else if (std::string_view(".^$)]*+?{}").find(c) != std::string_view::npos)
+                {
+                    ++i;
+                }
+                else
+                {
+                    literal = c;
+                    ++i;
+                }
+
+                // A quantifier after the atom: `+` keeps one copy of it, anything else may drop it.
+                const char quantifier = i < pattern.size() ? pattern[i] : '\0';
+                const bool quantified = quantifier == '*' || quantifier == '+' || quantifier == '?' || quantifier == '{';
+                if (literal.has_value() && (!quantified || quantifier == '+'))
+                {
+                    current.push_back(*literal);
+                }
+                if (!literal.has_value() || quantified)
+                {
+                    end_run();
+                }
+                if (quantified)
+                {
+                    i = quantifier == '{' ? (std::min)(pattern.find('}', i), pattern.size()) + 1 : i + 1;
+                    if (i < pattern.size() && pattern[i] == '?')
+                    {
+                        ++i;
+                    }
+                }
+            }
+            end_run();
+            return literals;
+        }
+
+    private:
+        struct FoldEqual
+        {
+            bool operator()(char a, char b) const noexcept
+            {
+                return foldChar(a) == foldChar(b);
+            }
+        };
+
+        struct ByteHash
+        {
+            bool fold = false;
+            std::size_t operator()(char c) const noexcept
+            {
+                return static_cast<unsigned char>(fold ? foldChar(c) : c);
+            }
+        };
+
+        struct ByteEqual
+        {
+            bool fold = false;
+            bool operator()(char a, char b) const noexcept
+            {
+                return fold ? foldChar(a) == foldChar(b) : a == b;
+            }
+        };
+
+        using Searcher = std::boyer_moore_horspool_searcher<std::string::const_iterator, ByteHash, ByteEqual>;
+
+        [[nodiscard]] static char foldChar(char c) noexcept
+        {
+            return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+        }
+
+        [[nodiscard]] static std::string fold(std::string_view text)
+        {
+            std::string folded(text);
+            std::transform(folded.begin(), folded.end(), folded.begin(), foldChar);
+            return folded;
+        }
+
+        // Index just past the group or class starting at pattern[start].
+        [[nodiscard]] static std::size_t skipGroup(std::string_view pattern, std::size_t start)
+        {
+            int depth = 0;
+            bool in_class = false;
+            for (std::size_t i = start; i < pattern.size(); ++i)
+            {
+                const char c = pattern[i];
+                if (c == '\\')
+                {
+                    ++i;
+                }
+                else if (in_class)
+                {
+                    in_class = c != ']' || i == start + 1;
+                    if (!in_class && depth == 0)
+                    {
+                        return i + 1;
+                    }
+                }
+                else if (c == '[')
+                {
+                    in_class = true;
+                }
+                else if (c == '(')
+                {
+                    ++depth;
+                }
+                else if (c == ')' && --depth == 0)
+                {
+                    return i + 1;
+                }
+            }
+            return pattern.size();
+        }
+
+        // Only ASCII literals can be looked for in the raw bytes of both encodings; the longest,
+        // usually the rarest, goes first and also drives the whole-block test.
+        void prepareRequired()
+        {
+            m_required.erase(
+                std::remove_if(m_required.begin(), m_required.end(), [](const std::string &literal)
+                               { return literal.empty() || std::any_of(literal.begin(), literal.end(), [](char c)
+                                                                       { return static_cast<unsigned char>(c) >= 0x80; }); }),
+                m_required.end());
+            std::stable_sort(m_required.begin(), m_required.end(), [](const std::string &a, const std::string &b)
+                             { return a.size() > b.size(); });
+            if (m_required.empty())
+            {
+                return;
+            }
+
+            m_narrow = m_required.front();
+            m_wide.clear();
+            for (const char c : m_narrow)
+            {
+                m_wide.push_back(c);
+                m_wide.push_back('\0');
+            }
+        }
+
+        [[nodiscard]] bool containsLiteral(
+            const std::uint8_t *bytes,
+            std::size_t count,
+            std::size_t stride,
+            const std::string &literal) const
+        {
+            if (literal.size() > count)
+            {
+                return false;
+            }
+            const char first = literal.front();
+            for (std::size_t i = 0; i + literal.size() <= count; ++i)
+            {
+                if (!charAt(bytes, i, stride, first))
+                {
+                    continue;
+                }
+                std::size_t k = 1;
+                while (k < literal.size() && charAt(bytes, i + k, stride, literal[k]))
+                {
+                    ++k;
+                }
+                if (k == literal.size())
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        [[nodiscard]] bool charAt(const std::uint8_t *bytes, std::size_t index, std::size_t stride, char expected) const
+        {
+            const std::uint8_t *unit = bytes + index * stride;
+            if (stride == 2 && unit[1] != 0)
+            {
+                return false;
+            }
+            const char c = static_cast<char>(unit[0]);
+            return m_case_sensitive ? c == expected : foldChar(c) == expected;
+        }
+
+        bool m_case_sensitive = false;
+        std::string m_contains; // folded unless case-sensitive
+        std::optional<std::regex> m_pattern;
+        std::vector<std::string> m_required; // folded unless case-sensitive, longest first
+        std::string m_narrow;                // m_required.front(), and as UTF-16LE bytes
+        std::string m_wide;
+    };
+
+} // namespace farcal::memory
@@ -0,0 +1,248 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace farcal::memory
+{
+
+    // Trigram index over scanned strings for substring filtering. Each string is split into its
+    // overlapping 3-byte sequences, ASCII case-folded; a query only has to verify the strings that
+    // contain every trigram of the needle instead of all of them.
+    //
+    // Strings are numbered in the order they were added. The trigrams of a batch are extracted into
+    // a Segment, which is thread-independent and can be built wherever the batch is produced, and
+    // append() then only merges its postings.
+    //
+    // Matching folds ASCII letters only; other bytes, including UTF-8 sequences, must match exactly.
+    //
+    // Strings replaced by an incremental rescan are erase()d: their postings stay until clear(),
+    // they are only dropped from results, so ids of the other strings never change.
+    class StringIndex
+    {
+    public:
+        struct Segment
+        {
+            std::vector<std::uint64_t> entries; // trigram << 32 | id within the segment, sorted, unique
+            std::uint32_t count = 0;            // strings in the segment
+        };
+
+        // Segment for `count` strings, string `id` being text_of(id).
+        template <typename TextOf>
+        [[nodiscard]] static Segment buildSegment(std::size_t count, TextOf &&text_of)
+        {
+            Segment segment;
+            segment.count = static_cast<std::uint32_t>(count);
+            for (std::size_t id = 0; id < count; ++id)
+            {
+                const std::string_view text = text_of(id);
+                for (std::size_t i = 0; i + 3 <= text.size(); ++i)
+                {
+                    segment.entries.push_back(
+                        (static_cast<std::uint64_t>(trigramAt(text, i)) << 32) | static_cast<std::uint64_t>(id));
+                }
+            }
+
+            std::sort(segment.entries.begin(), segment.entries.end());
+            segment.entries.erase(std::unique(segment.entries.begin(), segment.entries.end()), segment.entries.end());
+            return segment;
+        }
+
+        // Adds the strings of `segment`, numbered on from size().
+        void append(const Segment &segment)
+        {
+            const std::uint32_t base = m_size;
+            std::vector<std::uint32_t> *postings = nullptr;
+            std::uint32_t current = 0;
+            for (const std::uint64_t entry : segment.entries)
+            {
+                const auto trigram = static_cast<std::uint32_t>(entry >> 32);
+                if (postings == nullptr || trigram != current)
+                {
+                    postings = &m_postings[trigram];
+                    current = trigram;
+                }
+                postings->push_back(base + static_cast<std::uint32_t>(entry));
+            }
+            m_size += segment.count;
+            m_erased.resize((m_size + 63) / 64, 0);
+        }
+
+        // Leaves string `id` out of find() results from now on.
+        void erase(std::uint32_t id)
+        {
+            std::uint64_t &word = m_erased[id / 64];
+            const std::uint64_t bit = std::uint64_t{1} << (id % 64);
+            m_erasedCount += (word & bit) == 0 ? 1 : 0;
+            word |= bit;
+        }
+
+        [[nodiscard]] bool erased(std::uint32_t id) const noexcept
+        {
+            return (m_erased[id / 64] >> (id % 64) & 1) != 0;
+        }
+
+        // Strings erase()d since the last clear().
+        [[nodiscard]] std::uint32_t erasedCount() const noexcept
+        {
+            return m_erasedCount;
+        }
+
+        void clear() noexcept
+        {
+            m_postings.clear();
+            m_erased.clear();
+            m_size = 0;
+            m_erasedCount = 0;
+        }
+
+        [[nodiscard]] std::uint32_t size() const noexcept
+        {
+            return m_size;
+        }
+
+        [[nodiscard]] static std::string fold(std::string_view text)
+        {
+            std::string folded(text);
+            for (char &c : folded)
+            {
+                c = foldChar(c);
+            }
+            return folded;
+        }
+
+        // Whether `text` contains `folded_needle`, which must already be fold()ed.
+        [[nodiscard]] static bool containsFolded(std::string_view text, std::string_view folded_needle)
+        {
+            return std::search(
+                       text.begin(),
+                       text.end(),
+                       folded_needle.begin(),
+                       folded_needle.end(),
+                       [](char a, char b)
+                       { return foldChar(a) == b; }) != text.end();
+        }
+
+        // Ids of the strings containing `needle`, case-insensitively, ascending, erased ones excluded.
+        // With `within` (sorted ids, e.g. the result of a query `needle` extends) only those are
+        // considered.
+        template <typename TextOf>
+        [[nodiscard]] std::vector<std::uint32_t> find(
+            std::string_view needle,
+            TextOf &&text_of,
+            const std::vector<std::uint32_t> *within = nullptr) const
+        {
+            const std::string folded = fold(needle);
+            std::vector<std::uint32_t> candidates;
+            if (folded.size() >= 3)
+            {
+                if (!trigramCandidates(folded, within, candidates))
+                {
+                    return {};
+                }
+            }
+            else if (within != nullptr)
+            {
+                candidates = *within;
+            }
+            else
+            {
+                candidates.resize(m_size);
+                for (std::uint32_t id = 0; id < m_size; ++id)
+                {
+                    candidates[id] = id;
+                }
+            }
+
+            std::size_t kept = 0;
+            for (const std::uint32_t id : candidates)
+            {
+                if (!erased(id) && (folded.empty() || containsFolded(text_of(id), folded)))
+                {
+                    candidates[kept++] = id;
+                }
+            }
+            candidates.resize(kept);
+            return candidates;
+        }
+
+    private:
+        [[nodiscard]] static char foldChar(char c) noexcept
+        {
+            return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+        }
+
+        [[nodiscard]] static std::uint32_t trigramAt(std::string_view text, std::size_t i) noexcept
+        {
+            return (static_cast<std::uint32_t>(static_cast<unsigned char>(foldChar(text[i]))) << 16) |
+                   (static_cast<std::uint32_t>(static_cast<unsigned char>(foldChar(text[i + 1]))) << 8) |
+                   static_cast<std::uint32_t>(static_cast<unsigned char>(foldChar(text[i + 2])));
+        }
+
+        // Intersection of the postings of every trigram of `folded` (and of `within`), smallest list
+        // first. False when some trigram occurs nowhere.
+        bool trigramCandidates(
+            const std::string &folded,
+            const std::vector<std::uint32_t> *within,
+            std::vector<std::uint32_t> &candidates) const
+        {
+            std::vector<const std::vector<std::uint32_t> *> lists;
+            for (std::size_t i = 0; i + 3 <= folded.size(); ++i)
+            {
+                const auto it = m_postings.find(trigramAt(folded, i));
+                if (it == m_postings.end())
+                {
+                    return false;
+                }
+                lists.push_back(&it->second);
+            }
+            if (within != nullptr)
+            {
+                lists.push_back(within);
+            }
+
+            std::sort(lists.begin(), lists.end(), [](const auto *a, const auto *b)
+                      { return a->size() != b->size() ? a->size() < b->size() : std::less<>{}(a, b); });
+            lists.erase(std::unique(lists.begin(), lists.end()), lists.end());
+
+            candidates = *lists.front();
+            std::vector<std::uint32_t> next;
+            for (std::size_t l = 1; l < lists.size() && !candidates.empty(); ++l)
+            {
+                const std::vector<std::uint32_t> &list = *lists[l];
+                next.clear();
+                if (list.size() / 16 > candidates.size())
+                {
+                    // Much longer list: probe it instead of walking it.
+                    for (const std::uint32_t id : candidates)
+                    {
+                        if (std::binary_search(list.begin(), list.end(), id))
+                        {
+                            next.push_back(id);
+                        }
+                    }
+                }
+                else
+                {
+                    std::set_intersection(
+                        candidates.begin(), candidates.end(), list.begin(), list.end(), std::back_inserter(next));
+                }
+                candidates.swap(next);
+            }
+            return true;
+        }
+
+        std::unordered_map<std::uint32_t, std::vector<std::uint32_t>> m_postings;
+        std::vector<std::uint64_t> m_erased; // one bit per string
+        std::uint32_t m_size = 0;
+        std::uint32_t m_erasedCount = 0;
+    };
+
+} // namespace farcal::memory
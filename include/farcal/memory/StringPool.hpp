@@ -0,0 +1,106 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace farcal::memory
+{
+
+    // Append-only arena for scanned text. Strings are copied into large blocks that never move, so a
+    // pointer returned by append() stays valid for as long as the pool, or whichever pool adopted its
+    // blocks, is alive. Nothing is freed individually; clear() drops everything at once.
+    //
+    // Not thread-safe: give every worker its own pool and merge them with adopt().
+    class StringPool
+    {
+    public:
+        static constexpr std::size_t kBlockSize = 256 * 1024;
+
+        StringPool() = default;
+        StringPool(StringPool &&) noexcept = default;
+        StringPool &operator=(StringPool &&) noexcept = default;
+        StringPool(const StringPool &) = delete;
+        StringPool &operator=(const StringPool &) = delete;
+
+        // Copies `text` into the pool and returns where it now lives. Not null-terminated.
+        [[nodiscard]] const char *append(std::string_view text)
+        {
+            if (m_blocks.empty() || m_blocks.back().size - m_blocks.back().used < text.size())
+            {
+                const std::size_t block_size = (std::max)(kBlockSize, text.size());
+                m_blocks.push_back(Block{std::unique_ptr<char[]>(new char[block_size]), block_size, 0});
+                m_reserved += block_size;
+            }
+
+            Block &block = m_blocks.back();
+            char *target = block.data.get() + block.used;
+            if (!text.empty())
+            {
+                std::memcpy(target, text.data(), text.size());
+            }
+            block.used += text.size();
+            m_used += text.size();
+            return target;
+        }
+
+        // Takes over the blocks of `other`; text already appended to either pool keeps its address.
+        // The current block stays last so its free space is still used.
+        void adopt(StringPool &&other)
+        {
+            if (other.m_blocks.empty())
+            {
+                return;
+            }
+
+            const auto insert_at = m_blocks.empty() ? m_blocks.end() : std::prev(m_blocks.end());
+            m_blocks.insert(
+                insert_at,
+                std::make_move_iterator(other.m_blocks.begin()),
+                std::make_move_iterator(other.m_blocks.end()));
+            m_used += other.m_used;
+            m_reserved += other.m_reserved;
+            other.clear();
+        }
+
+        void clear() noexcept
+        {
+            m_blocks.clear();
+            m_used = 0;
+            m_reserved = 0;
+        }
+
+        [[nodiscard]] bool empty() const noexcept
+        {
+            return m_used == 0;
+        }
+
+        [[nodiscard]] std::size_t bytesUsed() const noexcept
+        {
+            return m_used;
+        }
+
+        [[nodiscard]] std::size_t bytesReserved() const noexcept
+        {
+            return m_reserved;
+        }
+
+    private:
+        struct Block
+        {
+            std::unique_ptr<char[]> data;
+            std::size_t size = 0;
+            std::size_t used = 0;
+        };
+
+        std::vector<Block> m_blocks;
+        std::size_t m_used = 0;
+        std::size_t m_reserved = 0;
+    };
+
+} // namespace farcal::memory
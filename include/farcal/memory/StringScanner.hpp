@@ -1,28 +1,26 @@
 #pragma once
 
 #include "farcal/memory/MemoryReader.hpp"
+#include "farcal/memory/MemoryRegions.hpp"
+#include "farcal/memory/StringFilter.hpp"
+#include "farcal/memory/StringPool.hpp"
 
 #include <algorithm>
-#include <cctype>
+#include <atomic>
+#include <bit>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <future>
-#include <iterator>
 #include <limits>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <thread>
-#include <unordered_set>
 #include <utility>
 #include <vector>
 
-#ifdef _WIN32
-#ifndef WIN32_LEAN_AND_MEAN
-#define WIN32_LEAN_AND_MEAN
-#endif
-#include <windows.h>
-#endif
-
 namespace farcal::memory
 {
 
@@ -32,7 +30,8 @@ namespace farcal::memory
         enum class Encoding
         {
             Ascii,
-            Utf16
+            Utf16,
+            Utf8 // text with at least one multibyte character; all-ASCII runs stay Ascii
         };
 
         struct StringEntry
@@ -42,6 +41,28 @@ namespace farcal::memory
             Encoding encoding = Encoding::Ascii;
         };
 
+        // A scanned string whose text lives in a StringPool instead of the record itself.
+        struct StringRecord
+        {
+            std::uintptr_t address = 0;
+            const char *data = nullptr;
+            std::uint32_t length = 0;
+            Encoding encoding = Encoding::Ascii;
+
+            [[nodiscard]] std::string_view text() const noexcept
+            {
+                return std::string_view(data, length);
+            }
+        };
+
+        // What find_all_batched hands out: the records and the pool holding their text. Keep the pool,
+        // or adopt() it into a longer-lived one, for as long as the records are used.
+        struct StringBatch
+        {
+            std::vector<StringRecord> records;
+            StringPool pool;
+        };
+
         struct ScanOptions
         {
             std::uintptr_t start_address = 0;
@@ -52,12 +73,42 @@ namespace farcal::memory
             std::size_t chunk_size = 1024 * 1024;
             bool scan_ascii = true;
             bool scan_utf16 = true;
+            // Also find multibyte UTF-8 text. ASCII runs are then read as part of the UTF-8 text
+            // around them instead of as fragments between its multibyte characters.
+            bool scan_utf8 = false;
             bool include_writable_regions = true;
             bool case_sensitive_filter = false;
             std::string contains;
+            // ECMAScript regular expression the string must contain a match of; an invalid one
+            // yields no results (check with StringFilter::isValidPattern first).
+            std::string regex;
             std::size_t worker_threads = 0;
         };
 
+        // The addresses [begin, end).
+        struct AddressRange
+        {
+            std::uintptr_t begin = 0;
+            std::uintptr_t end = 0;
+        };
+
+        static constexpr std::size_t kPageSize = 4096;
+
+        // What hashPages returns: spans of consecutive pages, ascending, each with the index of its
+        // first page's hash.
+        struct PageHashes
+        {
+            struct Span
+            {
+                std::uintptr_t base = 0;
+                std::size_t first = 0;
+                std::size_t pages = 0;
+            };
+
+            std::vector<Span> spans;
+            std::vector<std::uint64_t> hashes;
+        };
+
         explicit StringScanner(const MemoryReader *reader = nullptr)
             : m_reader(reader)
         {
@@ -81,137 +132,292 @@ namespace farcal::memory
         [[nodiscard]] std::vector<StringEntry> find_all(const ScanOptions &options) const
         {
             std::vector<StringEntry> result;
-            find_all_batched(options, 4096, [&result](std::vector<StringEntry> &&batch)
+            find_all_batched(options, 4096, [&result](StringBatch &&batch)
                              {
-                                 result.insert(
-                                     result.end(),
-                                     std::make_move_iterator(batch.begin()),
-                                     std::make_move_iterator(batch.end()));
+                                 for (const auto &record : batch.records)
+                                 {
+                                     result.push_back(StringEntry{record.address, std::string(record.text()), record.encoding});
+                                 }
                              });
 
             return result;
         }
 
+        // Calls on_batch(StringBatch&&) with batches of about batch_size records as the workers finish
+        // chunks, so the first results arrive while the rest of memory is still being scanned. The
+        // calls come from the worker threads but never overlap. Each batch owns the text of its
+        // records, so nothing is allocated per string.
         template <typename BatchCallback>
         void find_all_batched(const ScanOptions &options, std::size_t batch_size, BatchCallback &&on_batch) const
+        {
+            const std::uintptr_t scan_end = options.end_address == 0
+                                                ? (std::numeric_limits<std::uintptr_t>::max)()
+                                                : options.end_address;
+            find_in_ranges_batched(options, {AddressRange{options.start_address, scan_end}}, batch_size,
+                                   std::forward<BatchCallback>(on_batch));
+        }
+
+        // find_all_batched for the strings starting in `ranges` (ascending and disjoint) only, e.g. the
+        // affectedRanges() of what changed since a previous scan. A string is read the same way as by
+        // a full scan, including the bytes around it that lie outside the ranges, so the records of a
+        // range replace the ones a previous scan found there one for one. start_address and
+        // end_address are ignored.
+        template <typename BatchCallback>
+        void find_in_ranges_batched(
+            const ScanOptions &options,
+            const std::vector<AddressRange> &ranges,
+            std::size_t batch_size,
+            BatchCallback &&on_batch) const
         {
             if (m_reader == nullptr || !m_reader->attached())
             {
                 return;
             }
-            if (!options.scan_ascii && !options.scan_utf16)
+            if (!options.scan_ascii && !options.scan_utf16 && !options.scan_utf8)
             {
                 return;
             }
 
-            const auto regions = queryRegions();
+            const auto regions = queryMemoryRegions(*m_reader);
             if (regions.empty())
             {
                 return;
             }
 
-            const std::uintptr_t scan_start = options.start_address;
+            const std::size_t min_len = minLength(options);
+            const std::size_t max_len = maxLength(options);
+            const std::size_t chunk_size = (std::max)(std::size_t{4096}, options.chunk_size);
+            const std::size_t lookahead = lookaheadBytes(options);
+            const std::size_t effective_batch_size = (std::max)(std::size_t{256}, batch_size);
+            const std::size_t max_results = options.max_results == 0
+                                                ? (std::numeric_limits<std::size_t>::max)()
+                                                : options.max_results;
+
+            const auto filter = StringFilter::create(options.contains, options.regex, options.case_sensitive_filter);
+            if (!filter.has_value())
+            {
+                return;
+            }
+
+            std::vector<Chunk> chunks;
+            for (const AddressRange &range : ranges)
+            {
+                splitChunks(regions, range.begin, range.end, chunk_size, lookahead, options, chunks);
+            }
+            if (chunks.empty())
+            {
+                return;
+            }
+
+            // Chunks are handed out one at a time from a shared counter, so a huge region is spread
+            // over all workers instead of pinning the one it was assigned to.
+            std::atomic<std::size_t> next_chunk{0};
+            std::atomic<std::size_t> found{0};
+            std::mutex emit_mutex;
+
+            const auto flush = [&](StringBatch &pending)
+            {
+                if (pending.records.empty())
+                {
+                    return;
+                }
+                {
+                    std::lock_guard<std::mutex> lock(emit_mutex);
+                    on_batch(std::move(pending));
+                }
+                pending = StringBatch{};
+                pending.records.reserve(effective_batch_size);
+            };
+
+            runWorkers(workerCount(options, chunks.size()), [&]()
+                       {
+                std::vector<std::uint8_t> buffer(kLeadBytes + chunk_size + lookahead);
+                std::vector<std::uintptr_t> byte_starts;
+                StringBatch pending;
+                pending.records.reserve(effective_batch_size);
+
+                for (std::size_t index = next_chunk.fetch_add(1, std::memory_order_relaxed); index < chunks.size();
+                     index = next_chunk.fetch_add(1, std::memory_order_relaxed))
+                {
+                    if (found.load(std::memory_order_relaxed) >= max_results)
+                    {
+                        break;
+                    }
+
+                    const std::size_t before = pending.records.size();
+                    scanChunk(chunks[index], min_len, max_len, options, *filter, buffer, byte_starts, pending);
+
+                    // Workers claim their results from the shared cap before keeping them, so the cap
+                    // is exact.
+                    const std::size_t added = pending.records.size() - before;
+                    const std::size_t claimed = found.fetch_add(added, std::memory_order_relaxed);
+                    if (added > max_results - (std::min)(claimed, max_results))
+                    {
+                        pending.records.resize(before + (max_results - (std::min)(claimed, max_results)));
+                        flush(pending);
+                        return;
+                    }
+
+                    if (pending.records.size() >= effective_batch_size)
+                    {
+                        flush(pending);
+                    }
+                }
+                flush(pending); });
+        }
+
+        // One hash per kPageSize page of the memory a scan with `options` covers (the same regions,
+        // clipped to start_address/end_address), to find what a later scan has to look at again.
+        // Reading memory and hashing it is several times faster than scanning it for strings.
+        [[nodiscard]] PageHashes hashPages(const ScanOptions &options) const
+        {
+            PageHashes hashes;
+            if (m_reader == nullptr || !m_reader->attached())
+            {
+                return hashes;
+            }
+
             const std::uintptr_t scan_end = options.end_address == 0
                                                 ? (std::numeric_limits<std::uintptr_t>::max)()
                                                 : options.end_address;
-            const std::size_t min_len = (std::max)(std::size_t{1}, options.min_length);
-            const std::size_t max_len = (std::max)(min_len, options.max_length == 0 ? std::size_t{512} : options.max_length);
-            const std::size_t chunk_size = (std::max)(std::size_t{4096}, options.chunk_size);
-            const std::size_t overlap = (std::max)(max_len * 2, max_len);
-            const std::size_t effective_batch_size = (std::max)(std::size_t{256}, batch_size);
-            std::vector<StringEntry> outgoing;
-            outgoing.reserve(effective_batch_size);
+            std::vector<Chunk> chunks;
+            splitChunks(queryMemoryRegions(*m_reader), options.start_address, scan_end, kHashChunkSize, 0, options, chunks);
 
-            std::size_t total_results = 0;
-            auto push_entries = [&](std::vector<StringEntry> &&entries) -> bool {
-                for (auto &entry : entries)
+            // Every chunk but the last of a region is a whole number of pages, so pages never
+            // straddle chunks; a partial page at the end of a region is hashed as far as it goes.
+            std::vector<std::size_t> first_page(chunks.size());
+            for (std::size_t index = 0; index < chunks.size(); ++index)
+            {
+                const Chunk &chunk = chunks[index];
+                const std::size_t pages = (chunk.size + kPageSize - 1) / kPageSize;
+                if (hashes.spans.empty() ||
+                    hashes.spans.back().base + hashes.spans.back().pages * kPageSize != chunk.base)
                 {
-                    if (options.max_results > 0 && total_results >= options.max_results)
+                    hashes.spans.push_back(PageHashes::Span{chunk.base, hashes.hashes.size(), 0});
+                }
+                hashes.spans.back().pages += pages;
+                first_page[index] = hashes.hashes.size();
+                hashes.hashes.resize(hashes.hashes.size() + pages);
+            }
+
+            std::atomic<std::size_t> next_chunk{0};
+            runWorkers(workerCount(options, chunks.size()), [&]()
+                       {
+                std::vector<std::uint8_t> buffer(kHashChunkSize);
+                for (std::size_t index = next_chunk.fetch_add(1, std::memory_order_relaxed); index < chunks.size();
+                     index = next_chunk.fetch_add(1, std::memory_order_relaxed))
+                {
+                    const Chunk &chunk = chunks[index];
+                    if (!readChunk(*m_reader, chunk.base, buffer.data(), chunk.size))
                     {
-                        return false;
+                        std::memset(buffer.data(), 0, chunk.size);
+                    }
+                    for (std::size_t offset = 0, page = first_page[index]; offset < chunk.size; offset += kPageSize, ++page)
+                    {
+                        hashes.hashes[page] = hashBytes(buffer.data() + offset, (std::min)(kPageSize, chunk.size - offset));
                     }
+                } });
+            return hashes;
+        }
+
+        // The pages whose hash differs between two hashPages() results of the same process, and
+        // those present in only one of them (memory mapped or released in between), as ascending
+        // disjoint ranges.
+        [[nodiscard]] static std::vector<AddressRange> changedRanges(const PageHashes &before, const PageHashes &after)
+        {
+            struct Cursor
+            {
+                const PageHashes &hashes;
+                std::size_t span = 0;
+                std::size_t page = 0;
+
+                [[nodiscard]] bool done() const
+                {
+                    return span == hashes.spans.size();
+                }
+
+                [[nodiscard]] std::uintptr_t address() const
+                {
+                    return hashes.spans[span].base + page * kPageSize;
+                }
 
-                    outgoing.push_back(std::move(entry));
-                    ++total_results;
+                [[nodiscard]] std::uint64_t hash() const
+                {
+                    return hashes.hashes[hashes.spans[span].first + page];
+                }
 
-                    if (outgoing.size() >= effective_batch_size)
+                void next()
+                {
+                    if (++page == hashes.spans[span].pages)
                     {
-                        on_batch(std::move(outgoing));
-                        outgoing.clear();
-                        outgoing.reserve(effective_batch_size);
+                        ++span;
+                        page = 0;
                     }
                 }
-                return true;
             };
 
-            const std::size_t requested_workers = options.worker_threads == 0
-                                                      ? static_cast<std::size_t>((std::max)(1u, std::thread::hardware_concurrency()))
-                                                      : options.worker_threads;
-            const std::size_t worker_count = (std::max)(std::size_t{1}, (std::min)(requested_workers, regions.size()));
+            std::vector<AddressRange> changed;
+            const auto mark = [&changed](std::uintptr_t page)
+            {
+                if (!changed.empty() && changed.back().end >= page)
+                {
+                    changed.back().end = page + kPageSize;
+                    return;
+                }
+                changed.push_back(AddressRange{page, page + kPageSize});
+            };
 
-            if (worker_count == 1)
+            Cursor old_page{before};
+            Cursor new_page{after};
+            while (!old_page.done() || !new_page.done())
             {
-                std::vector<StringEntry> entries = scanRegionSubset(
-                    regions,
-                    0,
-                    1,
-                    scan_start,
-                    scan_end,
-                    min_len,
-                    max_len,
-                    chunk_size,
-                    overlap,
-                    options
-                );
-                (void)push_entries(std::move(entries));
-            }
-            else
-            {
-                std::vector<std::future<std::vector<StringEntry>>> futures;
-                futures.reserve(worker_count);
-
-                for (std::size_t worker_index = 0; worker_index < worker_count; ++worker_index)
-                {
-                    futures.emplace_back(std::async(std::launch::async, [this,
-                                                                         &regions,
-                                                                         worker_index,
-                                                                         worker_count,
-                                                                         scan_start,
-                                                                         scan_end,
-                                                                         min_len,
-                                                                         max_len,
-                                                                         chunk_size,
-                                                                         overlap,
-                                                                         options]() {
-                        return scanRegionSubset(
-                            regions,
-                            worker_index,
-                            worker_count,
-                            scan_start,
-                            scan_end,
-                            min_len,
-                            max_len,
-                            chunk_size,
-                            overlap,
-                            options
-                        );
-                    }));
-                }
-
-                for (auto &future : futures)
-                {
-                    std::vector<StringEntry> entries = future.get();
-                    if (!push_entries(std::move(entries)))
+                if (new_page.done() || (!old_page.done() && old_page.address() < new_page.address()))
+                {
+                    mark(old_page.address());
+                    old_page.next();
+                }
+                else if (old_page.done() || new_page.address() < old_page.address())
+                {
+                    mark(new_page.address());
+                    new_page.next();
+                }
+                else
+                {
+                    if (old_page.hash() != new_page.hash())
                     {
-                        break;
+                        mark(old_page.address());
                     }
+                    old_page.next();
+                    new_page.next();
                 }
             }
+            return changed;
+        }
+
+        // The ranges holding every string whose record can differ once the memory in `changed`
+        // (ascending, disjoint) has been written: a record depends on the kLeadBytes before the string
+        // and on up to lookaheadBytes() from its start, so the ranges reach that far around each change.
+        [[nodiscard]] static std::vector<AddressRange> affectedRanges(
+            const std::vector<AddressRange> &changed,
+            const ScanOptions &options)
+        {
+            const std::uintptr_t before = lookaheadBytes(options);
+            const std::uintptr_t after = kLeadBytes;
+            const auto limit = (std::numeric_limits<std::uintptr_t>::max)();
 
-            if (!outgoing.empty())
+            std::vector<AddressRange> affected;
+            for (const AddressRange &range : changed)
             {
-                on_batch(std::move(outgoing));
+                const std::uintptr_t begin = range.begin > before ? range.begin - before : 0;
+                const std::uintptr_t end = range.end < limit - after ? range.end + after : limit;
+                if (!affected.empty() && affected.back().end >= begin)
+                {
+                    affected.back().end = (std::max)(affected.back().end, end);
+                    continue;
+                }
+                affected.push_back(AddressRange{begin, end});
             }
+            return affected;
         }
 
         [[nodiscard]] std::optional<StringEntry> find_first(const std::string &text, bool case_sensitive = false) const
@@ -229,122 +435,328 @@ namespace farcal::memory
         }
 
     private:
-        struct MemoryRegion
-        {
-            std::uintptr_t base = 0;
-            std::size_t size = 0;
-            std::uint32_t protection = 0;
-            std::uint32_t state = 0;
-        };
-
+        // Both classifiers are unsigned range compares without short-circuiting, as laneMask needs.
         [[nodiscard]] static bool isAsciiChar(std::uint8_t value)
         {
-            return value == 0x09 || (value >= 0x20 && value <= 0x7E);
+            return (value == 0x09) | (static_cast<std::uint8_t>(value - 0x20) <= 0x7E - 0x20);
         }
 
         [[nodiscard]] static bool isUtf16Unit(std::uint16_t value)
         {
-            if (value == 0x09)
+            return (value == 0x09) | (static_cast<std::uint16_t>(value - 0x20) <= 0x7E - 0x20) |
+                   (static_cast<std::uint16_t>(value - 0xA0) <= 0xD7FF - 0xA0) |
+                   (static_cast<std::uint16_t>(value - 0xE000) <= 0xFFFD - 0xE000);
+        }
+
+        [[nodiscard]] static bool isHighSurrogate(std::uint16_t value)
+        {
+            return (value & 0xFC00) == 0xD800;
+        }
+
+        [[nodiscard]] static bool isLowSurrogate(std::uint16_t value)
+        {
+            return (value & 0xFC00) == 0xDC00;
+        }
+
+        // Length of the printable UTF-8 character at p (with `available` bytes readable), 0 when
+        // there is none: a printable ASCII byte, or a well-formed multibyte sequence (no overlong
+        // forms, surrogates or values past U+10FFFF) that is not a C1 control or U+FFFE/U+FFFF.
+        [[nodiscard]] static std::size_t utf8CharLength(const std::uint8_t *p, std::size_t available)
+        {
+            const std::uint8_t lead = p[0];
+            if (lead < 0x80)
             {
-                return true;
+                return isAsciiChar(lead) ? 1 : 0;
             }
-            if (value >= 0x20 && value <= 0x7E)
+            if (lead < 0xC2 || lead > 0xF4)
             {
-                return true;
+                return 0;
             }
-            if (value >= 0xA0 && value <= 0xD7FF)
+
+            const auto continuation = [p](std::size_t k)
+            { return (p[k] & 0xC0) == 0x80; };
+            if (lead < 0xE0)
             {
-                return true;
+                if (available < 2 || !continuation(1) || (lead == 0xC2 && p[1] < 0xA0))
+                {
+                    return 0;
+                }
+                return 2;
             }
-            if (value >= 0xE000 && value <= 0xFFFD)
+            if (lead < 0xF0)
             {
-                return true;
+                if (available < 3 || !continuation(1) || !continuation(2))
+                {
+                    return 0;
+                }
+                if ((lead == 0xE0 && p[1] < 0xA0) || (lead == 0xED && p[1] >= 0xA0) ||
+                    (lead == 0xEF && p[1] == 0xBF && p[2] >= 0xBE))
+                {
+                    return 0;
+                }
+                return 3;
             }
-            return false;
+            if (available < 4 || !continuation(1) || !continuation(2) || !continuation(3))
+            {
+                return 0;
+            }
+            if ((lead == 0xF0 && p[1] < 0x90) || (lead == 0xF4 && p[1] >= 0x90))
+            {
+                return 0;
+            }
+            return 4;
         }
 
-        [[nodiscard]] static std::string toLower(std::string value)
+        static constexpr std::size_t kClassifyLanes = 64;
+
+        // Packs 64 flag bytes (0 or 1) into a mask, bit k for flags[k]. The multiply gathers the low
+        // bit of each of eight bytes into the top byte of the product.
+        [[nodiscard]] static std::uint64_t packFlags(const std::uint8_t *flags)
         {
-            std::transform(value.begin(), value.end(), value.begin(), [](unsigned char c)
-                           { return static_cast<char>(std::tolower(c)); });
-            return value;
+            std::uint64_t mask = 0;
+            for (std::size_t word = 0; word < kClassifyLanes / 8; ++word)
+            {
+                if constexpr (std::endian::native == std::endian::little)
+                {
+                    std::uint64_t bytes = 0;
+                    std::memcpy(&bytes, flags + word * 8, sizeof(bytes));
+                    mask |= ((bytes * 0x0102040810204080ull) >> 56) << (word * 8);
+                }
+                else
+                {
+                    for (std::size_t bit = 0; bit < 8; ++bit)
+                    {
+                        mask |= static_cast<std::uint64_t>(flags[word * 8 + bit]) << (word * 8 + bit);
+                    }
+                }
+            }
+            return mask;
         }
 
-        [[nodiscard]] static bool matchesFilter(const std::string &text, const ScanOptions &options)
+        // Mask of the lanes in [0, count), count <= 64, for which flag_of(lane) holds. flag_of must
+        // stay free of early exits and short-circuiting for the full-block loop to vectorize.
+        template <typename FlagOf>
+        [[nodiscard]] static std::uint64_t laneMask(std::size_t count, FlagOf &&flag_of)
         {
-            if (options.contains.empty())
+            std::uint8_t flags[kClassifyLanes];
+            if (count == kClassifyLanes)
             {
-                return true;
+                for (std::size_t i = 0; i < kClassifyLanes; ++i)
+                {
+                    flags[i] = static_cast<std::uint8_t>(flag_of(i));
+                }
+                return packFlags(flags);
             }
 
-            if (options.case_sensitive_filter)
+            std::memset(flags, 0, sizeof(flags));
+            for (std::size_t i = 0; i < count; ++i)
             {
-                return text.find(options.contains) != std::string::npos;
+                flags[i] = static_cast<std::uint8_t>(flag_of(i));
             }
+            return packFlags(flags);
+        }
 
-            const std::string lower_text = toLower(text);
-            const std::string lower_filter = toLower(options.contains);
-            return lower_text.find(lower_filter) != std::string::npos;
+        // Mask of the printable bytes among data[0, count).
+        [[nodiscard]] static std::uint64_t asciiMask(const std::uint8_t *data, std::size_t count)
+        {
+            return laneMask(count, [data](std::size_t i)
+                            { return isAsciiChar(data[i]); });
+        }
+
+        // Mask of the bytes that may be part of printable UTF-8 text: printable ASCII and every
+        // byte with the high bit set, to be validated run by run.
+        [[nodiscard]] static std::uint64_t utf8CandidateMask(const std::uint8_t *data, std::size_t count)
+        {
+            return laneMask(count, [data](std::size_t i)
+                            { return isAsciiChar(data[i]) | (data[i] >= 0x80); });
         }
 
-        static std::size_t scanAsciiBlock(
+        [[nodiscard]] static std::uint16_t unitAt(const std::uint8_t *units, std::ptrdiff_t index)
+        {
+            return static_cast<std::uint16_t>(units[index * 2] | (units[index * 2 + 1] << 8));
+        }
+
+        // Mask of the printable little-endian code units among the `count` at data. Surrogates count
+        // when they form a pair; has_before and has_after tell whether the units just before data
+        // and just past the block can be read, for pairs split across blocks.
+        [[nodiscard]] static std::uint64_t utf16Mask(const std::uint8_t *data, std::size_t count, bool has_before, bool has_after)
+        {
+            const std::uint64_t printable = laneMask(count, [data](std::size_t i)
+                                                     { return isUtf16Unit(unitAt(data, static_cast<std::ptrdiff_t>(i))); });
+            const std::uint64_t surrogates = laneMask(count, [data](std::size_t i)
+                                                      { return (unitAt(data, static_cast<std::ptrdiff_t>(i)) & 0xF800) == 0xD800; });
+            if (surrogates == 0)
+            {
+                return printable;
+            }
+
+            const std::uint64_t high = laneMask(count, [data](std::size_t i)
+                                                { return isHighSurrogate(unitAt(data, static_cast<std::ptrdiff_t>(i))); });
+            const std::uint64_t low = surrogates & ~high;
+            const std::uint64_t high_before = (has_before && isHighSurrogate(unitAt(data, -1))) ? 1 : 0;
+            const std::uint64_t low_after =
+                (has_after && isLowSurrogate(unitAt(data, static_cast<std::ptrdiff_t>(count)))) ? std::uint64_t{1} << (count - 1) : 0;
+            return printable | (high & ((low >> 1) | low_after)) | (low & ((high << 1) | high_before));
+        }
+
+        // Calls on_run(first, length) for every maximal run of printable lanes in [0, lanes), with
+        // `classify(first, count)` returning the mask of up to 64 lanes. Run edges are found with
+        // countr_zero on the mask and its complement, so lanes inside a run or between runs are
+        // never visited one by one. on_run returns false to stop.
+        template <typename Classify, typename OnRun>
+        static void forEachRun(std::size_t lanes, Classify &&classify, OnRun &&on_run)
+        {
+            constexpr std::size_t no_run = (std::numeric_limits<std::size_t>::max)();
+            std::size_t run_start = no_run;
+            for (std::size_t block = 0; block < lanes; block += kClassifyLanes)
+            {
+                const std::size_t count = (std::min)(kClassifyLanes, lanes - block);
+                const std::uint64_t mask = classify(block, count);
+                std::size_t lane = 0;
+                while (lane < count)
+                {
+                    // Lanes past `count` are clear in the mask, so a run always ends by then.
+                    const std::uint64_t rest = (run_start == no_run ? mask : ~mask) >> lane;
+                    if (rest == 0)
+                    {
+                        break;
+                    }
+                    lane += static_cast<std::size_t>(std::countr_zero(rest));
+                    if (run_start == no_run)
+                    {
+                        run_start = block + lane;
+                        continue;
+                    }
+                    if (!on_run(run_start, block + lane - run_start))
+                    {
+                        return;
+                    }
+                    run_start = no_run;
+                }
+            }
+            if (run_start != no_run)
+            {
+                on_run(run_start, lanes - run_start);
+            }
+        }
+
+        // The block scanners report the strings starting in data[owned_begin, owned_end). The bytes
+        // before owned_begin only tell whether a run continues from the previous chunk (its owner),
+        // the bytes after owned_end only let a run extend past the chunk.
+        //
+        // byte_starts receives the address of every ASCII or UTF-8 string found, ascending, and the
+        // UTF-16 scan of the same block skips those addresses: ASCII text read as UTF-16 looks like
+        // CJK.
+        static std::size_t scanByteBlock(
             std::uintptr_t block_base,
             const std::uint8_t *data,
             std::size_t size,
+            std::size_t owned_begin,
+            std::size_t owned_end,
             std::size_t min_length,
             std::size_t max_length,
-            const ScanOptions &options,
-            std::unordered_set<std::uintptr_t> &seen_addresses,
+            bool keep_ascii,
+            bool keep_utf8,
+            const StringFilter &filter,
             std::size_t max_to_add,
-            std::vector<StringEntry> &out)
+            std::vector<StringRecord> &out,
+            StringPool &pool,
+            std::vector<std::uintptr_t> &byte_starts)
         {
+            // Only runs that reach min_length are copied out of the buffer. Returns false to stop.
             std::size_t added = 0;
-            std::size_t i = 0;
-            while (i < size)
+            const auto emit = [&](std::size_t start, std::size_t text_bytes, Encoding encoding)
             {
-                if (!isAsciiChar(data[i]))
+                const std::uintptr_t address = block_base + start;
+                byte_starts.push_back(address);
+                if (!(encoding == Encoding::Ascii ? keep_ascii : keep_utf8))
                 {
-                    ++i;
-                    continue;
+                    return true;
                 }
 
-                const std::size_t start = i;
-                std::string text;
-                text.reserve((std::min)(max_length, std::size_t{256}));
-
-                while (i < size && isAsciiChar(data[i]))
+                const std::string_view text(reinterpret_cast<const char *>(data + start), text_bytes);
+                if (!filter.mayMatchRun(data + start, text.size(), 1) || !filter.matches(text))
                 {
-                    if (text.size() < max_length)
-                    {
-                        text.push_back(static_cast<char>(data[i]));
-                    }
-                    ++i;
+                    return true;
                 }
 
-                const std::size_t sequence_len = i - start;
-                if (sequence_len < min_length || text.empty())
-                {
-                    continue;
-                }
+                out.push_back(StringRecord{address, pool.append(text), static_cast<std::uint32_t>(text.size()), encoding});
+                ++added;
+                return max_to_add == 0 || added < max_to_add;
+            };
 
-                const std::uintptr_t address = block_base + start;
-                if (!seen_addresses.insert(address).second)
-                {
-                    continue;
-                }
-                if (!matchesFilter(text, options))
-                {
-                    continue;
-                }
+            if (!keep_utf8)
+            {
+                forEachRun(
+                    size,
+                    [data](std::size_t first, std::size_t count)
+                    { return asciiMask(data + first, count); },
+                    [&](std::size_t start, std::size_t length)
+                    {
+                        if (start >= owned_end)
+                        {
+                            return false;
+                        }
+                        if (start < owned_begin || length < min_length)
+                        {
+                            return true;
+                        }
+                        return emit(start, (std::min)(length, max_length), Encoding::Ascii);
+                    });
+                return added;
+            }
 
-                out.push_back(StringEntry{address, std::move(text), Encoding::Ascii});
-                ++added;
-                if (max_to_add > 0 && added >= max_to_add)
+            // Candidate runs are split into runs of well-formed characters. UTF-8 resynchronizes at
+            // the next non-continuation byte, and the lead bytes cover a whole sequence, so every
+            // chunk splits the runs it shares with its neighbours at the same places.
+            forEachRun(
+                size,
+                [data](std::size_t first, std::size_t count)
+                { return utf8CandidateMask(data + first, count); },
+                [&](std::size_t start, std::size_t length)
                 {
-                    return added;
-                }
-            }
+                    const std::size_t end = start + length;
+                    std::size_t i = start;
+                    while (i < end)
+                    {
+                        std::size_t char_bytes = utf8CharLength(data + i, end - i);
+                        if (char_bytes == 0)
+                        {
+                            ++i;
+                            continue;
+                        }
+
+                        const std::size_t run_start = i;
+                        std::size_t chars = 0;
+                        std::size_t text_end = i;
+                        bool multibyte = false;
+                        while (char_bytes != 0)
+                        {
+                            if (chars < max_length)
+                            {
+                                text_end = i + char_bytes;
+                                multibyte |= char_bytes > 1;
+                            }
+                            ++chars;
+                            i += char_bytes;
+                            char_bytes = i < end ? utf8CharLength(data + i, end - i) : 0;
+                        }
 
+                        if (run_start >= owned_end)
+                        {
+                            return false;
+                        }
+                        if (run_start < owned_begin || chars < min_length)
+                        {
+                            continue;
+                        }
+                        if (!emit(run_start, text_end - run_start, multibyte ? Encoding::Utf8 : Encoding::Ascii))
+                        {
+                            return false;
+                        }
+                    }
+                    return true;
+                });
             return added;
         }
 
@@ -352,343 +764,363 @@ namespace farcal::memory
             std::uintptr_t block_base,
             const std::uint8_t *data,
             std::size_t size,
+            std::size_t owned_begin,
+            std::size_t owned_end,
             std::size_t min_length,
             std::size_t max_length,
-            const ScanOptions &options,
-            std::unordered_set<std::uintptr_t> &seen_addresses,
+            const StringFilter &filter,
             std::size_t max_to_add,
-            std::vector<StringEntry> &out)
+            std::vector<StringRecord> &out,
+            StringPool &pool,
+            const std::vector<std::uintptr_t> &byte_starts)
         {
-            std::size_t added = 0;
-            std::size_t i = 0;
-            while (i + 1 < size)
+            // Code units sit at even addresses only.
+            const std::size_t first_unit = static_cast<std::size_t>(block_base & 1);
+            if (size < first_unit + 2)
             {
-                const std::uintptr_t absolute = block_base + i;
-                if ((absolute & 1) != 0)
-                {
-                    ++i;
-                    continue;
-                }
+                return 0;
+            }
+            const std::uint8_t *units = data + first_unit;
 
-                const std::uint16_t first =
-                    static_cast<std::uint16_t>(data[i]) | (static_cast<std::uint16_t>(data[i + 1]) << 8);
-                if (!isUtf16Unit(first))
+            const std::size_t unit_count = (size - first_unit) / 2;
+            std::size_t added = 0;
+            std::size_t next_byte_start = 0;
+            std::string text; // reused: the pool keeps the copies
+            forEachRun(
+                unit_count,
+                [units, unit_count](std::size_t first, std::size_t count)
+                { return utf16Mask(units + first * 2, count, first > 0, first + count < unit_count); },
+                [&](std::size_t start, std::size_t length)
                 {
-                    i += 2;
-                    continue;
-                }
+                    const std::size_t offset = first_unit + start * 2;
+                    if (offset >= owned_end)
+                    {
+                        return false;
+                    }
+                    if (offset < owned_begin || length < min_length)
+                    {
+                        return true;
+                    }
+
+                    const std::uintptr_t address = block_base + offset;
+                    while (next_byte_start < byte_starts.size() && byte_starts[next_byte_start] < address)
+                    {
+                        ++next_byte_start;
+                    }
+                    if (next_byte_start < byte_starts.size() && byte_starts[next_byte_start] == address)
+                    {
+                        return true;
+                    }
 
-                const std::size_t start = i;
-                std::u16string text_utf16;
-                text_utf16.reserve((std::min)(max_length, std::size_t{256}));
+                    // Cutting at max_length must not split a surrogate pair.
+                    std::size_t text_units = (std::min)(length, max_length);
+                    if (text_units < length && isHighSurrogate(unitAt(units, static_cast<std::ptrdiff_t>(start + text_units - 1))))
+                    {
+                        --text_units;
+                    }
+                    if (text_units == 0 || !filter.mayMatchRun(units + start * 2, text_units, 2))
+                    {
+                        return true;
+                    }
 
-                while (i + 1 < size)
+                    text.resize(text_units * 3);
+                    text.resize(encodeUtf8(units + start * 2, text_units, text.data()));
+                    if (!filter.matches(text))
+                    {
+                        return true;
+                    }
+
+                    out.push_back(StringRecord{address, pool.append(text), static_cast<std::uint32_t>(text.size()), Encoding::Utf16});
+                    ++added;
+                    return max_to_add == 0 || added < max_to_add;
+                });
+
+            return added;
+        }
+
+        // Writes `count` little-endian UTF-16 units at `units` to `out` as UTF-8 and returns the
+        // bytes written, at most 3 per unit. All-ASCII stretches are narrowed four units per 64-bit
+        // load; unpaired surrogates become U+FFFD.
+        static std::size_t encodeUtf8(const std::uint8_t *units, std::size_t count, char *out)
+        {
+            char *cursor = out;
+            std::size_t i = 0;
+            while (i < count)
+            {
+                if constexpr (std::endian::native == std::endian::little)
                 {
-                    const std::uint16_t value =
-                        static_cast<std::uint16_t>(data[i]) | (static_cast<std::uint16_t>(data[i + 1]) << 8);
-                    if (!isUtf16Unit(value))
+                    while (i + 4 <= count)
                     {
-                        break;
+                        std::uint64_t quad = 0;
+                        std::memcpy(&quad, units + i * 2, sizeof(quad));
+                        if ((quad & 0xFF80FF80FF80FF80ull) != 0)
+                        {
+                            break;
+                        }
+                        cursor[0] = static_cast<char>(quad);
+                        cursor[1] = static_cast<char>(quad >> 16);
+                        cursor[2] = static_cast<char>(quad >> 32);
+                        cursor[3] = static_cast<char>(quad >> 48);
+                        cursor += 4;
+                        i += 4;
                     }
-                    if (text_utf16.size() < max_length)
+                    if (i == count)
                     {
-                        text_utf16.push_back(static_cast<char16_t>(value));
+                        break;
                     }
-                    i += 2;
                 }
 
-                const std::size_t sequence_len = (i - start) / 2;
-                if (sequence_len < min_length || text_utf16.empty())
+                std::uint32_t code_point = unitAt(units, static_cast<std::ptrdiff_t>(i++));
+                if (isHighSurrogate(static_cast<std::uint16_t>(code_point)) && i < count &&
+                    isLowSurrogate(unitAt(units, static_cast<std::ptrdiff_t>(i))))
                 {
-                    continue;
+                    code_point = 0x10000 + ((code_point - 0xD800) << 10) + (unitAt(units, static_cast<std::ptrdiff_t>(i++)) - 0xDC00u);
                 }
-
-                std::string text = utf16ToUtf8(text_utf16);
-                if (text.empty())
+                else if (isHighSurrogate(static_cast<std::uint16_t>(code_point)) || isLowSurrogate(static_cast<std::uint16_t>(code_point)))
                 {
-                    continue;
+                    code_point = 0xFFFD;
                 }
 
-                const std::uintptr_t address = block_base + start;
-                if (!seen_addresses.insert(address).second)
+                if (code_point < 0x80)
                 {
-                    continue;
+                    *cursor++ = static_cast<char>(code_point);
                 }
-                if (!matchesFilter(text, options))
+                else if (code_point < 0x800)
                 {
-                    continue;
+                    *cursor++ = static_cast<char>(0xC0 | (code_point >> 6));
+                    *cursor++ = static_cast<char>(0x80 | (code_point & 0x3F));
                 }
-
-                out.push_back(StringEntry{address, std::move(text), Encoding::Utf16});
-                ++added;
-                if (max_to_add > 0 && added >= max_to_add)
+                else if (code_point < 0x10000)
+                {
+                    *cursor++ = static_cast<char>(0xE0 | (code_point >> 12));
+                    *cursor++ = static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+                    *cursor++ = static_cast<char>(0x80 | (code_point & 0x3F));
+                }
+                else
                 {
-                    return added;
+                    *cursor++ = static_cast<char>(0xF0 | (code_point >> 18));
+                    *cursor++ = static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+                    *cursor++ = static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+                    *cursor++ = static_cast<char>(0x80 | (code_point & 0x3F));
                 }
             }
-
-            return added;
+            return static_cast<std::size_t>(cursor - out);
         }
 
-        [[nodiscard]] static std::string utf16ToUtf8(const std::u16string &text)
-        {
-            if (text.empty())
-            {
-                return {};
-            }
+        // Bytes read before each chunk: enough to see whether a run continues from the previous
+        // chunk, including through a UTF-16 surrogate pair or a UTF-8 sequence of up to four bytes.
+        static constexpr std::size_t kLeadBytes = 4;
 
-#ifdef _WIN32
-            std::wstring wide;
-            wide.reserve(text.size());
-            for (const auto c : text)
-            {
-                wide.push_back(static_cast<wchar_t>(c));
-            }
+        // A chunk owns the strings starting in [base, base + size). It is read together with `lead`
+        // bytes before it, to tell a string start from the continuation of a run the previous chunk
+        // owns, and `lookahead` bytes after it, so its last strings can be read up to max_len. Only
+        // these few bytes are read twice, and the result does not depend on the chunk size.
+        struct Chunk
+        {
+            std::uintptr_t base = 0;
+            std::size_t size = 0;
+            std::size_t lead = 0;
+            std::size_t lookahead = 0;
+        };
 
-            const int required = ::WideCharToMultiByte(
-                CP_UTF8,
-                0,
-                wide.data(),
-                static_cast<int>(wide.size()),
-                nullptr,
-                0,
-                nullptr,
-                nullptr);
-            if (required <= 0)
+        // Appends the chunks of the regions a scan with `options` covers, clipped to [scan_start,
+        // scan_end). Lead and lookahead only stop at the region bounds, so a string near the edge of
+        // the range is read the same as by a scan of the whole region.
+        static void splitChunks(
+            const std::vector<MemoryRegion> &regions,
+            std::uintptr_t scan_start,
+            std::uintptr_t scan_end,
+            std::size_t chunk_size,
+            std::size_t lookahead,
+            const ScanOptions &options,
+            std::vector<Chunk> &chunks)
+        {
+            for (const auto &region : regions)
             {
-                return {};
-            }
+                if (!region.readable)
+                {
+                    continue;
+                }
+                if (!options.include_writable_regions && region.writable)
+                {
+                    continue;
+                }
 
-            std::string out(static_cast<std::size_t>(required), '\0');
-            const int written = ::WideCharToMultiByte(
-                CP_UTF8,
-                0,
-                wide.data(),
-                static_cast<int>(wide.size()),
-                out.data(),
-                required,
-                nullptr,
-                nullptr);
-            if (written <= 0)
-            {
-                return {};
-            }
-            return out;
-#else
-            std::string out;
-            out.reserve(text.size());
-            for (const auto c : text)
-            {
-                out.push_back(static_cast<char>(c & 0xFF));
+                const std::uintptr_t region_end = region.end();
+                const std::uintptr_t local_start = (std::max)(scan_start, region.base);
+                const std::uintptr_t local_end = (std::min)(scan_end, region_end);
+                for (std::uintptr_t cursor = local_start; cursor < local_end;)
+                {
+                    Chunk chunk{};
+                    chunk.base = cursor;
+                    chunk.size = static_cast<std::size_t>((std::min)(
+                        std::uint64_t(chunk_size),
+                        std::uint64_t(local_end - cursor)
+                    ));
+                    chunk.lead = static_cast<std::size_t>((std::min)(
+                        std::uint64_t(kLeadBytes),
+                        std::uint64_t(cursor - region.base)
+                    ));
+                    chunk.lookahead = static_cast<std::size_t>((std::min)(
+                        std::uint64_t(lookahead),
+                        std::uint64_t(region_end - cursor - chunk.size)
+                    ));
+                    chunks.push_back(chunk);
+                    cursor += static_cast<std::uintptr_t>(chunk.size);
+                }
             }
-            return out;
-#endif
         }
 
-        [[nodiscard]] static std::uintptr_t regionEnd(const MemoryRegion &region)
+        [[nodiscard]] static std::size_t minLength(const ScanOptions &options)
         {
-            const auto limit = (std::numeric_limits<std::uintptr_t>::max)();
-            if (region.base > limit - region.size)
-            {
-                return limit;
-            }
-            return region.base + static_cast<std::uintptr_t>(region.size);
+            return (std::max)(std::size_t{1}, options.min_length);
         }
 
-        [[nodiscard]] static bool isReadableProtection(std::uint32_t protection)
+        [[nodiscard]] static std::size_t maxLength(const ScanOptions &options)
         {
-#ifdef _WIN32
-            if ((protection & PAGE_GUARD) != 0 || (protection & PAGE_NOACCESS) != 0)
-            {
-                return false;
-            }
-            const std::uint32_t base = protection & 0xFF;
-            return base == PAGE_READONLY || base == PAGE_READWRITE || base == PAGE_WRITECOPY || base == PAGE_EXECUTE_READ || base == PAGE_EXECUTE_READWRITE || base == PAGE_EXECUTE_WRITECOPY;
-#else
-            (void)protection;
-            return false;
-#endif
+            return (std::max)(minLength(options), options.max_length == 0 ? std::size_t{512} : options.max_length);
         }
 
-        [[nodiscard]] static bool isWritableProtection(std::uint32_t protection)
+        // Bytes read past each chunk so a string starting near its end can still be read up to
+        // max_len characters of up to four UTF-8 bytes (or two UTF-16 units) each.
+        [[nodiscard]] static std::size_t lookaheadBytes(const ScanOptions &options)
         {
-#ifdef _WIN32
-            const std::uint32_t base = protection & 0xFF;
-            return base == PAGE_READWRITE || base == PAGE_WRITECOPY || base == PAGE_EXECUTE_READWRITE || base == PAGE_EXECUTE_WRITECOPY;
-#else
-            (void)protection;
-            return false;
-#endif
+            return maxLength(options) * 4 + 4;
         }
 
-        [[nodiscard]] std::vector<MemoryRegion> queryRegions() const
+        [[nodiscard]] static std::size_t workerCount(const ScanOptions &options, std::size_t chunk_count)
         {
-            std::vector<MemoryRegion> regions;
+            const std::size_t requested = options.worker_threads == 0
+                                              ? static_cast<std::size_t>((std::max)(1u, std::thread::hardware_concurrency()))
+                                              : options.worker_threads;
+            return (std::max)(std::size_t{1}, (std::min)(requested, chunk_count));
+        }
 
-#ifdef _WIN32
-            if (m_reader == nullptr || !m_reader->attached())
+        // Runs run() on worker_count threads, the calling one included.
+        template <typename Run>
+        static void runWorkers(std::size_t worker_count, const Run &run)
+        {
+            if (worker_count <= 1)
             {
-                return regions;
+                run();
+                return;
             }
 
-            const HANDLE process = m_reader->process().nativeHandle();
-            if (process == nullptr)
+            std::vector<std::future<void>> futures;
+            futures.reserve(worker_count - 1);
+            for (std::size_t worker_index = 1; worker_index < worker_count; ++worker_index)
             {
-                return regions;
+                futures.emplace_back(std::async(std::launch::async, run));
             }
-
-            SYSTEM_INFO system_info{};
-            ::GetSystemInfo(&system_info);
-            std::uintptr_t cursor = reinterpret_cast<std::uintptr_t>(system_info.lpMinimumApplicationAddress);
-            const std::uintptr_t max_address = reinterpret_cast<std::uintptr_t>(system_info.lpMaximumApplicationAddress);
-
-            while (cursor < max_address)
+            run();
+            for (auto &future : futures)
             {
-                MEMORY_BASIC_INFORMATION mbi{};
-                const SIZE_T queried = ::VirtualQueryEx(
-                    process,
-                    reinterpret_cast<LPCVOID>(cursor),
-                    &mbi,
-                    sizeof(mbi));
-                if (queried == 0)
-                {
-                    cursor += 0x1000;
-                    continue;
-                }
+                future.get();
+            }
+        }
 
-                MemoryRegion region{};
-                region.base = reinterpret_cast<std::uintptr_t>(mbi.BaseAddress);
-                region.size = static_cast<std::size_t>(mbi.RegionSize);
-                region.protection = static_cast<std::uint32_t>(mbi.Protect);
-                region.state = static_cast<std::uint32_t>(mbi.State);
+        static constexpr std::size_t kHashChunkSize = 256 * kPageSize;
 
-                const std::uintptr_t next = regionEnd(region);
-                if (next <= cursor)
-                {
-                    break;
-                }
-                cursor = next;
+        // Page hash: four independent multiply-rotate lanes over the 8-byte words (the xxHash64
+        // round), so hashing keeps up with reading; a tail shorter than a word is zero-padded.
+        [[nodiscard]] static std::uint64_t hashBytes(const std::uint8_t *data, std::size_t size)
+        {
+            constexpr std::uint64_t prime1 = 0x9E3779B185EBCA87ull;
+            constexpr std::uint64_t prime2 = 0xC2B2AE3D27D4EB4Full;
+            const auto round = [](std::uint64_t lane, std::uint64_t word)
+            { return std::rotl(lane + word * prime2, 31) * prime1; };
+            const auto word_at = [data, size](std::size_t offset)
+            {
+                std::uint64_t word = 0;
+                std::memcpy(&word, data + offset, (std::min)(sizeof(word), size - offset));
+                return word;
+            };
 
-                if (region.state == MEM_COMMIT && region.size > 0)
+            std::uint64_t lanes[4] = {prime1 + prime2, prime2, 0, 0 - prime1};
+            std::size_t offset = 0;
+            for (; offset + 32 <= size; offset += 32)
+            {
+                for (std::size_t lane = 0; lane < 4; ++lane)
                 {
-                    regions.push_back(region);
+                    std::uint64_t word = 0;
+                    std::memcpy(&word, data + offset + lane * 8, sizeof(word));
+                    lanes[lane] = round(lanes[lane], word);
                 }
             }
+            for (std::size_t lane = 0; offset < size; offset += 8, lane = (lane + 1) % 4)
+            {
+                lanes[lane] = round(lanes[lane], word_at(offset));
+            }
 
-            std::sort(regions.begin(), regions.end(), [](const MemoryRegion &a, const MemoryRegion &b)
-                      { return a.base < b.base; });
-#endif
-
-            return regions;
+            std::uint64_t hash = std::rotl(lanes[0], 1) + std::rotl(lanes[1], 7) + std::rotl(lanes[2], 12) +
+                                 std::rotl(lanes[3], 18) + size;
+            hash ^= hash >> 33;
+            hash *= prime2;
+            hash ^= hash >> 29;
+            return hash;
         }
 
-        [[nodiscard]] std::vector<StringEntry> scanRegionSubset(
-            const std::vector<MemoryRegion> &regions,
-            std::size_t start_index,
-            std::size_t stride,
-            std::uintptr_t scan_start,
-            std::uintptr_t scan_end,
+        // Scans one chunk into `out`; buffer must hold kLeadBytes + chunk size + lookahead bytes.
+        void scanChunk(
+            const Chunk &chunk,
             std::size_t min_len,
             std::size_t max_len,
-            std::size_t chunk_size,
-            std::size_t overlap,
-            const ScanOptions &options) const
+            const ScanOptions &options,
+            const StringFilter &filter,
+            std::vector<std::uint8_t> &buffer,
+            std::vector<std::uintptr_t> &byte_starts,
+            StringBatch &out) const
         {
-            std::vector<StringEntry> result;
-            const std::size_t reserve_hint = options.max_results == 0
-                                                 ? std::size_t{32768}
-                                                 : (std::min)(options.max_results, std::size_t{32768});
-            result.reserve((std::min)(reserve_hint, std::size_t{131072}));
-
-            std::vector<std::uint8_t> buffer;
-            buffer.resize(chunk_size);
-
-            std::unordered_set<std::uintptr_t> seen_addresses;
-            seen_addresses.reserve(reserve_hint * 2);
-
-            for (std::size_t region_index = start_index; region_index < regions.size(); region_index += stride)
+            const std::uintptr_t read_base = chunk.base - chunk.lead;
+            const std::size_t to_read = chunk.lead + chunk.size + chunk.lookahead;
+            // Unreadable pages come back zero-filled, which ends any run, so no string spans them.
+            if (!readChunk(*m_reader, read_base, buffer.data(), to_read))
             {
-                const auto &region = regions[region_index];
-                if (!isReadableProtection(region.protection))
-                {
-                    continue;
-                }
-                if (!options.include_writable_regions && isWritableProtection(region.protection))
-                {
-                    continue;
-                }
-
-                const std::uintptr_t region_end = regionEnd(region);
-                std::uintptr_t local_start = (std::max)(scan_start, region.base);
-                const std::uintptr_t local_end = (std::min)(scan_end, region_end);
-                if (local_start >= local_end)
-                {
-                    continue;
-                }
-
-                std::uintptr_t cursor = local_start;
-                while (cursor < local_end)
-                {
-                    const std::size_t to_read = static_cast<std::size_t>((std::min)(
-                        std::uint64_t(chunk_size),
-                        std::uint64_t(local_end - cursor)
-                    ));
-                    if (to_read == 0)
-                    {
-                        break;
-                    }
-
-                    if (!m_reader->readBytes(cursor, buffer.data(), to_read))
-                    {
-                        const std::uintptr_t step = (std::min)(std::uintptr_t{4096}, local_end - cursor);
-                        if (step == 0)
-                        {
-                            break;
-                        }
-                        cursor += step;
-                        continue;
-                    }
-
-                    if (options.scan_ascii)
-                    {
-                        scanAsciiBlock(
-                            cursor,
-                            buffer.data(),
-                            to_read,
-                            min_len,
-                            max_len,
-                            options,
-                            seen_addresses,
-                            0,
-                            result
-                        );
-                    }
-
-                    if (options.scan_utf16)
-                    {
-                        scanUtf16Block(
-                            cursor,
-                            buffer.data(),
-                            to_read,
-                            min_len,
-                            max_len,
-                            options,
-                            seen_addresses,
-                            0,
-                            result
-                        );
-                    }
+                return;
+            }
+            if (!filter.mayMatchBlock(buffer.data(), to_read))
+            {
+                return;
+            }
 
-                    const std::size_t step_size = to_read > overlap ? (to_read - overlap) : to_read;
-                    if (step_size == 0)
-                    {
-                        break;
-                    }
-                    cursor += static_cast<std::uintptr_t>(step_size);
-                }
+            byte_starts.clear();
+            if (options.scan_ascii || options.scan_utf8)
+            {
+                scanByteBlock(
+                    read_base,
+                    buffer.data(),
+                    to_read,
+                    chunk.lead,
+                    chunk.lead + chunk.size,
+                    min_len,
+                    max_len,
+                    options.scan_ascii,
+                    options.scan_utf8,
+                    filter,
+                    0,
+                    out.records,
+                    out.pool,
+                    byte_starts
+                );
             }
 
-            return result;
+            if (options.scan_utf16)
+            {
+                scanUtf16Block(
+                    read_base,
+                    buffer.data(),
+                    to_read,
+                    chunk.lead,
+                    chunk.lead + chunk.size,
+                    min_len,
+                    max_len,
+                    filter,
+                    0,
+                    out.records,
+                    out.pool,
+                    byte_starts
+                );
+            }
         }
 
         const MemoryReader *m_reader = nullptr;
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "farcal/memory/StringScanner.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace farcal::memory
+{
+
+    // Compact fingerprint of a string scan, for comparing it with a later scan of the same process:
+    // one entry per string holding its address, a hash of its encoding and text, and the index of
+    // the record it came from, sorted by address. Two snapshots are compared in a single merge; the
+    // records (and their pools) only have to be kept to show the text of what changed.
+    //
+    // A string is identified by its address, so text rewritten in place is Modified, while text
+    // that moved is Removed at the old address and Added at the new one. Scans cut short by
+    // max_results keep an arbitrary subset of the strings and differ by more than what changed.
+    class StringSnapshot
+    {
+    public:
+        enum class ChangeKind : std::uint8_t
+        {
+            Added,
+            Removed,
+            Modified
+        };
+
+        struct Change
+        {
+            ChangeKind kind = ChangeKind::Added;
+            std::uint32_t before_row = 0; // record in the earlier scan; unused for Added
+            std::uint32_t after_row = 0;  // record in the later scan; unused for Removed
+        };
+
+        // Snapshot of records[first, size()), rows still counting from the front of `records`; an
+        // incremental rescan snapshots only the records it appended.
+        [[nodiscard]] static StringSnapshot build(const std::vector<StringScanner::StringRecord> &records, std::size_t first = 0)
+        {
+            StringSnapshot snapshot;
+            snapshot.m_entries.reserve(records.size() - (std::min)(first, records.size()));
+            for (std::size_t row = first; row < records.size(); ++row)
+            {
+                snapshot.m_entries.push_back(
+                    Entry{records[row].address, hashRecord(records[row]), static_cast<std::uint32_t>(row)});
+            }
+
+            std::sort(snapshot.m_entries.begin(), snapshot.m_entries.end(), [](const Entry &a, const Entry &b)
+                      { return a.address != b.address ? a.address < b.address : a.row < b.row; });
+            return snapshot;
+        }
+
+        // What changed from `before` to `after`, ascending by address.
+        [[nodiscard]] static std::vector<Change> diff(const StringSnapshot &before, const StringSnapshot &after)
+        {
+            std::vector<Change> changes;
+            auto old_it = before.m_entries.begin();
+            auto new_it = after.m_entries.begin();
+            const auto old_end = before.m_entries.end();
+            const auto new_end = after.m_entries.end();
+            while (old_it != old_end || new_it != new_end)
+            {
+                if (new_it == new_end || (old_it != old_end && old_it->address < new_it->address))
+                {
+                    changes.push_back(Change{ChangeKind::Removed, old_it->row, 0});
+                    ++old_it;
+                }
+                else if (old_it == old_end || new_it->address < old_it->address)
+                {
+                    changes.push_back(Change{ChangeKind::Added, 0, new_it->row});
+                    ++new_it;
+                }
+                else
+                {
+                    if (old_it->hash != new_it->hash)
+                    {
+                        changes.push_back(Change{ChangeKind::Modified, old_it->row, new_it->row});
+                    }
+                    ++old_it;
+                    ++new_it;
+                }
+            }
+            return changes;
+        }
+
+        void clear() noexcept
+        {
+            m_entries.clear();
+        }
+
+        [[nodiscard]] bool empty() const noexcept
+        {
+            return m_entries.empty();
+        }
+
+        [[nodiscard]] std::size_t size() const noexcept
+        {
+            return m_entries.size();
+        }
+
+    private:
+        struct Entry
+        {
+            std::uintptr_t address = 0;
+            std::uint64_t hash = 0;
+            std::uint32_t row = 0;
+        };
+
+        // FNV-1a over the encoding and the text.
+        [[nodiscard]] static std::uint64_t hashRecord(const StringScanner::StringRecord &record)
+        {
+            std::uint64_t hash = 0xCBF29CE484222325ull;
+            hash = (hash ^ static_cast<std::uint8_t>(record.encoding)) * 0x100000001B3ull;
+            for (const char c : record.text())
+            {
+                hash = (hash ^ static_cast<std::uint8_t>(c)) * 0x100000001B3ull;
+            }
+            return hash;
+        }
+
+        std::vector<Entry> m_entries;
+    };
+
+} // namespace farcal::memory
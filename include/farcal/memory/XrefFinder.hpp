@@ -0,0 +1,232 @@
+#pragma once
+
+#include "farcal/memory/AddressMatcher.hpp"
+#include "farcal/memory/ChunkScan.hpp"
+#include "farcal/memory/MemoryReader.hpp"
+#include "farcal/memory/MemoryRegions.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace farcal::memory {
+
+// Finds what refers to a set of addresses (e.g. strings from StringScanner), all targets in one
+// pass over the process: pointer-aligned slots in readable memory holding a target, and in the
+// executable memory of 64-bit processes RIP-relative `lea`/`mov` instructions (8D or 8B with a
+// [rip+disp32] operand, optionally REX-prefixed) whose displacement resolves to one.
+//
+// Code is not disassembled, so the instruction pattern is matched at every byte; a hit needs the
+// displacement to land exactly on a target, which random bytes almost never do.
+class XrefFinder {
+ public:
+  enum class Kind : std::uint8_t {
+    Pointer,
+    Code,
+  };
+
+  struct Reference {
+    std::uintptr_t address = 0;  // the pointer slot, or the first byte of the instruction
+    std::uintptr_t target  = 0;
+    Kind           kind    = Kind::Pointer;
+  };
+
+  struct ScanOptions {
+    std::size_t max_results    = 0;
+    std::size_t worker_threads = 0;
+    std::size_t batch_size     = 4096;
+    bool        scan_pointers  = true;
+    bool        scan_code      = true;
+    // Deliver results ordered by target, then by address, so the references to one target arrive
+    // together. Batches are then held back until the scan completes, and max_results keeps the
+    // first references in that order.
+    bool        group_by_target = true;
+  };
+
+  explicit XrefFinder(const MemoryReader* reader = nullptr) : m_reader(reader) {}
+
+  void setReader(const MemoryReader* reader) { m_reader = reader; }
+
+  std::vector<Reference> find_all(const std::vector<std::uintptr_t>& targets) const {
+    return find_all(targets, ScanOptions{});
+  }
+
+  std::vector<Reference> find_all(const std::vector<std::uintptr_t>& targets,
+                                  const ScanOptions&                 options) const {
+    std::vector<Reference> results;
+    find_all_batched(targets, options, [&results](std::vector<Reference>&& batch) {
+      results.insert(results.end(), batch.begin(), batch.end());
+    });
+    return results;
+  }
+
+  // Streams references to `on_batch(std::vector<Reference>&&)`. Batches come from worker threads,
+  // one call at a time.
+  template <typename BatchCallback>
+  void find_all_batched(const std::vector<std::uintptr_t>& targets,
+                        const ScanOptions&                 options,
+                        BatchCallback&&                    on_batch) const {
+    if (m_reader == nullptr || !m_reader->attached() || targets.empty()) {
+      return;
+    }
+
+    std::vector<std::uintptr_t> sorted_targets = targets;
+    std::sort(sorted_targets.begin(), sorted_targets.end());
+    sorted_targets.erase(std::unique(sorted_targets.begin(), sorted_targets.end()), sorted_targets.end());
+    const AddressMatcher matcher(sorted_targets);
+
+    // RIP-relative addressing only exists in 64-bit code.
+    const bool scan_code = options.scan_code && sizeof(std::uintptr_t) == 8;
+
+    std::vector<Chunk> chunks;
+    for (const auto& region : queryMemoryRegions(*m_reader)) {
+      if (region.readable && (options.scan_pointers || (scan_code && region.executable))) {
+        appendChunks(chunks, region);
+      }
+    }
+    if (chunks.empty()) {
+      return;
+    }
+
+    ChunkScanOptions scan_options;
+    scan_options.max_results    = options.max_results;
+    scan_options.worker_threads = options.worker_threads;
+    scan_options.batch_size     = options.batch_size;
+    scan_options.buffer_size    = kCodeLead + kChunkSize + kCodeTail;
+    scan_options.ordered        = options.group_by_target;
+
+    const auto by_target = [](const Reference& a, const Reference& b) {
+      return a.target != b.target ? a.target < b.target : a.address < b.address;
+    };
+    const auto scan_chunk = [&](std::size_t index, std::vector<std::uint8_t>& buffer, auto& emit) {
+      const Chunk& chunk = chunks[index];
+      const auto   keep  = [&emit](std::uintptr_t address, std::uintptr_t target, Kind kind) {
+        return emit(Reference{address, target, kind});
+      };
+
+      // The chunk itself sits at kCodeLead in the buffer, with its lead and tail bytes around it.
+      const std::uintptr_t read_base = chunk.base - chunk.lead;
+      const std::size_t    read_size = chunk.lead + chunk.size + chunk.tail;
+      std::uint8_t*        data      = buffer.data() + kCodeLead;
+      data[-1]                       = 0;
+      // Unreadable pages come back zero-filled and so never match.
+      if (!readChunk(*m_reader, read_base, data - chunk.lead, read_size)) {
+        return true;
+      }
+
+      return (!options.scan_pointers || scanPointers(chunk, data, matcher, keep))
+             && (!scan_code || !chunk.executable || scanCode(chunk, data, matcher, keep));
+    };
+
+    runChunkScan<Reference>(chunks.size(), scan_options, by_target, scan_chunk, on_batch);
+  }
+
+ private:
+  // Chunks of a region are whole pages, so they never split a pointer slot. An instruction can
+  // straddle two chunks, so executable chunks also read the byte before them (a REX prefix) and
+  // the bytes after them that complete an instruction starting in the chunk.
+  struct Chunk {
+    std::uintptr_t base       = 0;
+    std::size_t    size       = 0;
+    std::size_t    lead       = 0;
+    std::size_t    tail       = 0;
+    bool           executable = false;
+  };
+
+  static constexpr std::size_t kChunkSize = 1024 * 1024;
+  // opcode, ModRM and disp32 follow the first byte a match is reported at.
+  static constexpr std::size_t kInstructionSize = 6;
+  static constexpr std::size_t kCodeLead        = 1;
+  static constexpr std::size_t kCodeTail        = kInstructionSize - 1;
+
+  static void appendChunks(std::vector<Chunk>& chunks, const MemoryRegion& region) {
+    for (std::size_t offset = 0; offset < region.size; offset += kChunkSize) {
+      Chunk chunk;
+      chunk.base       = region.base + static_cast<std::uintptr_t>(offset);
+      chunk.size       = (std::min)(kChunkSize, region.size - offset);
+      chunk.executable = region.executable;
+      if (region.executable) {
+        chunk.lead = offset == 0 ? 0 : kCodeLead;
+        chunk.tail = (std::min)(kCodeTail, region.size - offset - chunk.size);
+      }
+      chunks.push_back(chunk);
+    }
+  }
+
+  template <typename Keep>
+  static bool scanPointers(const Chunk& chunk, const std::uint8_t* data, const AddressMatcher& matcher, Keep& keep) {
+    const std::size_t slot_count = chunk.size / sizeof(std::uintptr_t);
+    for (std::size_t block = 0; block < slot_count; block += AddressMatcher::kBlockSlots) {
+      const std::size_t   block_slots = (std::min)(AddressMatcher::kBlockSlots, slot_count - block);
+      const std::uint8_t* slots       = data + block * sizeof(std::uintptr_t);
+      std::uint64_t       mask        = matcher.match(slots, block_slots);
+
+      while (mask != 0) {
+        const std::size_t slot = static_cast<std::size_t>(std::countr_zero(mask));
+        mask &= mask - 1;
+
+        std::uintptr_t target = 0;
+        std::memcpy(&target, slots + slot * sizeof(std::uintptr_t), sizeof(target));
+        if (!keep(chunk.base + static_cast<std::uintptr_t>((block + slot) * sizeof(std::uintptr_t)),
+                  target,
+                  Kind::Pointer)) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  // Finds `8D|8B modrm disp32` with a [rip+disp32] ModRM (mod 00, r/m 101) starting at each byte
+  // of the chunk. Blocks of 64 positions are classified at once; only the rare candidates have
+  // their displacement resolved and looked up.
+  template <typename Keep>
+  static bool scanCode(const Chunk& chunk, const std::uint8_t* data, const AddressMatcher& matcher, Keep& keep) {
+    const std::size_t available = chunk.size + chunk.tail;
+    if (available < kInstructionSize) {
+      return true;
+    }
+    const std::size_t positions = (std::min)(chunk.size, available - kInstructionSize + 1);
+
+    for (std::size_t block = 0; block < positions; block += 64) {
+      const std::size_t   count = (std::min)(std::size_t{64}, positions - block);
+      const std::uint8_t* bytes = data + block;
+      std::uint64_t       mask  = 0;
+      // Bitwise operators rather than && and ||, so the loop stays branch-free and vectorizes.
+      for (std::size_t j = 0; j < count; ++j) {
+        const bool candidate = ((bytes[j] == 0x8D) | (bytes[j] == 0x8B)) & ((bytes[j + 1] & 0xC7) == 0x05);
+        mask |= std::uint64_t{candidate} << j;
+      }
+
+      while (mask != 0) {
+        const std::size_t position = block + static_cast<std::size_t>(std::countr_zero(mask));
+        mask &= mask - 1;
+
+        std::int32_t displacement = 0;
+        std::memcpy(&displacement, data + position + 2, sizeof(displacement));
+        const std::uintptr_t next   = chunk.base + static_cast<std::uintptr_t>(position + kInstructionSize);
+        const std::uintptr_t target = next + static_cast<std::uintptr_t>(static_cast<std::intptr_t>(displacement));
+        if (!matcher.contains(target)) {
+          continue;
+        }
+
+        // Report the REX prefix as the start when there is one. data[-1] is the lead byte, or
+        // zero at the start of a region.
+        const std::uint8_t   prefix  = data[static_cast<std::ptrdiff_t>(position) - 1];
+        const bool           has_rex = (prefix & 0xF0) == 0x40;
+        const std::uintptr_t address = chunk.base + static_cast<std::uintptr_t>(position) - (has_rex ? 1 : 0);
+        if (!keep(address, target, Kind::Code)) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  const MemoryReader* m_reader = nullptr;
+};
+
+}  // namespace farcal::memory
@@ -13,6 +13,8 @@
 #include <cstdint>
 #include <memory>
 #include <optional>
+#include <span>
+#include <stop_token>
 #include <utility>
 #include <vector>
 
@@ -73,13 +75,20 @@ class MainWindow final : public QMainWindow {
   void     onNextScanClicked();
   void     onUndoScanClicked();
   void     onNewScanClicked();
-  void     onScanFinished(bool success, const QString& errorMessage);
-  void     updateScanProgress(std::size_t completed, std::size_t total);
+  void     onCancelScanClicked();
+  void     onScanFinished(bool success, bool cancelled, const QString& errorMessage);
+  void     saveScanSession();
+  void     loadScanSession();
+  void     restoreLastScanSession();
+  void     exportCompactScanResults();
+  void     updateScanProgress(const memory::ScanProgress& progress);
+  void     appendScanResultRows(const memory::ScanResultSet& batch);
   void     setScanUiBusy(bool busy);
   void     refreshScanResults();
   void     updateScanToggleState();
   memory::ScanSettings buildScanSettings() const;
-  QString              formatScanValue(const std::vector<std::uint8_t>& bytes) const;
+  QString              formatScanValue(std::span<const std::uint8_t> bytes,
+                                       const memory::ScanSettings&   settings) const;
   void     onScanResultsContextMenu(const QPoint& pos);
   void     onAddressListContextMenu(const QPoint& pos);
   void     addAddressListEntry(std::uintptr_t address, const QString& type, const QString& value);
@@ -96,6 +105,7 @@ class MainWindow final : public QMainWindow {
   QString  readLiveValueForAddress(std::uintptr_t address, const QString& typeName, bool hexMode) const;
   QString  readLiveValueForScanRow(std::uintptr_t address, int row) const;
   QString  lastProcessFilePath() const;
+  QString  lastScanSessionFilePath() const;
   void     persistLastAttachedProcess(std::uint32_t processId, const QString& processName) const;
   std::optional<std::pair<std::uint32_t, QString>> loadLastAttachedProcess() const;
   std::optional<std::uint32_t> findRunningProcessIdByName(const QString& processName) const;
@@ -146,7 +156,9 @@ class MainWindow final : public QMainWindow {
   QPushButton* m_nextScanButton = nullptr;
   QPushButton* m_undoScanButton = nullptr;
   QPushButton* m_newScanButton = nullptr;
+  QPushButton* m_cancelScanButton = nullptr;
   QProgressBar* m_scanProgressBar = nullptr;
+  QLabel* m_scanRateLabel = nullptr;
   QLabel* m_foundLabel = nullptr;
   QTableWidget* m_scanResultsTable = nullptr;
   QTableWidget* m_addressListTable = nullptr;
@@ -155,6 +167,8 @@ class MainWindow final : public QMainWindow {
   QTimer* m_liveUpdateTimer = nullptr;
   QTimer* m_loopWriteTimer = nullptr;
   bool m_scanBusy = false;
+  std::stop_source m_scanStopSource;
+  memory::ScanSettings m_activeScanSettings{};
   std::uint32_t m_addressListNameSeed = 1;
   int m_addressListDragAnchorRow = -1;
   std::uint64_t m_nextLoopWriteEntryId = 1;
@@ -6,7 +6,9 @@
 #include <QString>
 
 #include <cstdint>
+#include <functional>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 class QLabel;
@@ -27,6 +29,14 @@ public:
 
     void setAttachedProcess(std::uint32_t processId, const QString& processName);
 
+    // Called on the UI thread with the complete result of every finished scan.
+    using ScanFinishedHandler =
+        std::function<void(std::uint32_t processId, const std::vector<memory::RttiScanner::TypeInfo>& types)>;
+    void setScanFinishedHandler(ScanFinishedHandler handler);
+
+    std::uint32_t processId() const { return m_processId; }
+    const std::vector<memory::RttiScanner::TypeInfo>& entries() const { return m_entries; }
+
     static QString formatAddress(std::uintptr_t address);
 
 private:
@@ -34,7 +44,9 @@ private:
     void configureWindow();
     QWidget* buildCentralArea();
     void refreshScan();
+    void findInstances(const memory::RttiScanner::TypeInfo& entry, bool includeSubclasses);
     void appendScanBatch(std::uint64_t generation, std::vector<memory::RttiScanner::TypeInfo>&& batch);
+    void applyVftableBatch(std::uint64_t generation, std::vector<memory::RttiScanner::VftableUpdate>&& batch);
     void onScanFinished(std::uint64_t generation);
     void applyFilter(const QString& query);
     void updateWindowState();
@@ -43,6 +55,7 @@ private:
     QString m_processName;
 
     std::vector<memory::RttiScanner::TypeInfo> m_entries;
+    std::unordered_map<std::uintptr_t, std::size_t> m_entryIndex; // type descriptor -> m_entries index
     std::vector<int> m_filteredRows;
 
     QLineEdit* m_filterInput = nullptr;
@@ -55,6 +68,8 @@ private:
     bool m_scanInProgress = false;
     bool m_rescanPending = false;
     std::uint64_t m_scanGeneration = 0;
+    QThread* m_instanceThread = nullptr;
+    ScanFinishedHandler m_scanFinishedHandler;
 };
 
 } // namespace farcal::ui
@@ -1,13 +1,19 @@
 #pragma once
 
+#include "farcal/memory/StringIndex.hpp"
+#include "farcal/memory/StringPool.hpp"
 #include "farcal/memory/StringScanner.hpp"
+#include "farcal/memory/StringSnapshot.hpp"
 
 #include <QMainWindow>
 #include <QString>
 
 #include <cstdint>
+#include <memory>
+#include <string>
 #include <vector>
 
+class QCheckBox;
 class QLabel;
 class QLineEdit;
 class QPushButton;
@@ -31,19 +37,50 @@ private:
     void configureWindow();
     QWidget* buildCentralArea();
     void refreshScan();
-    void appendScanBatch(std::uint64_t generation, std::vector<memory::StringScanner::StringEntry>&& batch);
+    void appendScanBatch(std::uint64_t generation,
+                         memory::StringScanner::StringBatch&& batch,
+                         memory::StringIndex::Segment&& segment);
+    void beginIncrementalScan(std::uint64_t generation,
+                              const std::vector<memory::StringScanner::AddressRange>& ranges);
     void onScanFinished(std::uint64_t generation);
     void applyFilter(const QString& query);
+    void setShowChanges(bool enabled);
+    void clearSnapshots();
+    void resetTableModel();
+    const memory::StringScanner::StringRecord* recordAtRow(int viewRow) const;
+    void findReferences(const std::vector<const memory::StringScanner::StringRecord*>& records);
+    std::size_t liveEntryCount() const;
     void updateWindowState();
 
     std::uint32_t m_processId = 0;
     QString m_processName;
 
-    std::vector<memory::StringScanner::StringEntry> m_entries;
+    // Rows an incremental rescan replaced stay in m_entries, erased from m_index, until the next
+    // full scan.
+    std::vector<memory::StringScanner::StringRecord> m_entries;
+    memory::StringPool m_pool; // owns the text of m_entries
+    memory::StringIndex m_index; // trigrams of m_entries, same numbering
     std::vector<int> m_filteredRows;
+    std::string m_activeQuery; // folded query m_filteredRows currently matches
+
+    // The previous complete scan of the same process, and what changed since. While changes are
+    // shown, m_filteredRows indexes m_changes instead of m_entries. After an incremental rescan the
+    // baseline holds only the strings it replaced, their text still in m_pool.
+    std::vector<memory::StringScanner::StringRecord> m_baselineEntries;
+    memory::StringPool m_baselinePool;
+    bool m_hasBaseline = false;
+    std::uint32_t m_scannedProcessId = 0; // 0 while m_entries is not a complete scan
+    std::uint32_t m_scanProcessId = 0;
+    std::size_t m_firstScannedRow = 0; // first row of m_entries the running scan appended
+    // Page hashes of the scanned process as of the start of the last scan, which finds the pages
+    // the next one has to look at again. Only the scan thread uses them while a scan runs.
+    std::shared_ptr<memory::StringScanner::PageHashes> m_pageHashes;
+    std::vector<memory::StringSnapshot::Change> m_changes;
+    bool m_showChanges = false;
 
     QLineEdit* m_filterInput = nullptr;
     QPushButton* m_refreshButton = nullptr;
+    QCheckBox* m_changesCheckBox = nullptr;
     QLabel* m_statusLabel = nullptr;
     QTableView* m_table = nullptr;
     StringsTableModel* m_tableModel = nullptr;
@@ -52,6 +89,8 @@ private:
     bool m_scanInProgress = false;
     bool m_rescanPending = false;
     std::uint64_t m_scanGeneration = 0;
+
+    QThread* m_xrefThread = nullptr;
 };
 
 } // namespace farcal::ui
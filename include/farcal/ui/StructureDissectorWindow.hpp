@@ -1,6 +1,8 @@
 #pragma once
 
+#include "farcal/memory/ClassHierarchy.hpp"
 #include "farcal/memory/MemoryReader.hpp"
+#include "farcal/memory/RttiLookup.hpp"
 #include "farcal/memory/RttiScanner.hpp"
 
 #include <QMainWindow>
@@ -8,8 +10,11 @@
 #include <QString>
 
 #include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 class QLabel;
@@ -32,6 +37,8 @@ namespace farcal::ui
 
         void setAttachedProcess(std::uint32_t processId, const QString &processName);
         void focusAddress(std::uintptr_t address);
+        // Seeds RTTI annotation with a completed RTTI scan of the same process.
+        void setKnownRttiTypes(std::uint32_t processId, const std::vector<memory::RttiScanner::TypeInfo> &types);
 
     private:
         struct RowDisplay
@@ -39,6 +46,7 @@ namespace farcal::ui
             int row = 0;
             QString address;
             QString rtti;
+            QString rttiBases;
             QString offset;
             QString byteValue;
             QString dwordValue;
@@ -48,6 +56,14 @@ namespace farcal::ui
             bool isPointer = false;
         };
 
+        // Inheritance of the known RTTI types, for the base chain shown on a resolved type. It is
+        // extracted by the first fill after setKnownRttiTypes, off the UI thread.
+        struct KnownHierarchy
+        {
+            memory::ClassHierarchy hierarchy;
+            std::unordered_map<std::string, std::size_t> byName;
+        };
+
         void applyTheme();
         void configureWindow();
         void createMenuBar();
@@ -69,9 +85,16 @@ namespace farcal::ui
         void onFillFinished(std::uint64_t generation, const QString &finalStatus);
         void updateWindowState();
         static QString formatAddress(std::uintptr_t address);
+        static std::shared_ptr<const KnownHierarchy> buildKnownHierarchy(
+            const memory::RttiScanner &scanner,
+            const std::vector<memory::RttiScanner::TypeInfo> &types);
+        static QString baseChainOf(const KnownHierarchy &known, const QString &rtti);
 
         std::unique_ptr<memory::MemoryReader> m_memoryReader;
         std::unique_ptr<memory::RttiScanner> m_rttiScanner;
+        std::unique_ptr<memory::RttiLookup> m_rttiLookup;
+        std::shared_ptr<const std::vector<memory::RttiScanner::TypeInfo>> m_knownRttiTypes;
+        std::shared_ptr<const KnownHierarchy> m_knownHierarchy;
         std::uint32_t m_processId = 0;
         QString m_processName;
 
@@ -0,0 +1,675 @@
+// farcal_bench: starts farcal_bench_target, attaches to it and times the scanners against its
+// known heaps. Results are written as one JSON document so runs can be tracked over time.
+
+#include "SyntheticTargetLayout.hpp"
+
+#include "farcal/memory/MemoryReader.hpp"
+#include "farcal/memory/MemoryRegions.hpp"
+#include "farcal/memory/ProcessMemoryScanner.hpp"
+#include "farcal/memory/RttiScanner.hpp"
+#include "farcal/memory/StringScanner.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#  ifndef WIN32_LEAN_AND_MEAN
+#    define WIN32_LEAN_AND_MEAN
+#  endif
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  include <windows.h>
+#else
+#  include <csignal>
+#  include <sys/wait.h>
+#  include <unistd.h>
+#endif
+
+#ifndef FARCAL_BENCH_TARGET_PATH
+#  define FARCAL_BENCH_TARGET_PATH "farcal_bench_target"
+#endif
+
+namespace farcal::bench {
+namespace {
+
+constexpr std::string_view kUsage =
+    "usage: farcal_bench [options]\n"
+    "  --target <path>        synthetic target executable (default: the one built alongside)\n"
+    "  --value-mib <n>        numeric heap size in MiB, split across six types (default 256)\n"
+    "  --strings <n>          strings in the target (default 200000)\n"
+    "  --nodes <n>            pointer graph nodes (default 200000)\n"
+    "  --objects <n>          polymorphic objects (default 100000)\n"
+    "  --threads <list>       comma-separated worker counts (default 1,2,4,... up to the core count)\n"
+    "  --types <list>         value types for scan runs (default int8,int16,int32,int64,float,double)\n"
+    "  --repeat <n>           runs per measurement; the median is reported (default 3)\n"
+    "  --output <file>        write the JSON report to a file instead of stdout\n";
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+  std::string              targetPath  = FARCAL_BENCH_TARGET_PATH;
+  std::size_t              valueMiB    = 256;
+  std::size_t              stringCount = 200000;
+  std::size_t              nodeCount   = 200000;
+  std::size_t              objectCount = 100000;
+  std::vector<std::size_t> threadCounts;
+  std::vector<std::string> valueTypes = {"int8", "int16", "int32", "int64", "float", "double"};
+  std::size_t              repeat     = 3;
+  std::string              outputPath;
+};
+
+// Runs the target with its stdin/stdout connected to pipes. Commands are single lines and every
+// command is acknowledged with one line, which keeps the protocol trivially synchronous.
+class TargetProcess final {
+ public:
+  TargetProcess() = default;
+  TargetProcess(const TargetProcess&)            = delete;
+  TargetProcess& operator=(const TargetProcess&) = delete;
+  ~TargetProcess() { stop(); }
+
+  bool start(const std::string& path, const std::vector<std::string>& arguments) {
+#ifdef _WIN32
+    SECURITY_ATTRIBUTES security{};
+    security.nLength        = sizeof(security);
+    security.bInheritHandle = TRUE;
+
+    HANDLE childStdinRead   = nullptr;
+    HANDLE childStdoutWrite = nullptr;
+    if (!::CreatePipe(&childStdinRead, &m_stdinWrite, &security, 0)
+        || !::CreatePipe(&m_stdoutRead, &childStdoutWrite, &security, 0)) {
+      return false;
+    }
+    ::SetHandleInformation(m_stdinWrite, HANDLE_FLAG_INHERIT, 0);
+    ::SetHandleInformation(m_stdoutRead, HANDLE_FLAG_INHERIT, 0);
+
+    std::string commandLine = "\"" + path + "\"";
+    for (const std::string& argument : arguments) {
+      commandLine += " " + argument;
+    }
+
+    STARTUPINFOA startup{};
+    startup.cb         = sizeof(startup);
+    startup.dwFlags    = STARTF_USESTDHANDLES;
+    startup.hStdInput  = childStdinRead;
+    startup.hStdOutput = childStdoutWrite;
+    startup.hStdError  = ::GetStdHandle(STD_ERROR_HANDLE);
+
+    PROCESS_INFORMATION info{};
+    const BOOL created = ::CreateProcessA(
+        nullptr, commandLine.data(), nullptr, nullptr, TRUE, 0, nullptr, nullptr, &startup, &info);
+    ::CloseHandle(childStdinRead);
+    ::CloseHandle(childStdoutWrite);
+    if (created == FALSE) {
+      return false;
+    }
+    ::CloseHandle(info.hThread);
+    m_process = info.hProcess;
+    return true;
+#else
+    int toChild[2]   = {-1, -1};
+    int fromChild[2] = {-1, -1};
+    if (::pipe(toChild) != 0 || ::pipe(fromChild) != 0) {
+      return false;
+    }
+
+    const pid_t pid = ::fork();
+    if (pid < 0) {
+      return false;
+    }
+    if (pid == 0) {
+      ::dup2(toChild[0], STDIN_FILENO);
+      ::dup2(fromChild[1], STDOUT_FILENO);
+      ::close(toChild[0]);
+      ::close(toChild[1]);
+      ::close(fromChild[0]);
+      ::close(fromChild[1]);
+
+      std::vector<char*> argv;
+      argv.push_back(const_cast<char*>(path.c_str()));
+      for (const std::string& argument : arguments) {
+        argv.push_back(const_cast<char*>(argument.c_str()));
+      }
+      argv.push_back(nullptr);
+      ::execv(path.c_str(), argv.data());
+      ::_exit(127);
+    }
+
+    ::close(toChild[0]);
+    ::close(fromChild[1]);
+    m_pid      = pid;
+    m_stdinFd  = toChild[1];
+    m_stdoutFd = fromChild[0];
+    return true;
+#endif
+  }
+
+  bool send(std::string_view command) {
+    const std::string line = std::string(command) + "\n";
+#ifdef _WIN32
+    DWORD written = 0;
+    return ::WriteFile(m_stdinWrite, line.data(), static_cast<DWORD>(line.size()), &written, nullptr) != FALSE
+           && written == line.size();
+#else
+    return ::write(m_stdinFd, line.data(), line.size()) == static_cast<ssize_t>(line.size());
+#endif
+  }
+
+  std::optional<std::string> readLine() {
+    std::string line;
+    char        ch = 0;
+    while (true) {
+#ifdef _WIN32
+      DWORD read = 0;
+      if (::ReadFile(m_stdoutRead, &ch, 1, &read, nullptr) == FALSE || read == 0) {
+        return std::nullopt;
+      }
+#else
+      if (::read(m_stdoutFd, &ch, 1) != 1) {
+        return std::nullopt;
+      }
+#endif
+      if (ch == '\n') {
+        return line;
+      }
+      if (ch != '\r') {
+        line.push_back(ch);
+      }
+    }
+  }
+
+  void stop() {
+#ifdef _WIN32
+    if (m_process != nullptr) {
+      send("quit");
+      if (::WaitForSingleObject(m_process, 5000) != WAIT_OBJECT_0) {
+        ::TerminateProcess(m_process, 1);
+      }
+      ::CloseHandle(m_process);
+      m_process = nullptr;
+    }
+    for (HANDLE* handle : {&m_stdinWrite, &m_stdoutRead}) {
+      if (*handle != nullptr) {
+        ::CloseHandle(*handle);
+        *handle = nullptr;
+      }
+    }
+#else
+    if (m_pid > 0) {
+      send("quit");
+      ::close(m_stdinFd);
+      int status = 0;
+      if (::waitpid(m_pid, &status, 0) != m_pid) {
+        ::kill(m_pid, SIGKILL);
+      }
+      m_pid = -1;
+    }
+    if (m_stdoutFd >= 0) {
+      ::close(m_stdoutFd);
+      m_stdoutFd = -1;
+    }
+#endif
+  }
+
+ private:
+#ifdef _WIN32
+  HANDLE m_process    = nullptr;
+  HANDLE m_stdinWrite = nullptr;
+  HANDLE m_stdoutRead = nullptr;
+#else
+  pid_t m_pid      = -1;
+  int   m_stdinFd  = -1;
+  int   m_stdoutFd = -1;
+#endif
+};
+
+// Minimal streaming JSON writer; keys and string values are plain ASCII here.
+class JsonWriter final {
+ public:
+  void beginObject(std::string_view key = {}) { open(key, '{'); }
+  void endObject() { close('}'); }
+  void beginArray(std::string_view key = {}) { open(key, '['); }
+  void endArray() { close(']'); }
+
+  void value(std::string_view key, std::string_view text) {
+    prefix(key);
+    m_out << '"' << text << '"';
+  }
+
+  void value(std::string_view key, const char* text) { value(key, std::string_view(text)); }
+
+  void value(std::string_view key, double number) {
+    prefix(key);
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), "%.6g", number);
+    m_out << buffer;
+  }
+
+  void value(std::string_view key, std::uint64_t number) {
+    prefix(key);
+    m_out << number;
+  }
+
+  [[nodiscard]] std::string str() const { return m_out.str() + "\n"; }
+
+ private:
+  void prefix(std::string_view key) {
+    if (m_needsComma) {
+      m_out << ',';
+    }
+    m_out << '\n' << std::string(m_depth * 2, ' ');
+    if (!key.empty()) {
+      m_out << '"' << key << "\": ";
+    }
+    m_needsComma = true;
+  }
+
+  void open(std::string_view key, char bracket) {
+    if (m_depth > 0 || m_needsComma) {
+      prefix(key);
+    }
+    m_out << bracket;
+    ++m_depth;
+    m_needsComma = false;
+  }
+
+  void close(char bracket) {
+    --m_depth;
+    m_out << '\n' << std::string(m_depth * 2, ' ') << bracket;
+    m_needsComma = true;
+  }
+
+  std::ostringstream m_out;
+  std::size_t        m_depth      = 0;
+  bool               m_needsComma = false;
+};
+
+struct Sample {
+  double      seconds = 0.0;
+  std::size_t count   = 0;
+};
+
+// Runs `body` `repeat` times and returns the median-time sample.
+Sample measure(std::size_t repeat, const std::function<std::size_t()>& body) {
+  std::vector<Sample> samples;
+  for (std::size_t i = 0; i < std::max<std::size_t>(1, repeat); ++i) {
+    const auto  start = Clock::now();
+    std::size_t count = body();
+    samples.push_back({std::chrono::duration<double>(Clock::now() - start).count(), count});
+  }
+  std::sort(samples.begin(), samples.end(), [](const Sample& a, const Sample& b) {
+    return a.seconds < b.seconds;
+  });
+  return samples[samples.size() / 2];
+}
+
+struct ValueTypeCase {
+  std::string_view      name;
+  memory::ScanValueType type;
+  std::size_t           alignment;
+  std::string           marker;
+};
+
+std::optional<ValueTypeCase> valueTypeCase(std::string_view name) {
+  const auto text = [](auto value) {
+    std::ostringstream stream;
+    stream.precision(17);
+    stream << +value;
+    return stream.str();
+  };
+  if (name == "int8") {
+    return ValueTypeCase{"int8", memory::ScanValueType::Int8, 1, text(kMarkerInt8)};
+  }
+  if (name == "int16") {
+    return ValueTypeCase{"int16", memory::ScanValueType::Int16, 2, text(kMarkerInt16)};
+  }
+  if (name == "int32") {
+    return ValueTypeCase{"int32", memory::ScanValueType::Int32, 4, text(kMarkerInt32)};
+  }
+  if (name == "int64") {
+    return ValueTypeCase{"int64", memory::ScanValueType::Int64, 8, text(kMarkerInt64)};
+  }
+  if (name == "float") {
+    return ValueTypeCase{"float", memory::ScanValueType::Float, 4, text(kMarkerFloat)};
+  }
+  if (name == "double") {
+    return ValueTypeCase{"double", memory::ScanValueType::Double, 8, text(kMarkerDouble)};
+  }
+  return std::nullopt;
+}
+
+std::vector<std::string> splitList(std::string_view text) {
+  std::vector<std::string> items;
+  std::size_t              start = 0;
+  while (start <= text.size()) {
+    const std::size_t comma = std::min(text.find(',', start), text.size());
+    if (comma > start) {
+      items.emplace_back(text.substr(start, comma - start));
+    }
+    start = comma + 1;
+  }
+  return items;
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view name = argv[i];
+    if (i + 1 >= argc) {
+      return false;
+    }
+    const std::string value = argv[++i];
+    const auto        count = [&value]() { return static_cast<std::size_t>(std::strtoull(value.c_str(), nullptr, 0)); };
+
+    if (name == "--target") {
+      options.targetPath = value;
+    } else if (name == "--value-mib") {
+      options.valueMiB = count();
+    } else if (name == "--strings") {
+      options.stringCount = count();
+    } else if (name == "--nodes") {
+      options.nodeCount = count();
+    } else if (name == "--objects") {
+      options.objectCount = count();
+    } else if (name == "--threads") {
+      options.threadCounts.clear();
+      for (const std::string& item : splitList(value)) {
+        options.threadCounts.push_back(static_cast<std::size_t>(std::strtoull(item.c_str(), nullptr, 0)));
+      }
+    } else if (name == "--types") {
+      options.valueTypes = splitList(value);
+    } else if (name == "--repeat") {
+      options.repeat = count();
+    } else if (name == "--output") {
+      options.outputPath = value;
+    } else {
+      return false;
+    }
+  }
+
+  if (options.threadCounts.empty()) {
+    const std::size_t cores = std::max(1u, std::thread::hardware_concurrency());
+    for (std::size_t threads = 1; threads < cores; threads *= 2) {
+      options.threadCounts.push_back(threads);
+    }
+    options.threadCounts.push_back(cores);
+  }
+  return true;
+}
+
+std::string timestampUtc() {
+  const std::time_t now = std::time(nullptr);
+  std::tm           utc{};
+#ifdef _WIN32
+  gmtime_s(&utc, &now);
+#else
+  gmtime_r(&now, &utc);
+#endif
+  char buffer[32];
+  std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%SZ", &utc);
+  return buffer;
+}
+
+int fail(const std::string& message) {
+  std::fprintf(stderr, "farcal_bench: %s\n", message.c_str());
+  return 1;
+}
+
+int runBench(const Options& options) {
+  TargetProcess target;
+  if (!target.start(options.targetPath,
+                    {"--value-mib", std::to_string(options.valueMiB),
+                     "--strings", std::to_string(options.stringCount),
+                     "--nodes", std::to_string(options.nodeCount),
+                     "--objects", std::to_string(options.objectCount)})) {
+    return fail("failed to start " + options.targetPath);
+  }
+
+  const auto ready = target.readLine();
+  unsigned long long rootNode = 0;
+  unsigned           pid      = 0;
+  if (!ready.has_value() || std::sscanf(ready->c_str(), "ready %u 0x%llX", &pid, &rootNode) != 2) {
+    return fail("target did not report ready");
+  }
+
+  memory::MemoryReader reader;
+  if (!reader.attach(static_cast<memory::Process::Id>(pid))) {
+    return fail("failed to attach to target process " + std::to_string(pid));
+  }
+
+  JsonWriter json;
+  json.beginObject();
+  json.value("schema", std::uint64_t{1});
+  json.value("timestamp", timestampUtc());
+  json.value("pointer_size", std::uint64_t{sizeof(std::uintptr_t)});
+  json.value("hardware_threads", std::uint64_t{std::thread::hardware_concurrency()});
+  json.value("repeat", std::uint64_t{options.repeat});
+
+  json.beginObject("target");
+  json.value("value_mib", std::uint64_t{options.valueMiB});
+  json.value("strings", std::uint64_t{options.stringCount});
+  json.value("nodes", std::uint64_t{options.nodeCount});
+  json.value("objects", std::uint64_t{options.objectCount});
+  json.endObject();
+
+  memory::ProcessMemoryScanner scanner(&reader);
+  std::uint64_t                scannedBytes = 0;
+  memory::ProcessMemoryScanner::Observer observer;
+  observer.progress = [&scannedBytes](const memory::ScanProgress& progress) {
+    scannedBytes = progress.bytesTotal;
+  };
+
+  // First scan throughput per value type, then an "increased" next scan over those results after
+  // the target bumped its markers; exactly the markers survive it.
+  json.beginArray("first_scan");
+  std::vector<std::pair<ValueTypeCase, std::size_t>> nextScanInputs;
+  for (const std::string& typeName : options.valueTypes) {
+    const auto testCase = valueTypeCase(typeName);
+    if (!testCase.has_value()) {
+      return fail("unknown value type " + typeName);
+    }
+
+    memory::ScanSettings settings;
+    settings.valueType = testCase->type;
+    settings.alignment = testCase->alignment;
+
+    const Sample sample = measure(options.repeat, [&]() -> std::size_t {
+      if (!scanner.firstScan(settings, testCase->marker, observer)) {
+        return 0;
+      }
+      return scanner.resultCount();
+    });
+
+    json.beginObject();
+    json.value("type", testCase->name);
+    json.value("alignment", std::uint64_t{testCase->alignment});
+    if (!scanner.lastError().empty()) {
+      // A failed stage is reported and skipped; the stages after it may still work.
+      json.value("error", scanner.lastError());
+      json.endObject();
+      continue;
+    }
+    json.value("bytes", scannedBytes);
+    json.value("seconds", sample.seconds);
+    json.value("gb_per_s", sample.seconds > 0.0 ? scannedBytes / sample.seconds / 1e9 : 0.0);
+    json.value("results", std::uint64_t{sample.count});
+    json.endObject();
+
+    nextScanInputs.emplace_back(*testCase, sample.count);
+  }
+  json.endArray();
+
+  json.beginArray("next_scan");
+  for (const auto& [testCase, firstCount] : nextScanInputs) {
+    memory::ScanSettings settings;
+    settings.valueType = testCase.type;
+    settings.alignment = testCase.alignment;
+
+    // Each repetition restarts from a fresh first scan so the input size stays the same.
+    std::vector<double> seconds;
+    std::size_t         survivors = 0;
+    std::string         error;
+    for (std::size_t run = 0; run < std::max<std::size_t>(1, options.repeat); ++run) {
+      settings.scanType = memory::ScanType::ExactValue;
+      if (!scanner.firstScan(settings, testCase.marker)) {
+        error = "first scan failed: " + scanner.lastError();
+        break;
+      }
+      if (!target.send("mutate") || !target.readLine()) {
+        error = "target stopped responding";
+        break;
+      }
+      settings.scanType = memory::ScanType::IncreasedValue;
+      const auto start  = Clock::now();
+      const bool scanned = scanner.nextScan(settings, {});
+      seconds.push_back(std::chrono::duration<double>(Clock::now() - start).count());
+      survivors = scanner.resultCount();
+
+      if (!target.send("reset") || !target.readLine()) {
+        error = "target stopped responding";
+        break;
+      }
+      if (!scanned) {
+        error = "next scan failed: " + scanner.lastError();
+        break;
+      }
+    }
+
+    json.beginObject();
+    json.value("type", testCase.name);
+    json.value("scan", "increased");
+    if (!error.empty()) {
+      json.value("error", error);
+      json.endObject();
+      continue;
+    }
+    std::sort(seconds.begin(), seconds.end());
+    const double median = seconds[seconds.size() / 2];
+    json.value("entries", std::uint64_t{firstCount});
+    json.value("survivors", std::uint64_t{survivors});
+    json.value("seconds", median);
+    json.value("entries_per_s", median > 0.0 ? firstCount / median : 0.0);
+    json.endObject();
+  }
+  json.endArray();
+
+  json.beginArray("pointer_scan");
+  {
+    memory::PointerScanSettings settings;
+    settings.targetAddress = static_cast<std::uintptr_t>(rootNode);
+    settings.maxOffset     = 0x1000;
+
+    bool         scanned = true;
+    const Sample sample  = measure(options.repeat, [&]() -> std::size_t {
+      scanned = scanner.pointerScan(settings, observer);
+      return scanned ? scanner.resultCount() : 0;
+    });
+
+    json.beginObject();
+    json.value("max_offset", std::uint64_t{settings.maxOffset});
+    if (!scanned) {
+      json.value("error", scanner.lastError());
+    } else {
+      json.value("bytes", scannedBytes);
+      json.value("seconds", sample.seconds);
+      json.value("gb_per_s", sample.seconds > 0.0 ? scannedBytes / sample.seconds / 1e9 : 0.0);
+      json.value("results", std::uint64_t{sample.count});
+    }
+    json.endObject();
+  }
+  json.endArray();
+
+  // The string scanner does not report its byte count; with default options it covers every
+  // readable region.
+  std::uint64_t readableBytes = 0;
+  for (const memory::MemoryRegion& region : memory::queryMemoryRegions(reader)) {
+    if (region.readable) {
+      readableBytes += region.size;
+    }
+  }
+
+  const memory::StringScanner strings(&reader);
+  json.beginArray("string_scan");
+  for (const std::size_t threads : options.threadCounts) {
+    memory::StringScanner::ScanOptions scanOptions;
+    scanOptions.worker_threads = threads;
+
+    const Sample sample = measure(options.repeat, [&]() -> std::size_t {
+      std::size_t found = 0;
+      strings.find_all_batched(scanOptions, 4096, [&found](memory::StringScanner::StringBatch&& batch) {
+        found += batch.records.size();
+      });
+      return found;
+    });
+
+    json.beginObject();
+    json.value("threads", std::uint64_t{threads});
+    json.value("bytes", readableBytes);
+    json.value("seconds", sample.seconds);
+    json.value("mb_per_s", sample.seconds > 0.0 ? readableBytes / sample.seconds / (1024.0 * 1024.0) : 0.0);
+    json.value("strings", std::uint64_t{sample.count});
+    json.endObject();
+  }
+  json.endArray();
+
+  const memory::RttiScanner rtti(&reader);
+  json.beginArray("rtti");
+  for (const std::size_t threads : options.threadCounts) {
+    memory::RttiScanner::ScanOptions scanOptions;
+    scanOptions.worker_threads = threads;
+
+    std::size_t vftables = 0;
+    const Sample sample = measure(options.repeat, [&]() -> std::size_t {
+      const auto types = rtti.find_all(scanOptions);
+      vftables         = 0;
+      for (const auto& type : types) {
+        vftables += type.vftables.size();
+      }
+      return types.size();
+    });
+
+    json.beginObject();
+    json.value("threads", std::uint64_t{threads});
+    json.value("seconds", sample.seconds);
+    json.value("types", std::uint64_t{sample.count});
+    json.value("vftables", std::uint64_t{vftables});
+    json.endObject();
+  }
+  json.endArray();
+
+  json.endObject();
+
+  const std::string report = json.str();
+  if (options.outputPath.empty()) {
+    std::fwrite(report.data(), 1, report.size(), stdout);
+    return 0;
+  }
+  std::ofstream out(options.outputPath, std::ios::binary | std::ios::trunc);
+  out << report;
+  return out ? 0 : fail("failed to write " + options.outputPath);
+}
+
+} // namespace
+} // namespace farcal::bench
+
+int main(int argc, char** argv) {
+  farcal::bench::Options options;
+  if (!farcal::bench::parseOptions(argc, argv, options)) {
+    std::fputs(farcal::bench::kUsage.data(), stderr);
+    return 2;
+  }
+  return farcal::bench::runBench(options);
+}
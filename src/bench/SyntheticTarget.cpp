@@ -0,0 +1,271 @@
+// Synthetic scan target for farcal_bench. Allocates heaps of numeric values, strings, a pointer
+// graph and polymorphic objects, reports where they are on stdout and then waits for commands:
+//
+//   mutate   increments every marker value (so an "increased" next scan keeps exactly those)
+//   reset    restores every marker value
+//   quit     exits (end of input does the same)
+//
+// The first output line is `ready <pid> <root node address>`; every command is answered with `ok`.
+
+#include "SyntheticTargetLayout.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#  include <process.h>
+#else
+#  include <unistd.h>
+#endif
+
+namespace farcal::bench {
+namespace {
+
+struct Options {
+  std::size_t   valueMiB    = 64;
+  std::size_t   stringCount = 200000;
+  std::size_t   nodeCount   = 200000;
+  std::size_t   objectCount = 100000;
+  std::uint32_t seed        = 1;
+};
+
+template <typename T>
+std::vector<T> makeValueHeap(std::size_t bytes, T marker, std::mt19937& random) {
+  std::vector<T> heap(bytes / sizeof(T));
+  std::uniform_int_distribution<std::uint32_t> noise;
+  for (std::size_t i = 0; i < heap.size(); ++i) {
+    if (i % kMarkerStride == 0) {
+      heap[i] = marker;
+    } else {
+      const std::uint64_t bits = (static_cast<std::uint64_t>(noise(random)) << 32u) | noise(random);
+      std::memcpy(&heap[i], &bits, sizeof(T));
+    }
+  }
+  return heap;
+}
+
+template <typename T>
+void bumpMarkers(std::vector<T>& heap) {
+  for (std::size_t i = 0; i < heap.size(); i += kMarkerStride) {
+    heap[i] = static_cast<T>(heap[i] + 1);
+  }
+}
+
+template <typename T>
+void resetMarkers(std::vector<T>& heap, T marker) {
+  for (std::size_t i = 0; i < heap.size(); i += kMarkerStride) {
+    heap[i] = marker;
+  }
+}
+
+struct Node {
+  Node*         next = nullptr;
+  Node*         children[3]{};
+  std::uint64_t payload = 0;
+};
+
+class Entity {
+ public:
+  virtual ~Entity() = default;
+  virtual int tick() { return 0; }
+
+  std::uint64_t id = 0;
+};
+
+class Actor : public Entity {
+ public:
+  int tick() override { return 1; }
+  float position[3]{};
+};
+
+class Player : public Actor {
+ public:
+  int tick() override { return 2; }
+  int health = 100;
+};
+
+class Enemy : public Actor {
+ public:
+  int tick() override { return 3; }
+  int threat = 1;
+};
+
+class Boss : public Enemy {
+ public:
+  int tick() override { return 4; }
+  int phase = 0;
+};
+
+// Many small distinct types so RTTI discovery has a realistic number of descriptors to resolve.
+template <int N>
+class Component : public Entity {
+ public:
+  int tick() override { return N; }
+};
+
+using ObjectFactory = std::unique_ptr<Entity> (*)();
+
+template <int... N>
+std::vector<ObjectFactory> makeComponentFactories(std::integer_sequence<int, N...>) {
+  return {+[]() -> std::unique_ptr<Entity> { return std::make_unique<Component<N>>(); }...};
+}
+
+struct Heaps {
+  std::vector<std::int8_t>             int8s;
+  std::vector<std::int16_t>            int16s;
+  std::vector<std::int32_t>            int32s;
+  std::vector<std::int64_t>            int64s;
+  std::vector<float>                   floats;
+  std::vector<double>                  doubles;
+  std::vector<std::string>             asciiStrings;
+  std::vector<std::u16string>          utf16Strings;
+  std::vector<std::unique_ptr<Node>>   nodes;
+  std::vector<std::unique_ptr<Entity>> objects;
+};
+
+Heaps buildHeaps(const Options& options) {
+  std::mt19937 random(options.seed);
+  Heaps        heaps;
+
+  // The value budget is split evenly between the six numeric types.
+  const std::size_t perType = (options.valueMiB * 1024u * 1024u) / 6u;
+  heaps.int8s   = makeValueHeap<std::int8_t>(perType, kMarkerInt8, random);
+  heaps.int16s  = makeValueHeap<std::int16_t>(perType, kMarkerInt16, random);
+  heaps.int32s  = makeValueHeap<std::int32_t>(perType, kMarkerInt32, random);
+  heaps.int64s  = makeValueHeap<std::int64_t>(perType, kMarkerInt64, random);
+  heaps.floats  = makeValueHeap<float>(perType, kMarkerFloat, random);
+  heaps.doubles = makeValueHeap<double>(perType, kMarkerDouble, random);
+
+  std::uniform_int_distribution<int> letter('a', 'z');
+  std::uniform_int_distribution<int> extra(0, 48);
+  for (std::size_t i = 0; i < options.stringCount; ++i) {
+    std::string text = "farcal_bench_" + std::to_string(i) + "_";
+    const int   tail = extra(random);
+    for (int c = 0; c < tail; ++c) {
+      text.push_back(static_cast<char>(letter(random)));
+    }
+    if (i % 2 == 0) {
+      heaps.asciiStrings.push_back(std::move(text));
+    } else {
+      heaps.utf16Strings.emplace_back(text.begin(), text.end());
+    }
+  }
+
+  heaps.nodes.reserve(options.nodeCount);
+  for (std::size_t i = 0; i < options.nodeCount; ++i) {
+    auto node     = std::make_unique<Node>();
+    node->payload = i;
+    heaps.nodes.push_back(std::move(node));
+  }
+  if (!heaps.nodes.empty()) {
+    std::uniform_int_distribution<std::size_t> pick(0, heaps.nodes.size() - 1);
+    for (std::size_t i = 0; i < heaps.nodes.size(); ++i) {
+      Node& node = *heaps.nodes[i];
+      node.next  = i + 1 < heaps.nodes.size() ? heaps.nodes[i + 1].get() : nullptr;
+      for (Node*& child : node.children) {
+        child = heaps.nodes[pick(random)].get();
+      }
+    }
+  }
+
+  std::vector<ObjectFactory> factories = makeComponentFactories(std::make_integer_sequence<int, 96>{});
+  factories.push_back(+[]() -> std::unique_ptr<Entity> { return std::make_unique<Player>(); });
+  factories.push_back(+[]() -> std::unique_ptr<Entity> { return std::make_unique<Enemy>(); });
+  factories.push_back(+[]() -> std::unique_ptr<Entity> { return std::make_unique<Boss>(); });
+
+  heaps.objects.reserve(options.objectCount);
+  for (std::size_t i = 0; i < options.objectCount; ++i) {
+    auto object = factories[i % factories.size()]();
+    object->id  = i;
+    heaps.objects.push_back(std::move(object));
+  }
+
+  return heaps;
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+  for (int i = 1; i + 1 < argc; i += 2) {
+    const std::string_view name  = argv[i];
+    const auto             value = static_cast<std::size_t>(std::strtoull(argv[i + 1], nullptr, 0));
+    if (name == "--value-mib") {
+      options.valueMiB = value;
+    } else if (name == "--strings") {
+      options.stringCount = value;
+    } else if (name == "--nodes") {
+      options.nodeCount = value;
+    } else if (name == "--objects") {
+      options.objectCount = value;
+    } else if (name == "--seed") {
+      options.seed = static_cast<std::uint32_t>(value);
+    } else {
+      return false;
+    }
+  }
+  return argc % 2 == 1;
+}
+
+} // namespace
+} // namespace farcal::bench
+
+int main(int argc, char** argv) {
+  using namespace farcal::bench;
+
+  Options options;
+  if (!parseOptions(argc, argv, options)) {
+    std::fprintf(stderr,
+                 "usage: farcal_bench_target [--value-mib n] [--strings n] [--nodes n] "
+                 "[--objects n] [--seed n]\n");
+    return 2;
+  }
+
+  Heaps heaps = buildHeaps(options);
+
+#ifdef _WIN32
+  const int pid = _getpid();
+#else
+  const int pid = static_cast<int>(::getpid());
+#endif
+  const void* root = heaps.nodes.empty() ? nullptr : static_cast<const void*>(heaps.nodes.front().get());
+  std::printf("ready %d 0x%llX\n", pid, static_cast<unsigned long long>(reinterpret_cast<std::uintptr_t>(root)));
+  std::fflush(stdout);
+
+  std::string command;
+  while (std::getline(std::cin, command)) {
+    if (command == "quit") {
+      break;
+    }
+    if (command == "mutate") {
+      bumpMarkers(heaps.int8s);
+      bumpMarkers(heaps.int16s);
+      bumpMarkers(heaps.int32s);
+      bumpMarkers(heaps.int64s);
+      bumpMarkers(heaps.floats);
+      bumpMarkers(heaps.doubles);
+    } else if (command == "reset") {
+      resetMarkers(heaps.int8s, kMarkerInt8);
+      resetMarkers(heaps.int16s, kMarkerInt16);
+      resetMarkers(heaps.int32s, kMarkerInt32);
+      resetMarkers(heaps.int64s, kMarkerInt64);
+      resetMarkers(heaps.floats, kMarkerFloat);
+      resetMarkers(heaps.doubles, kMarkerDouble);
+    }
+    std::printf("ok\n");
+    std::fflush(stdout);
+  }
+
+  int checksum = 0;
+  for (const auto& object : heaps.objects) {
+    checksum += object->tick();
+  }
+  return checksum == -1 ? 1 : 0;
+}
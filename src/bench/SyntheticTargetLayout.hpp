@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace farcal::bench {
+
+// Shared between farcal_bench and farcal_bench_target: every kMarkerStride-th element of each value
+// heap holds the marker for its type, and `mutate` increments exactly those elements.
+inline constexpr std::size_t  kMarkerStride = 64;
+inline constexpr std::int8_t  kMarkerInt8   = 0x5A;
+inline constexpr std::int16_t kMarkerInt16  = 0x2BAD;
+inline constexpr std::int32_t kMarkerInt32  = 1234567;
+inline constexpr std::int64_t kMarkerInt64  = 0x123456789ABLL;
+inline constexpr float        kMarkerFloat  = 1234.5f;
+inline constexpr double       kMarkerDouble = 98765.4321;
+
+} // namespace farcal::bench
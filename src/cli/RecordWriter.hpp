@@ -0,0 +1,182 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace farcal::cli {
+
+enum class OutputFormat {
+  JsonLines = 0,
+  Tsv
+};
+
+// Emits one record per line. JSON Lines records are objects tagged with a "kind" field; TSV records
+// start with the kind followed by the field values in the order they were added, without names.
+class RecordWriter final {
+ public:
+  explicit RecordWriter(OutputFormat format, std::FILE* stream = stdout)
+      : m_format(format), m_stream(stream) {}
+
+  void begin(std::string_view kind) {
+    m_line.clear();
+    if (m_format == OutputFormat::JsonLines) {
+      m_line += "{\"kind\":";
+      appendJsonString(kind);
+    } else {
+      appendTsvText(kind);
+    }
+  }
+
+  void text(std::string_view name, std::string_view value) {
+    if (m_format == OutputFormat::JsonLines) {
+      appendJsonName(name);
+      appendJsonString(value);
+    } else {
+      m_line.push_back('\t');
+      appendTsvText(value);
+    }
+  }
+
+  void number(std::string_view name, std::uint64_t value) {
+    appendRaw(name, std::to_string(value));
+  }
+
+  void number(std::string_view name, std::int64_t value) {
+    appendRaw(name, std::to_string(value));
+  }
+
+  void number(std::string_view name, double value) {
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), "%.6g", value);
+    appendRaw(name, buffer);
+  }
+
+  void boolean(std::string_view name, bool value) {
+    appendRaw(name, value ? "true" : "false");
+  }
+
+  // Addresses are written as hex strings; JSON numbers cannot hold 64-bit values exactly.
+  void address(std::string_view name, std::uintptr_t value) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "0x%llX", static_cast<unsigned long long>(value));
+    text(name, buffer);
+  }
+
+  // A JSON array of hex strings, or a comma-separated list in TSV.
+  void addressList(std::string_view name, std::span<const std::uintptr_t> values) {
+    if (m_format == OutputFormat::JsonLines) {
+      appendJsonName(name);
+      m_line.push_back('[');
+    } else {
+      m_line.push_back('\t');
+    }
+    for (std::size_t i = 0; i < values.size(); ++i) {
+      if (i != 0) {
+        m_line.push_back(',');
+      }
+      char buffer[32];
+      std::snprintf(buffer, sizeof(buffer), "0x%llX", static_cast<unsigned long long>(values[i]));
+      if (m_format == OutputFormat::JsonLines) {
+        appendJsonString(buffer);
+      } else {
+        m_line += buffer;
+      }
+    }
+    if (m_format == OutputFormat::JsonLines) {
+      m_line.push_back(']');
+    }
+  }
+
+  void end() {
+    if (m_format == OutputFormat::JsonLines) {
+      m_line.push_back('}');
+    }
+    m_line.push_back('\n');
+    std::fwrite(m_line.data(), 1, m_line.size(), m_stream);
+  }
+
+  void flush() { std::fflush(m_stream); }
+
+ private:
+  void appendRaw(std::string_view name, std::string_view value) {
+    if (m_format == OutputFormat::JsonLines) {
+      appendJsonName(name);
+    } else {
+      m_line.push_back('\t');
+    }
+    m_line += value;
+  }
+
+  void appendJsonName(std::string_view name) {
+    m_line.push_back(',');
+    appendJsonString(name);
+    m_line.push_back(':');
+  }
+
+  void appendJsonString(std::string_view value) {
+    m_line.push_back('"');
+    for (const char ch : value) {
+      const auto byte = static_cast<unsigned char>(ch);
+      switch (ch) {
+        case '"':
+          m_line += "\\\"";
+          break;
+        case '\\':
+          m_line += "\\\\";
+          break;
+        case '\n':
+          m_line += "\\n";
+          break;
+        case '\r':
+          m_line += "\\r";
+          break;
+        case '\t':
+          m_line += "\\t";
+          break;
+        default:
+          if (byte < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04X", static_cast<unsigned>(byte));
+            m_line += escaped;
+          } else {
+            m_line.push_back(ch);
+          }
+          break;
+      }
+    }
+    m_line.push_back('"');
+  }
+
+  // TSV has no quoting; separators inside values are escaped the way `COPY ... TEXT` does it.
+  void appendTsvText(std::string_view value) {
+    for (const char ch : value) {
+      switch (ch) {
+        case '\\':
+          m_line += "\\\\";
+          break;
+        case '\t':
+          m_line += "\\t";
+          break;
+        case '\n':
+          m_line += "\\n";
+          break;
+        case '\r':
+          m_line += "\\r";
+          break;
+        default:
+          m_line.push_back(ch);
+          break;
+      }
+    }
+  }
+
+  OutputFormat m_format = OutputFormat::JsonLines;
+  std::FILE*   m_stream = stdout;
+  std::string  m_line;
+};
+
+} // namespace farcal::cli
@@ -0,0 +1,735 @@
+#include "RecordWriter.hpp"
+
+#include "farcal/luavm/AttachedProcessContext.hpp"
+#include "farcal/luavm/LuaVmBase.hpp"
+#include "farcal/memory/MemoryReader.hpp"
+#include "farcal/memory/ModuleEnumerator.hpp"
+#include "farcal/memory/ProcessMemoryScanner.hpp"
+#include "farcal/memory/RttiScanner.hpp"
+#include "farcal/memory/StringScanner.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#ifdef _WIN32
+#  ifndef WIN32_LEAN_AND_MEAN
+#    define WIN32_LEAN_AND_MEAN
+#  endif
+#  include <windows.h>
+#  include <tlhelp32.h>
+#endif
+
+namespace farcal::cli {
+namespace {
+
+constexpr std::string_view kUsage =
+    "usage: farcal-cli [global options] <command> [command options]\n"
+    "\n"
+    "global options:\n"
+    "  --pid <id>               attach to a process id\n"
+    "  --process <name>         attach to the first process with this executable name\n"
+    "  --format jsonl|tsv       output format (default: jsonl)\n"
+    "  --limit <n>              print at most n result records\n"
+    "  --progress               report scan progress on stderr\n"
+    "\n"
+    "commands:\n"
+    "  attach                   check that the process can be opened\n"
+    "  first-scan               --type <t> --value <v> [--align <n>] [--hex] [--read-only]\n"
+    "                           [--case-sensitive] [--unicode] [--session <file>]\n"
+    "  next-scan                --session <file> --scan <s> [--value <v>] [--hex]\n"
+    "  pointer-scan             --target <addr> [--max-offset <n>] [--read-only] [--session <file>]\n"
+    "  results                  --session <file>   (no process needed)\n"
+    "  modules                  list loaded images and their sections\n"
+    "  rtti                     [--module <name,...>] [--all-regions] [--writable] [--raw-names]\n"
+    "                           [--abi auto|msvc|itanium] [--cache <dir>] [--threads <n>]\n"
+    "                           [--max <n>]\n"
+    "  strings                  [--min-length <n>] [--max-length <n>] [--encoding <set>]\n"
+    "                           [--contains <text>] [--regex <expr>] [--case-sensitive]\n"
+    "                           [--read-only] [--threads <n>] [--max <n>]\n"
+    "                           sets: ascii utf8 utf16 both (ascii+utf16, default) all\n"
+    "  script                   <file.lua | ->\n"
+    "\n"
+    "types:  int8 int16 int32 int64 float double string\n"
+    "scans:  exact increased decreased changed unchanged\n"
+    "Numbers accept a 0x prefix. Exit status is 0 on success, 1 on failure, 2 on usage errors.\n";
+
+// Parsed command line: `--name value` options, bare `--flag`s and positional words, split into the
+// part before the command word and the part after it.
+class Arguments final {
+ public:
+  Arguments(int argc, char** argv, int first, const std::vector<std::string_view>& flagNames) {
+    for (int i = first; i < argc; ++i) {
+      const std::string_view word = argv[i];
+      if (word.size() > 2 && word.substr(0, 2) == "--") {
+        const std::string name(word.substr(2));
+        const bool        isFlag =
+            std::find(flagNames.begin(), flagNames.end(), word.substr(2)) != flagNames.end();
+        if (isFlag || i + 1 >= argc) {
+          m_flags.push_back(name);
+        } else {
+          m_options[name] = argv[++i];
+        }
+        continue;
+      }
+      m_positional.emplace_back(word);
+    }
+  }
+
+  [[nodiscard]] bool flag(std::string_view name) const {
+    return std::find(m_flags.begin(), m_flags.end(), name) != m_flags.end();
+  }
+
+  [[nodiscard]] std::optional<std::string> option(const std::string& name) const {
+    const auto it = m_options.find(name);
+    if (it == m_options.end()) {
+      return std::nullopt;
+    }
+    return it->second;
+  }
+
+  [[nodiscard]] const std::vector<std::string>& positional() const noexcept { return m_positional; }
+
+ private:
+  std::vector<std::string>                     m_flags;
+  std::unordered_map<std::string, std::string> m_options;
+  std::vector<std::string>                     m_positional;
+};
+
+const std::vector<std::string_view> kFlagNames = {
+    "hex", "read-only", "case-sensitive", "unicode", "progress", "writable", "raw-names",
+    "all-regions"};
+
+// Accepts decimal or 0x-prefixed hexadecimal.
+std::optional<std::uint64_t> parseUnsigned(std::string_view text) {
+  if (text.empty()) {
+    return std::nullopt;
+  }
+  int base = 10;
+  if (text.size() > 2 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X')) {
+    base = 16;
+    text.remove_prefix(2);
+  }
+  try {
+    std::size_t         consumed = 0;
+    const std::string   value(text);
+    const std::uint64_t parsed = std::stoull(value, &consumed, base);
+    if (consumed != value.size()) {
+      return std::nullopt;
+    }
+    return parsed;
+  } catch (...) {
+    return std::nullopt;
+  }
+}
+
+std::optional<memory::ScanValueType> parseValueType(std::string_view text) {
+  static const std::unordered_map<std::string_view, memory::ScanValueType> kTypes = {
+      {"int8", memory::ScanValueType::Int8},
+      {"int16", memory::ScanValueType::Int16},
+      {"int32", memory::ScanValueType::Int32},
+      {"int64", memory::ScanValueType::Int64},
+      {"float", memory::ScanValueType::Float},
+      {"double", memory::ScanValueType::Double},
+      {"string", memory::ScanValueType::String}};
+  const auto it = kTypes.find(text);
+  return it == kTypes.end() ? std::nullopt : std::optional(it->second);
+}
+
+std::optional<memory::ScanType> parseScanType(std::string_view text) {
+  static const std::unordered_map<std::string_view, memory::ScanType> kScans = {
+      {"exact", memory::ScanType::ExactValue},
+      {"increased", memory::ScanType::IncreasedValue},
+      {"decreased", memory::ScanType::DecreasedValue},
+      {"changed", memory::ScanType::ChangedValue},
+      {"unchanged", memory::ScanType::UnchangedValue}};
+  const auto it = kScans.find(text);
+  return it == kScans.end() ? std::nullopt : std::optional(it->second);
+}
+
+std::string formatValue(std::span<const std::uint8_t> bytes, const memory::ScanSettings& settings) {
+  const auto load = [&bytes]<typename T>(T value) {
+    std::memcpy(&value, bytes.data(), std::min(sizeof(T), bytes.size()));
+    return value;
+  };
+
+  switch (settings.valueType) {
+    case memory::ScanValueType::Int8:
+      return std::to_string(load(std::int8_t{}));
+    case memory::ScanValueType::Int16:
+      return std::to_string(load(std::int16_t{}));
+    case memory::ScanValueType::Int32:
+      return std::to_string(load(std::int32_t{}));
+    case memory::ScanValueType::Int64:
+      return std::to_string(load(std::int64_t{}));
+    case memory::ScanValueType::Float: {
+      std::ostringstream stream;
+      stream.precision(9);
+      stream << load(float{});
+      return stream.str();
+    }
+    case memory::ScanValueType::Double: {
+      std::ostringstream stream;
+      stream.precision(17);
+      stream << load(double{});
+      return stream.str();
+    }
+    case memory::ScanValueType::String: {
+      std::string text;
+      if (settings.unicode) {
+        for (std::size_t i = 0; i + 1 < bytes.size(); i += 2) {
+          text.push_back(static_cast<char>(bytes[i]));
+        }
+      } else {
+        text.assign(bytes.begin(), bytes.end());
+      }
+      return text;
+    }
+  }
+  return {};
+}
+
+const char* encodingName(memory::StringScanner::Encoding encoding) {
+  switch (encoding) {
+    case memory::StringScanner::Encoding::Utf16:
+      return "utf16";
+    case memory::StringScanner::Encoding::Utf8:
+      return "utf8";
+    default:
+      return "ascii";
+  }
+}
+
+std::optional<std::uint32_t> findProcessByName(std::string_view name) {
+#ifdef _WIN32
+  const HANDLE snapshot = ::CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
+  if (snapshot == INVALID_HANDLE_VALUE) {
+    return std::nullopt;
+  }
+
+  std::optional<std::uint32_t> found;
+  PROCESSENTRY32W              entry{};
+  entry.dwSize = sizeof(entry);
+  if (::Process32FirstW(snapshot, &entry) != FALSE) {
+    do {
+      std::string exeName;
+      for (const wchar_t* ch = entry.szExeFile; *ch != L'\0'; ++ch) {
+        exeName.push_back(static_cast<char>(*ch));
+      }
+      if (_stricmp(exeName.c_str(), std::string(name).c_str()) == 0) {
+        found = static_cast<std::uint32_t>(entry.th32ProcessID);
+        break;
+      }
+    } while (::Process32NextW(snapshot, &entry) != FALSE);
+  }
+  ::CloseHandle(snapshot);
+  return found;
+#else
+  std::error_code error;
+  for (const auto& entry : std::filesystem::directory_iterator("/proc", error)) {
+    const auto pid = parseUnsigned(entry.path().filename().string());
+    if (!pid.has_value()) {
+      continue;
+    }
+    std::ifstream comm(entry.path() / "comm");
+    std::string   processName;
+    if (std::getline(comm, processName) && processName == name) {
+      return static_cast<std::uint32_t>(*pid);
+    }
+  }
+  return std::nullopt;
+#endif
+}
+
+class CommandLineTool final {
+ public:
+  CommandLineTool(const Arguments& global, const Arguments& command, OutputFormat format)
+      : m_global(global), m_command(command), m_out(format) {
+    if (const auto limit = m_global.option("limit"); limit.has_value()) {
+      m_limit = parseUnsigned(*limit);
+    }
+  }
+
+  int run(std::string_view name) {
+    m_start = Clock::now();
+
+    bool ok = false;
+    if (name == "attach") {
+      ok = attach();
+    } else if (name == "first-scan") {
+      ok = attach() && firstScan();
+    } else if (name == "next-scan") {
+      ok = attach() && nextScan();
+    } else if (name == "pointer-scan") {
+      ok = attach() && pointerScan();
+    } else if (name == "results") {
+      ok = showSessionResults();
+    } else if (name == "modules") {
+      ok = attach() && listModules();
+    } else if (name == "rtti") {
+      ok = attach() && dumpRtti();
+    } else if (name == "strings") {
+      ok = attach() && dumpStrings();
+    } else if (name == "script") {
+      ok = runScript();
+    } else {
+      std::fprintf(stderr, "farcal-cli: unknown command '%s'\n\n%s", std::string(name).c_str(), kUsage.data());
+      return 2;
+    }
+
+    if (!ok) {
+      m_out.begin("error");
+      m_out.text("command", name);
+      m_out.text("message", m_error);
+      m_out.end();
+    }
+
+    m_out.begin("summary");
+    m_out.text("command", name);
+    m_out.boolean("success", ok);
+    m_out.number("results", static_cast<std::uint64_t>(m_resultCount));
+    m_out.number("elapsed_ms", elapsedMilliseconds());
+    m_out.number("bytes_scanned", m_lastProgress.bytesDone);
+    m_out.number("mb_per_s", m_lastProgress.bytesPerSecond / (1024.0 * 1024.0));
+    m_out.end();
+    m_out.flush();
+    return ok ? 0 : 1;
+  }
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  double elapsedMilliseconds() const {
+    return std::chrono::duration<double, std::milli>(Clock::now() - m_start).count();
+  }
+
+  bool fail(std::string message) {
+    m_error = std::move(message);
+    return false;
+  }
+
+  bool withinLimit(std::size_t printed) const {
+    return !m_limit.has_value() || printed < *m_limit;
+  }
+
+  bool attach() {
+    std::optional<std::uint32_t> processId;
+    if (const auto pid = m_global.option("pid"); pid.has_value()) {
+      const auto parsed = parseUnsigned(*pid);
+      if (!parsed.has_value() || *parsed == 0 || *parsed > 0xFFFFFFFFull) {
+        return fail("Invalid --pid value.");
+      }
+      processId = static_cast<std::uint32_t>(*parsed);
+    } else if (const auto processName = m_global.option("process"); processName.has_value()) {
+      processId = findProcessByName(*processName);
+      if (!processId.has_value()) {
+        return fail("No running process named '" + *processName + "'.");
+      }
+    } else {
+      return fail("No target process; pass --pid or --process.");
+    }
+
+    if (!m_reader.attach(static_cast<memory::Process::Id>(*processId))) {
+      return fail("Failed to attach to process " + std::to_string(*processId) + ".");
+    }
+    luavm::AttachedProcessContext::setAttachedProcessId(*processId);
+    m_scanner.setReader(&m_reader);
+
+    m_out.begin("attached");
+    m_out.number("pid", static_cast<std::uint64_t>(*processId));
+    m_out.boolean("writable", m_reader.canWrite());
+    m_out.end();
+    return true;
+  }
+
+  memory::ProcessMemoryScanner::Observer makeObserver() {
+    memory::ProcessMemoryScanner::Observer observer;
+    const bool report = m_global.flag("progress");
+    observer.progress = [this, report](const memory::ScanProgress& progress) {
+      m_lastProgress = progress;
+      if (report) {
+        std::fprintf(stderr,
+                     "\r%6.2f%%  %10zu results  %8.1f MB/s  ETA %6.1fs",
+                     progress.bytesTotal == 0 ? 100.0 : (100.0 * progress.bytesDone) / progress.bytesTotal,
+                     progress.resultCount,
+                     progress.bytesPerSecond / (1024.0 * 1024.0),
+                     progress.etaSeconds);
+      }
+    };
+    return observer;
+  }
+
+  void endProgressLine() const {
+    if (m_global.flag("progress")) {
+      std::fputc('\n', stderr);
+    }
+  }
+
+  bool saveSessionIfRequested() {
+    const auto session = m_command.option("session");
+    if (!session.has_value()) {
+      return true;
+    }
+    if (!m_scanner.saveSession(std::filesystem::u8path(*session))) {
+      return fail(m_scanner.lastError());
+    }
+    return true;
+  }
+
+  bool firstScan() {
+    memory::ScanSettings settings;
+    settings.hexInput        = m_command.flag("hex");
+    settings.includeReadOnly = m_command.flag("read-only");
+    settings.caseSensitive   = m_command.flag("case-sensitive");
+    settings.unicode         = m_command.flag("unicode");
+
+    const auto type = parseValueType(m_command.option("type").value_or("int32"));
+    if (!type.has_value()) {
+      return fail("Unknown --type.");
+    }
+    settings.valueType = *type;
+
+    const auto value = m_command.option("value");
+    if (!value.has_value()) {
+      return fail("first-scan needs --value.");
+    }
+
+    const std::string defaultAlignment = settings.valueType == memory::ScanValueType::String ? "1" : "4";
+    const auto        alignment = parseUnsigned(m_command.option("align").value_or(defaultAlignment));
+    if (!alignment.has_value()) {
+      return fail("Invalid --align value.");
+    }
+    settings.alignment = static_cast<std::size_t>(*alignment);
+
+    const bool scanned = m_scanner.firstScan(settings, *value, makeObserver());
+    endProgressLine();
+    if (!scanned) {
+      return fail(m_scanner.lastError());
+    }
+    printResults();
+    return saveSessionIfRequested();
+  }
+
+  bool nextScan() {
+    const auto session = m_command.option("session");
+    if (!session.has_value()) {
+      return fail("next-scan needs --session.");
+    }
+    if (!m_scanner.loadSession(std::filesystem::u8path(*session))) {
+      return fail(m_scanner.lastError());
+    }
+
+    // Type, width and encoding come from the session; only per-scan input flags are taken here.
+    memory::ScanSettings settings = m_scanner.lastSettings();
+    settings.hexInput             = m_command.flag("hex");
+    settings.caseSensitive        = m_command.flag("case-sensitive");
+
+    const auto scan = parseScanType(m_command.option("scan").value_or("exact"));
+    if (!scan.has_value()) {
+      return fail("Unknown --scan.");
+    }
+    settings.scanType = *scan;
+
+    const std::string value = m_command.option("value").value_or("");
+    if (settings.scanType == memory::ScanType::ExactValue && value.empty()) {
+      return fail("An exact next-scan needs --value.");
+    }
+
+    const bool scanned = m_scanner.nextScan(settings, value, makeObserver());
+    endProgressLine();
+    if (!scanned) {
+      return fail(m_scanner.lastError());
+    }
+    printResults();
+    return saveSessionIfRequested();
+  }
+
+  bool pointerScan() {
+    const auto target = parseUnsigned(m_command.option("target").value_or(""));
+    if (!target.has_value() || *target == 0) {
+      return fail("pointer-scan needs a non-zero --target address.");
+    }
+    const auto maxOffset = parseUnsigned(m_command.option("max-offset").value_or("0x1000"));
+    if (!maxOffset.has_value()) {
+      return fail("Invalid --max-offset value.");
+    }
+
+    memory::PointerScanSettings settings;
+    settings.targetAddress   = static_cast<std::uintptr_t>(*target);
+    settings.maxOffset       = static_cast<std::size_t>(*maxOffset);
+    settings.includeReadOnly = m_command.flag("read-only");
+
+    const bool scanned = m_scanner.pointerScan(settings, makeObserver());
+    endProgressLine();
+    if (!scanned) {
+      return fail(m_scanner.lastError());
+    }
+
+    const memory::ScanResultSet& results = m_scanner.results();
+    m_resultCount                        = results.size();
+    for (std::size_t i = 0; i < results.size() && withinLimit(i); ++i) {
+      std::uintptr_t pointer = 0;
+      std::memcpy(&pointer, results.currentValue(i).data(), sizeof(pointer));
+
+      m_out.begin("pointer");
+      m_out.address("address", results.address(i));
+      m_out.address("points_to", pointer);
+      m_out.number("offset", static_cast<std::uint64_t>(settings.targetAddress - pointer));
+      m_out.end();
+    }
+    return saveSessionIfRequested();
+  }
+
+  bool showSessionResults() {
+    const auto session = m_command.option("session");
+    if (!session.has_value()) {
+      return fail("results needs --session.");
+    }
+    if (!m_scanner.loadSession(std::filesystem::u8path(*session))) {
+      return fail(m_scanner.lastError());
+    }
+    printResults();
+    return true;
+  }
+
+  void printResults() {
+    const memory::ScanResultSet& results  = m_scanner.results();
+    const memory::ScanSettings&  settings = m_scanner.lastSettings();
+    m_resultCount                         = results.size();
+
+    for (std::size_t i = 0; i < results.size() && withinLimit(i); ++i) {
+      m_out.begin("result");
+      m_out.address("address", results.address(i));
+      m_out.text("value", formatValue(results.currentValue(i), settings));
+      m_out.text("previous", formatValue(results.previousValue(i), settings));
+      m_out.end();
+    }
+  }
+
+  bool listModules() {
+    const auto modules = memory::ModuleEnumerator(&m_reader).enumerate();
+    m_resultCount      = modules.size();
+
+    for (std::size_t i = 0; i < modules.size() && withinLimit(i); ++i) {
+      const auto& module = modules[i];
+      m_out.begin("module");
+      m_out.text("name", module.name);
+      m_out.address("base", module.base);
+      m_out.number("size", static_cast<std::uint64_t>(module.size));
+      m_out.text("format", module.format == memory::ModuleFormat::Pe ? "pe" : "elf");
+      m_out.text("path", module.path);
+      m_out.end();
+
+      for (const auto& section : module.sections) {
+        const char protection[] = {section.readable ? 'r' : '-',
+                                   section.writable ? 'w' : '-',
+                                   section.executable ? 'x' : '-',
+                                   '\0'};
+        m_out.begin("section");
+        m_out.text("module", module.name);
+        m_out.text("name", section.name);
+        m_out.address("base", section.base);
+        m_out.number("size", static_cast<std::uint64_t>(section.size));
+        m_out.text("protection", protection);
+        m_out.end();
+      }
+    }
+    return true;
+  }
+
+  bool dumpRtti() {
+    memory::RttiScanner::ScanOptions options;
+    options.include_writable_regions = m_command.flag("writable");
+    options.demangle_names           = !m_command.flag("raw-names");
+    options.scope_to_module_sections = !m_command.flag("all-regions");
+    options.cache_directory          = m_command.option("cache").value_or("");
+    const std::string abi = m_command.option("abi").value_or("auto");
+    if (abi == "msvc") {
+      options.abi = memory::RttiScanner::Abi::Msvc;
+    } else if (abi == "itanium") {
+      options.abi = memory::RttiScanner::Abi::Itanium;
+    } else if (abi != "auto") {
+      return fail("Unknown --abi.");
+    }
+    if (const auto modules = m_command.option("module"); modules.has_value()) {
+      std::stringstream list(*modules);
+      for (std::string name; std::getline(list, name, ',');) {
+        if (!name.empty()) {
+          options.modules.push_back(name);
+        }
+      }
+    }
+
+    const std::pair<const char*, std::size_t*> numericOptions[] = {
+        {"threads", &options.worker_threads},
+        {"max", &options.max_results}};
+    for (const auto& [name, target] : numericOptions) {
+      if (const auto text = m_command.option(name); text.has_value()) {
+        const auto parsed = parseUnsigned(*text);
+        if (!parsed.has_value()) {
+          return fail(std::string("Invalid --") + name + " value.");
+        }
+        *target = static_cast<std::size_t>(*parsed);
+      }
+    }
+
+    const memory::RttiScanner scanner(&m_reader);
+    const auto                types = scanner.find_all(options);
+    m_resultCount                   = types.size();
+
+    for (std::size_t i = 0; i < types.size() && withinLimit(i); ++i) {
+      m_out.begin("type");
+      m_out.address("type_descriptor", types[i].type_descriptor);
+      m_out.text("name", types[i].demangled_name);
+      m_out.addressList("vftables", types[i].vftables);
+      m_out.end();
+    }
+    return true;
+  }
+
+  bool dumpStrings() {
+    memory::StringScanner::ScanOptions options;
+    options.include_writable_regions = !m_command.flag("read-only");
+    options.case_sensitive_filter    = m_command.flag("case-sensitive");
+    options.contains                 = m_command.option("contains").value_or("");
+    options.regex                    = m_command.option("regex").value_or("");
+    if (!memory::StringFilter::isValidPattern(options.regex)) {
+      return fail("Invalid --regex.");
+    }
+
+    const std::string encoding = m_command.option("encoding").value_or("both");
+    if (encoding != "ascii" && encoding != "utf8" && encoding != "utf16" && encoding != "both" &&
+        encoding != "all") {
+      return fail("Unknown --encoding.");
+    }
+    // ASCII strings are UTF-8 too, so "utf8" keeps them.
+    options.scan_ascii = encoding != "utf16";
+    options.scan_utf8  = encoding == "utf8" || encoding == "all";
+    options.scan_utf16 = encoding == "utf16" || encoding == "both" || encoding == "all";
+
+    const std::pair<const char*, std::size_t*> numericOptions[] = {
+        {"min-length", &options.min_length},
+        {"max-length", &options.max_length},
+        {"threads", &options.worker_threads},
+        {"max", &options.max_results}};
+    for (const auto& [name, target] : numericOptions) {
+      if (const auto text = m_command.option(name); text.has_value()) {
+        const auto parsed = parseUnsigned(*text);
+        if (!parsed.has_value()) {
+          return fail(std::string("Invalid --") + name + " value.");
+        }
+        *target = static_cast<std::size_t>(*parsed);
+      }
+    }
+
+    const memory::StringScanner scanner(&m_reader);
+    scanner.find_all_batched(options, 4096, [this](memory::StringScanner::StringBatch&& batch) {
+      for (const auto& entry : batch.records) {
+        if (withinLimit(m_resultCount)) {
+          m_out.begin("string");
+          m_out.address("address", entry.address);
+          m_out.text("encoding", encodingName(entry.encoding));
+          m_out.text("text", entry.text());
+          m_out.end();
+        }
+        ++m_resultCount;
+      }
+    });
+    return true;
+  }
+
+  bool runScript() {
+    if (m_command.positional().empty()) {
+      return fail("script needs a file name, or - for stdin.");
+    }
+
+    // Scripts may run without a process; memory reads then return nil.
+    if (m_global.option("pid").has_value() || m_global.option("process").has_value()) {
+      if (!attach()) {
+        return false;
+      }
+    }
+
+    const std::string& path = m_command.positional().front();
+    std::string        source;
+    if (path == "-") {
+      source.assign(std::istreambuf_iterator<char>(std::cin), std::istreambuf_iterator<char>());
+    } else {
+      std::ifstream file(std::filesystem::u8path(path), std::ios::binary);
+      if (!file) {
+        return fail("Failed to open script '" + path + "'.");
+      }
+      source.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    const luavm::BasicLuaVm vm;
+    const auto              result = vm.execute(source, [this](std::string_view line) {
+      m_out.begin("output");
+      m_out.text("text", line);
+      m_out.end();
+    });
+    if (!result.success) {
+      return fail(result.message);
+    }
+    return true;
+  }
+
+  const Arguments&             m_global;
+  const Arguments&             m_command;
+  RecordWriter                 m_out;
+  memory::MemoryReader         m_reader;
+  memory::ProcessMemoryScanner m_scanner;
+  memory::ScanProgress         m_lastProgress{};
+  std::optional<std::uint64_t> m_limit;
+  std::size_t                  m_resultCount = 0;
+  std::string                  m_error;
+  Clock::time_point            m_start;
+};
+
+} // namespace
+} // namespace farcal::cli
+
+int main(int argc, char** argv) {
+  using namespace farcal::cli;
+
+  // Global options come before the command word, command options after it.
+  int commandIndex = 1;
+  while (commandIndex < argc) {
+    const std::string_view word = argv[commandIndex];
+    if (word.size() <= 2 || word.substr(0, 2) != "--") {
+      break;
+    }
+    const bool isFlag = std::find(kFlagNames.begin(), kFlagNames.end(), word.substr(2)) != kFlagNames.end();
+    commandIndex += isFlag ? 1 : 2;
+  }
+
+  if (commandIndex >= argc || std::string_view(argv[commandIndex]) == "help") {
+    std::fputs(kUsage.data(), commandIndex >= argc ? stderr : stdout);
+    return commandIndex >= argc ? 2 : 0;
+  }
+
+  const Arguments global(commandIndex, argv, 1, kFlagNames);
+  const Arguments command(argc, argv, commandIndex + 1, kFlagNames);
+
+  const std::string format = global.option("format").value_or("jsonl");
+  if (format != "jsonl" && format != "tsv") {
+    std::fprintf(stderr, "farcal-cli: unknown format '%s'\n", format.c_str());
+    return 2;
+  }
+
+  CommandLineTool tool(global, command, format == "tsv" ? OutputFormat::Tsv : OutputFormat::JsonLines);
+  return tool.run(argv[commandIndex]);
+}
@@ -1,10 +1,13 @@
 #include "farcal/luavm/LuaBindings.hpp"
 
 #include "farcal/luavm/AttachedProcessContext.hpp"
+#include "farcal/memory/InstanceFinder.hpp"
 #include "farcal/memory/MemoryReader.hpp"
+#include "farcal/memory/RttiScanner.hpp"
 
 #include <glm/glm.hpp>
 
+#include <algorithm>
 #include <cctype>
 #include <cstddef>
 #include <cstdint>
@@ -403,6 +406,98 @@ sol::object moduleBaseAsObject(sol::state_view              lua,
   return sol::make_object(lua, moduleBase.value());
 }
 
+// Vftables named by a Lua value: one address, an array of addresses, or a class name resolved
+// through an RTTI scan (matching the whole demangled name or its last `::` component). With
+// `subclasses`, the vftables of every class deriving from the named ones are added.
+std::vector<std::uintptr_t> vftablesFromObject(const memory::MemoryReader& reader,
+                                               const sol::object&          target,
+                                               bool                        subclasses) {
+  std::vector<std::uintptr_t> vftables;
+  std::string                 name;
+  switch (target.get_type()) {
+    case sol::type::number:
+      vftables.push_back(target.as<std::uintptr_t>());
+      break;
+    case sol::type::table:
+      for (const auto& [key, value] : target.as<sol::table>()) {
+        (void)key;
+        if (value.get_type() == sol::type::number) {
+          vftables.push_back(value.as<std::uintptr_t>());
+        }
+      }
+      break;
+    case sol::type::string:
+      name = target.as<std::string>();
+      break;
+    default:
+      return vftables;
+  }
+  if (name.empty() && !subclasses) {
+    return vftables;
+  }
+
+  const memory::RttiScanner scanner(&reader);
+  auto                      hierarchy = scanner.extract_hierarchy(scanner.find_all());
+
+  std::vector<std::size_t> roots;
+  if (!name.empty()) {
+    roots = hierarchy.findByName(name);
+  } else {
+    for (std::size_t i = 0; i < hierarchy.size(); ++i) {
+      const auto& own = hierarchy[i].vftables;
+      if (std::any_of(own.begin(), own.end(), [&vftables](std::uintptr_t vftable) {
+            return std::find(vftables.begin(), vftables.end(), vftable) != vftables.end();
+          })) {
+        roots.push_back(i);
+      }
+    }
+  }
+
+  for (const std::size_t root : roots) {
+    const auto more = hierarchy.vftablesOf(root, subclasses);
+    vftables.insert(vftables.end(), more.begin(), more.end());
+  }
+  return vftables;
+}
+
+// memory.find_instances(target [, { sorted = bool, max = n, heap_only = bool, subclasses = bool,
+//                                   pid = n }])
+// returns an array of object addresses whose first slot is one of the target's vftables.
+sol::object findInstancesAsObject(sol::state_view                lua,
+                                  const sol::object&             target,
+                                  const sol::optional<sol::table>& options) {
+  const std::uint32_t processId =
+      resolveProcessId(options ? options->get_or("pid", std::uint32_t{0}) : std::uint32_t{0});
+  if (processId == 0) {
+    return sol::make_object(lua, sol::lua_nil);
+  }
+
+  memory::MemoryReader reader;
+  if (!reader.attach(processId)) {
+    return sol::make_object(lua, sol::lua_nil);
+  }
+
+  const bool subclasses = options ? options->get_or("subclasses", false) : false;
+  const auto vftables   = vftablesFromObject(reader, target, subclasses);
+  if (vftables.empty()) {
+    return sol::make_object(lua, lua.create_table());
+  }
+
+  memory::InstanceFinder::ScanOptions scanOptions;
+  if (options) {
+    scanOptions.sort_by_address = options->get_or("sorted", false);
+    scanOptions.heap_only       = options->get_or("heap_only", true);
+    scanOptions.max_results     = options->get_or("max", std::size_t{0});
+  }
+
+  const auto instances = memory::InstanceFinder(&reader).find_all(vftables, scanOptions);
+  sol::table result    = lua.create_table(static_cast<int>(instances.size()), 0);
+  for (std::size_t i = 0; i < instances.size(); ++i) {
+    result[i + 1] = instances[i].address;
+  }
+  return sol::make_object(lua, result);
+}
+
 }  // namespace
 
 void registerMemoryReadFunctions(sol::state& lua) {
@@ -434,6 +529,12 @@ void registerMemoryReadFunctions(sol::state& lua) {
 
   memoryTable["read_type"]  = memoryTable["read"];
   memoryTable["read_typed"] = memoryTable["read"];
+
+  memoryTable.set_function(
+      "find_instances",
+      [state](const sol::object& target, sol::optional<sol::table> options) -> sol::object {
+        return findInstancesAsObject(state, target, options);
+      });
 }
 
 }  // namespace farcal::luavm::bindings
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+
+#ifdef _WIN32
+#  ifndef WIN32_LEAN_AND_MEAN
+#    define WIN32_LEAN_AND_MEAN
+#  endif
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace farcal::memory::detail {
+
+// Read-only view of a whole file. Shared ownership lets several result sets borrow columns from
+// the same mapping; the view is released with the last owner.
+class MappedFile final {
+ public:
+  MappedFile(const MappedFile&)            = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  ~MappedFile() {
+#ifdef _WIN32
+    if (m_data != nullptr) {
+      ::UnmapViewOfFile(m_data);
+    }
+    if (m_mapping != nullptr) {
+      ::CloseHandle(m_mapping);
+    }
+    if (m_file != INVALID_HANDLE_VALUE) {
+      ::CloseHandle(m_file);
+    }
+#else
+    if (m_data != nullptr) {
+      ::munmap(const_cast<std::uint8_t*>(m_data), m_size);
+    }
+#endif
+  }
+
+  [[nodiscard]] static std::shared_ptr<const MappedFile> open(const std::filesystem::path& path) {
+    std::shared_ptr<MappedFile> file(new MappedFile());
+
+#ifdef _WIN32
+    file->m_file = ::CreateFileW(path.c_str(),
+                                 GENERIC_READ,
+                                 FILE_SHARE_READ,
+                                 nullptr,
+                                 OPEN_EXISTING,
+                                 FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS,
+                                 nullptr);
+    if (file->m_file == INVALID_HANDLE_VALUE) {
+      return nullptr;
+    }
+
+    LARGE_INTEGER size{};
+    if (!::GetFileSizeEx(file->m_file, &size) || size.QuadPart <= 0) {
+      return nullptr;
+    }
+    file->m_size = static_cast<std::size_t>(size.QuadPart);
+
+    file->m_mapping = ::CreateFileMappingW(file->m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (file->m_mapping == nullptr) {
+      return nullptr;
+    }
+
+    file->m_data =
+        static_cast<const std::uint8_t*>(::MapViewOfFile(file->m_mapping, FILE_MAP_READ, 0, 0, 0));
+    if (file->m_data == nullptr) {
+      return nullptr;
+    }
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      return nullptr;
+    }
+
+    struct stat info{};
+    if (::fstat(fd, &info) != 0 || info.st_size <= 0) {
+      ::close(fd);
+      return nullptr;
+    }
+    file->m_size = static_cast<std::size_t>(info.st_size);
+
+    void* data = ::mmap(nullptr, file->m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) {
+      return nullptr;
+    }
+    file->m_data = static_cast<const std::uint8_t*>(data);
+#endif
+
+    return file;
+  }
+
+  [[nodiscard]] const std::uint8_t* data() const noexcept { return m_data; }
+  [[nodiscard]] std::size_t         size() const noexcept { return m_size; }
+
+ private:
+  MappedFile() = default;
+
+  const std::uint8_t* m_data = nullptr;
+  std::size_t         m_size = 0;
+#ifdef _WIN32
+  HANDLE m_file    = INVALID_HANDLE_VALUE;
+  HANDLE m_mapping = nullptr;
+#endif
+};
+
+} // namespace farcal::memory::detail
@@ -1,23 +1,15 @@
 #include "farcal/memory/ProcessMemoryScanner.hpp"
+#include "farcal/memory/MemoryRegions.hpp"
+
+#include "ScanKernels.hpp"
 
 #include <algorithm>
-#include <cctype>
-#include <cmath>
+#include <chrono>
 #include <cstring>
 #include <limits>
 #include <string_view>
 #include <type_traits>
 
-#ifdef _WIN32
-#ifndef WIN32_LEAN_AND_MEAN
-#define WIN32_LEAN_AND_MEAN
-#endif
-#ifndef NOMINMAX
-#define NOMINMAX
-#endif
-#include <windows.h>
-#endif
-
 namespace farcal::memory {
 namespace {
 
@@ -58,32 +50,125 @@ void appendValueBytes(T value, std::vector<std::uint8_t>& outBytes) {
   std::memcpy(outBytes.data(), &value, sizeof(T));
 }
 
-bool equalCaseInsensitiveAscii(const std::vector<std::uint8_t>& left,
-                               const std::vector<std::uint8_t>& right) {
-  if (left.size() != right.size()) {
-    return false;
-  }
+// Throttles progress and partial-result notifications so a fast scan does not flood the receiving
+// thread, and derives throughput and ETA from the bytes processed so far.
+class ScanReporter {
+ public:
+  ScanReporter(const ProcessMemoryScanner::Observer& observer, std::uint64_t bytesTotal)
+      : m_observer(observer), m_bytesTotal(bytesTotal), m_start(Clock::now()), m_lastReport(m_start) {}
 
-  for (std::size_t i = 0; i < left.size(); ++i) {
-    const unsigned char l = static_cast<unsigned char>(left[i]);
-    const unsigned char r = static_cast<unsigned char>(right[i]);
-    if (std::tolower(l) != std::tolower(r)) {
-      return false;
+  void advance(std::uint64_t bytes, const ScanResultSet& results, bool force = false) {
+    m_bytesDone = std::min(m_bytesTotal, m_bytesDone + bytes);
+
+    const auto now = Clock::now();
+    if (!force && now - m_lastReport < kReportInterval) {
+      return;
+    }
+    m_lastReport = now;
+
+    if (m_observer.results && results.size() > m_published) {
+      m_observer.results(results, m_published);
+      m_published = results.size();
+    }
+
+    if (m_observer.progress) {
+      const double elapsed = std::chrono::duration<double>(now - m_start).count();
+
+      ScanProgress progress;
+      progress.bytesDone      = m_bytesDone;
+      progress.bytesTotal     = m_bytesTotal;
+      progress.resultCount    = results.size();
+      progress.bytesPerSecond = elapsed > 0.0 ? static_cast<double>(m_bytesDone) / elapsed : 0.0;
+      progress.etaSeconds     = progress.bytesPerSecond > 0.0
+                                    ? static_cast<double>(m_bytesTotal - m_bytesDone)
+                                          / progress.bytesPerSecond
+                                    : 0.0;
+      m_observer.progress(progress);
     }
   }
-  return true;
+
+ private:
+  using Clock = std::chrono::steady_clock;
+  static constexpr auto kReportInterval = std::chrono::milliseconds(50);
+
+  const ProcessMemoryScanner::Observer& m_observer;
+  std::uint64_t                         m_bytesTotal = 0;
+  std::uint64_t                         m_bytesDone  = 0;
+  std::size_t                           m_published  = 0;
+  Clock::time_point                     m_start;
+  Clock::time_point                     m_lastReport;
+};
+
+} // namespace
+
+void ScanResultSet::clear() noexcept {
+  m_addresses.clear();
+  m_previous.clear();
+  m_current.clear();
+  m_mapped.reset();
 }
 
-template <typename T>
-bool readValue(const std::vector<std::uint8_t>& bytes, T& outValue) {
-  if (bytes.size() != sizeof(T)) {
-    return false;
+void ScanResultSet::reset(std::size_t valueSize) {
+  clear();
+  m_valueSize = valueSize;
+}
+
+void ScanResultSet::reserve(std::size_t count) {
+  detach();
+  m_addresses.reserve(count);
+  m_previous.reserve(count * m_valueSize);
+  m_current.reserve(count * m_valueSize);
+}
+
+void ScanResultSet::push(std::uintptr_t      address,
+                         const std::uint8_t* previous,
+                         const std::uint8_t* current) {
+  detach();
+  m_addresses.push_back(address);
+  m_previous.insert(m_previous.end(), previous, previous + m_valueSize);
+  m_current.insert(m_current.end(), current, current + m_valueSize);
+}
+
+std::span<const std::uint8_t> ScanResultSet::previousValue(std::size_t index) const {
+  return previousColumn().subspan(index * m_valueSize, m_valueSize);
+}
+
+std::span<const std::uint8_t> ScanResultSet::currentValue(std::size_t index) const {
+  return currentColumn().subspan(index * m_valueSize, m_valueSize);
+}
+
+std::span<const std::uintptr_t> ScanResultSet::addresses() const noexcept {
+  if (m_mapped.has_value()) {
+    return {m_mapped->addresses, m_mapped->count};
   }
-  std::memcpy(&outValue, bytes.data(), sizeof(T));
-  return true;
+  return m_addresses;
 }
 
-} // namespace
+std::span<const std::uint8_t> ScanResultSet::previousColumn() const noexcept {
+  if (m_mapped.has_value()) {
+    return {m_mapped->previous, m_mapped->count * m_valueSize};
+  }
+  return m_previous;
+}
+
+std::span<const std::uint8_t> ScanResultSet::currentColumn() const noexcept {
+  if (m_mapped.has_value()) {
+    return {m_mapped->current, m_mapped->count * m_valueSize};
+  }
+  return m_current;
+}
+
+void ScanResultSet::detach() {
+  if (!m_mapped.has_value()) {
+    return;
+  }
+
+  const MappedColumns mapped = std::move(*m_mapped);
+  m_mapped.reset();
+  m_addresses.assign(mapped.addresses, mapped.addresses + mapped.count);
+  m_previous.assign(mapped.previous, mapped.previous + (mapped.count * m_valueSize));
+  m_current.assign(mapped.current, mapped.current + (mapped.count * m_valueSize));
+}
 
 ProcessMemoryScanner::ProcessMemoryScanner(const MemoryReader* reader) : m_reader(reader) {}
 
@@ -99,8 +184,9 @@ void ProcessMemoryScanner::reset() {
 
 bool ProcessMemoryScanner::firstScan(const ScanSettings& settings,
                                      const std::string&  query,
-                                     ProgressCallback    progress) {
+                                     const Observer&     observer) {
   m_lastError.clear();
+  m_lastScanCancelled = false;
   if (m_reader == nullptr || !m_reader->attached()) {
     m_lastError = "No process attached.";
     return false;
@@ -127,8 +213,8 @@ bool ProcessMemoryScanner::firstScan(const ScanSettings& settings,
     return false;
   }
 
-  std::vector<ScanEntry> newResults;
-  if (!scanAllRegionsExact(settings, regions, queryBytes, newResults, progress)) {
+  ScanResultSet newResults;
+  if (!scanAllRegionsExact(settings, regions, queryBytes, newResults, observer)) {
     if (m_lastError.empty()) {
       m_lastError = "Failed to scan process memory.";
     }
@@ -143,8 +229,9 @@ bool ProcessMemoryScanner::firstScan(const ScanSettings& settings,
 
 bool ProcessMemoryScanner::nextScan(const ScanSettings& settings,
                                     const std::string&  query,
-                                    ProgressCallback    progress) {
+                                    const Observer&     observer) {
   m_lastError.clear();
+  m_lastScanCancelled = false;
   if (m_reader == nullptr || !m_reader->attached()) {
     m_lastError = "No process attached.";
     return false;
@@ -170,24 +257,75 @@ bool ProcessMemoryScanner::nextScan(const ScanSettings& settings,
     }
   }
 
-  m_history.push_back(m_results);
-  if (!rescanExisting(settings, queryBytes, progress)) {
-    if (m_history.empty()) {
-      m_results.clear();
-    } else {
-      m_results = m_history.back();
-      m_history.pop_back();
-    }
+  ScanResultSet newResults;
+  if (!rescanExisting(settings, queryBytes, newResults, observer)) {
     if (m_lastError.empty()) {
       m_lastError = "Failed to perform Next Scan.";
     }
     return false;
   }
 
+  m_history.push_back(std::move(m_results));
+  m_results = std::move(newResults);
   m_lastSettings = settings;
   return true;
 }
 
+bool ProcessMemoryScanner::pointerScan(const PointerScanSettings& settings, const Observer& observer) {
+  m_lastError.clear();
+  m_lastScanCancelled = false;
+  if (m_reader == nullptr || !m_reader->attached()) {
+    m_lastError = "No process attached.";
+    return false;
+  }
+
+  if (settings.targetAddress == 0) {
+    m_lastError = "Pointer scan target address is zero.";
+    return false;
+  }
+
+  const std::uintptr_t high = settings.targetAddress;
+  const std::uintptr_t low =
+      settings.maxOffset >= high ? std::uintptr_t{1} : high - static_cast<std::uintptr_t>(settings.maxOffset);
+
+  std::vector<std::uint8_t> queryBytes(sizeof(std::uintptr_t) * 2);
+  std::memcpy(queryBytes.data(), &low, sizeof(low));
+  std::memcpy(queryBytes.data() + sizeof(low), &high, sizeof(high));
+
+  std::vector<Region> regions;
+  if (!collectReadableRegions(settings.includeReadOnly, regions)) {
+    if (m_lastError.empty()) {
+      m_lastError = "Failed to enumerate readable memory regions.";
+    }
+    return false;
+  }
+
+  ScanResultSet newResults;
+  if (!scanRegions(regions,
+                   &detail::firstScanPointerRange,
+                   queryBytes,
+                   sizeof(std::uintptr_t),
+                   newResults,
+                   observer)) {
+    if (m_lastError.empty()) {
+      m_lastError = "Failed to scan process memory.";
+    }
+    return false;
+  }
+
+  ScanSettings resultSettings;
+  resultSettings.scanType        = ScanType::ExactValue;
+  resultSettings.valueType       = sizeof(std::uintptr_t) == 8 ? ScanValueType::Int64 : ScanValueType::Int32;
+  resultSettings.hexInput        = true;
+  resultSettings.includeReadOnly = settings.includeReadOnly;
+  resultSettings.alignment       = sizeof(std::uintptr_t);
+
+  m_history.clear();
+  m_results      = std::move(newResults);
+  m_lastSettings = resultSettings;
+  return true;
+}
+
 bool ProcessMemoryScanner::undo() {
   if (m_history.empty()) {
     m_lastError = "Nothing to undo.";
@@ -200,7 +338,7 @@ bool ProcessMemoryScanner::undo() {
   return true;
 }
 
-const std::vector<ScanEntry>& ProcessMemoryScanner::results() const noexcept {
+const ScanResultSet& ProcessMemoryScanner::results() const noexcept {
   return m_results;
 }
 
@@ -216,66 +354,34 @@ const std::string& ProcessMemoryScanner::lastError() const noexcept {
   return m_lastError;
 }
 
+bool ProcessMemoryScanner::lastScanCancelled() const noexcept {
+  return m_lastScanCancelled;
+}
+
+bool ProcessMemoryScanner::checkCancelled(const Observer& observer) {
+  if (!observer.stopToken.stop_requested()) {
+    return false;
+  }
+  m_lastScanCancelled = true;
+  m_lastError = "Scan cancelled.";
+  return true;
+}
+
 bool ProcessMemoryScanner::collectReadableRegions(bool includeReadOnly, std::vector<Region>& outRegions) {
-#ifndef _WIN32
-  (void)includeReadOnly;
-  (void)outRegions;
-  m_lastError = "Only implemented on Windows.";
-  return false;
-#else
   outRegions.clear();
   if (m_reader == nullptr || !m_reader->attached()) {
     m_lastError = "No process attached.";
     return false;
   }
 
-  const HANDLE process = m_reader->process().nativeHandle();
-  if (process == nullptr) {
-    m_lastError = "Invalid process handle.";
-    return false;
-  }
-
-  SYSTEM_INFO systemInfo{};
-  ::GetSystemInfo(&systemInfo);
-
-  std::uintptr_t address = reinterpret_cast<std::uintptr_t>(systemInfo.lpMinimumApplicationAddress);
-  const std::uintptr_t maxAddress =
-      reinterpret_cast<std::uintptr_t>(systemInfo.lpMaximumApplicationAddress);
-
-  while (address < maxAddress) {
-    MEMORY_BASIC_INFORMATION mbi{};
-    const SIZE_T queried = ::VirtualQueryEx(process, reinterpret_cast<LPCVOID>(address), &mbi, sizeof(mbi));
-    if (queried == 0) {
-      break;
-    }
-
-    const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(mbi.BaseAddress);
-    const std::uintptr_t next = base + static_cast<std::uintptr_t>(mbi.RegionSize);
-    const DWORD protect = mbi.Protect & 0xFF;
-
-    const bool committed = (mbi.State == MEM_COMMIT);
-    const bool guarded = (mbi.Protect & PAGE_GUARD) != 0;
-    const bool noAccess = (mbi.Protect & PAGE_NOACCESS) != 0;
-    const bool readable =
-        protect == PAGE_READONLY || protect == PAGE_READWRITE || protect == PAGE_WRITECOPY
-        || protect == PAGE_EXECUTE_READ || protect == PAGE_EXECUTE_READWRITE
-        || protect == PAGE_EXECUTE_WRITECOPY;
-    const bool isReadOnlyPage = (protect == PAGE_READONLY || protect == PAGE_EXECUTE_READ);
-    const bool allowedByReadOnlyToggle = includeReadOnly || !isReadOnlyPage;
-
-    if (committed && !guarded && !noAccess && readable && allowedByReadOnlyToggle
-        && mbi.RegionSize >= 1) {
-      outRegions.push_back({base, static_cast<std::size_t>(mbi.RegionSize)});
+  for (const MemoryRegion& region : queryMemoryRegions(*m_reader)) {
+    const bool allowedByReadOnlyToggle = includeReadOnly || region.writable;
+    if (region.readable && allowedByReadOnlyToggle && region.size >= 1) {
+      outRegions.push_back({region.base, region.size});
     }
-
-    if (next <= address) {
-      break;
-    }
-    address = next;
   }
 
   return true;
-#endif
 }
 
 bool ProcessMemoryScanner::buildQueryBytes(const ScanSettings& settings,
@@ -361,8 +467,8 @@ bool ProcessMemoryScanner::buildQueryBytes(const ScanSettings& settings,
 bool ProcessMemoryScanner::scanAllRegionsExact(const ScanSettings&             settings,
                                                const std::vector<Region>&      regions,
                                                const std::vector<std::uint8_t>& queryBytes,
-                                               std::vector<ScanEntry>&         outEntries,
-                                               const ProgressCallback&          progress) {
+                                               ScanResultSet&                  outEntries,
+                                               const Observer&                 observer) {
   if (queryBytes.empty()) {
     m_lastError = "Query bytes are empty.";
     return false;
@@ -372,28 +478,48 @@ bool ProcessMemoryScanner::scanAllRegionsExact(const ScanSettings&             s
     return false;
   }
 
-  outEntries.clear();
+  const detail::FirstScanKernel kernel = detail::selectFirstScanKernel(settings);
+  if (kernel == nullptr) {
+    m_lastError = "Unsupported scan alignment.";
+    return false;
+  }
+
+  return scanRegions(regions, kernel, queryBytes, queryBytes.size(), outEntries, observer);
+}
+
+template <typename Kernel>
+bool ProcessMemoryScanner::scanRegions(const std::vector<Region>&       regions,
+                                       Kernel                           kernel,
+                                       const std::vector<std::uint8_t>& queryBytes,
+                                       std::size_t                      valueSize,
+                                       ScanResultSet&                   outEntries,
+                                       const Observer&                  observer) {
+  outEntries.reset(valueSize);
 
   constexpr std::size_t kChunkSize = 1u << 20u;
-  const std::size_t valueSize = queryBytes.size();
-  const std::size_t alignment = std::max<std::size_t>(1, settings.alignment);
   std::vector<std::uint8_t> buffer;
   buffer.resize(kChunkSize + valueSize);
+  std::vector<std::uintptr_t> matches(kChunkSize + 1);
 
-  for (std::size_t regionIndex = 0; regionIndex < regions.size(); ++regionIndex) {
-    const Region& region = regions[regionIndex];
+  std::uint64_t totalBytes = 0;
+  for (const Region& region : regions) {
+    totalBytes += region.size;
+  }
+  ScanReporter reporter(observer, totalBytes);
 
+  for (const Region& region : regions) {
     std::size_t regionOffset = 0;
     while (regionOffset < region.size) {
+      if (checkCancelled(observer)) {
+        return false;
+      }
+
       const std::size_t remaining = region.size - regionOffset;
       const std::size_t bytesToRead = std::min(buffer.size(), remaining);
       const std::uintptr_t chunkAddress = region.base + regionOffset;
 
-      if (!m_reader->readBytes(chunkAddress, buffer.data(), bytesToRead)) {
-        break;
-      }
-
-      if (bytesToRead < valueSize) {
+      if (!m_reader->readBytes(chunkAddress, buffer.data(), bytesToRead) || bytesToRead < valueSize) {
+        reporter.advance(remaining, outEntries);
         break;
       }
 
@@ -402,94 +528,141 @@ bool ProcessMemoryScanner::scanAllRegionsExact(const ScanSettings&             s
         scanLimit = std::min(scanLimit, kChunkSize);
       }
 
-      for (std::size_t offset = 0; offset < scanLimit; ++offset) {
-        const std::uintptr_t address = chunkAddress + offset;
-        if ((address % alignment) != 0) {
-          continue;
-        }
-
-        if (settings.valueType == ScanValueType::String && !settings.caseSensitive) {
-          std::vector<std::uint8_t> candidate(valueSize);
-          std::memcpy(candidate.data(), buffer.data() + offset, valueSize);
-          if (!equalCaseInsensitiveAscii(candidate, queryBytes)) {
-            continue;
-          }
-        } else if (std::memcmp(buffer.data() + offset, queryBytes.data(), valueSize) != 0) {
-          continue;
-        }
-
-        ScanEntry entry;
-        entry.address = address;
-        entry.previousValue.assign(buffer.begin() + static_cast<std::ptrdiff_t>(offset),
-                                   buffer.begin() + static_cast<std::ptrdiff_t>(offset + valueSize));
-        entry.currentValue = entry.previousValue;
-        outEntries.push_back(std::move(entry));
+      const std::size_t found =
+          kernel(buffer.data(), scanLimit, chunkAddress, queryBytes.data(), valueSize, matches.data());
+      for (std::size_t i = 0; i < found; ++i) {
+        const std::uint8_t* value = buffer.data() + (matches[i] - chunkAddress);
+        outEntries.push(matches[i], value, value);
       }
 
+      reporter.advance(std::min(kChunkSize, remaining), outEntries);
       regionOffset += kChunkSize;
     }
-
-    if (progress) {
-      progress(regionIndex + 1, regions.size());
-    }
   }
 
+  reporter.advance(0, outEntries, true);
   return true;
 }
 
 bool ProcessMemoryScanner::rescanExisting(const ScanSettings&             settings,
                                           const std::vector<std::uint8_t>& queryBytes,
-                                          const ProgressCallback&          progress) {
+                                          ScanResultSet&                  outEntries,
+                                          const Observer&                 observer) {
   if (m_reader == nullptr || !m_reader->attached()) {
     m_lastError = "No process attached.";
     return false;
   }
 
-  std::vector<ScanEntry> filtered;
-  filtered.reserve(m_results.size());
+  const detail::NextScanKernel kernel = detail::selectNextScanKernel(settings);
+  if (kernel == nullptr) {
+    m_lastError = "Unsupported scan type.";
+    return false;
+  }
 
-  for (std::size_t i = 0; i < m_results.size(); ++i) {
-    const ScanEntry& oldEntry = m_results[i];
-    const std::size_t valueSize = valueSizeFromSettings(
-        settings,
-        (settings.scanType == ScanType::ExactValue && settings.valueType == ScanValueType::String)
-            ? queryBytes.size()
-            : oldEntry.currentValue.size());
+  const std::size_t count   = m_results.size();
+  const std::size_t oldSize = m_results.valueSize();
+  const std::size_t valueSize = valueSizeFromSettings(
+      settings,
+      (settings.scanType == ScanType::ExactValue && settings.valueType == ScanValueType::String)
+          ? queryBytes.size()
+          : oldSize);
 
-    if (valueSize == 0) {
-      continue;
-    }
+  outEntries.reset(valueSize);
+  if (valueSize == 0 || count == 0) {
+    return true;
+  }
 
-    std::vector<std::uint8_t> current(valueSize);
-    if (!m_reader->readBytes(oldEntry.address, current.data(), valueSize)) {
-      if (progress) {
-        progress(i + 1, m_results.size());
-      }
-      continue;
+  // Entries are processed in blocks so the gathered columns stay small, cancellation is checked
+  // regularly and survivors can be published while the scan is still running.
+  constexpr std::size_t kBlockEntries = 64u * 1024u;
+  const std::size_t     blockEntries  = std::min(count, kBlockEntries);
+
+  std::vector<std::uint8_t> previous(blockEntries * valueSize);
+  std::vector<std::uint8_t> current(blockEntries * valueSize);
+  std::vector<std::uint8_t> readable(blockEntries);
+  std::vector<std::size_t>  survivors(blockEntries);
+
+  ScanReporter reporter(observer, static_cast<std::uint64_t>(count) * valueSize);
+
+  for (std::size_t first = 0; first < count; first += blockEntries) {
+    if (checkCancelled(observer)) {
+      return false;
     }
 
-    if (!matchesCondition(settings, queryBytes, oldEntry.currentValue, current)) {
-      if (progress) {
-        progress(i + 1, m_results.size());
+    const std::size_t blockCount = std::min(blockEntries, count - first);
+
+    // A string exact scan may change the compared length; the previous column is then truncated
+    // or zero-padded to the new width so every column keeps a single stride.
+    const std::uint8_t* oldValues = m_results.currentColumn().data() + (first * oldSize);
+    if (valueSize == oldSize) {
+      std::memcpy(previous.data(), oldValues, blockCount * valueSize);
+    } else {
+      std::fill(previous.begin(), previous.end(), std::uint8_t{0});
+      const std::size_t copied = std::min(oldSize, valueSize);
+      for (std::size_t i = 0; i < blockCount; ++i) {
+        std::memcpy(previous.data() + (i * valueSize), oldValues + (i * oldSize), copied);
       }
-      continue;
     }
 
-    ScanEntry newEntry;
-    newEntry.address = oldEntry.address;
-    newEntry.previousValue = oldEntry.currentValue;
-    newEntry.currentValue = std::move(current);
-    filtered.push_back(std::move(newEntry));
-
-    if (progress) {
-      progress(i + 1, m_results.size());
+    const std::uintptr_t* addresses = m_results.addresses().data() + first;
+    gatherValues(addresses, blockCount, valueSize, current.data(), readable.data());
+
+    const std::size_t kept = kernel(previous.data(),
+                                    current.data(),
+                                    readable.data(),
+                                    blockCount,
+                                    queryBytes.data(),
+                                    valueSize,
+                                    survivors.data());
+    for (std::size_t i = 0; i < kept; ++i) {
+      const std::size_t index = survivors[i];
+      outEntries.push(addresses[index],
+                      previous.data() + (index * valueSize),
+                      current.data() + (index * valueSize));
     }
+
+    reporter.advance(static_cast<std::uint64_t>(blockCount) * valueSize, outEntries);
   }
 
-  m_results = std::move(filtered);
+  reporter.advance(0, outEntries, true);
   return true;
 }
 
+void ProcessMemoryScanner::gatherValues(const std::uintptr_t* addresses,
+                                        std::size_t           count,
+                                        std::size_t           valueSize,
+                                        std::uint8_t*         outValues,
+                                        std::uint8_t*         outReadable) const {
+  // Result addresses are ascending, so neighbouring entries are fetched with one read per window
+  // instead of one read per entry. Windows that straddle unreadable pages fall back to single reads.
+  constexpr std::size_t kWindowSize = 64u * 1024u;
+  std::vector<std::uint8_t> window(kWindowSize);
+
+  std::size_t first = 0;
+  while (first < count) {
+    const std::uintptr_t windowStart = addresses[first];
+    std::size_t          last        = first + 1;
+    while (last < count && addresses[last] >= addresses[last - 1]
+           && addresses[last] - windowStart + valueSize <= kWindowSize) {
+      ++last;
+    }
+
+    const std::size_t span = static_cast<std::size_t>(addresses[last - 1] - windowStart) + valueSize;
+    if (span <= kWindowSize && m_reader->readBytes(windowStart, window.data(), span)) {
+      for (std::size_t i = first; i < last; ++i) {
+        std::memcpy(outValues + (i * valueSize), window.data() + (addresses[i] - windowStart), valueSize);
+        outReadable[i] = 1;
+      }
+    } else {
+      for (std::size_t i = first; i < last; ++i) {
+        outReadable[i] = m_reader->readBytes(addresses[i], outValues + (i * valueSize), valueSize) ? 1 : 0;
+      }
+    }
+
+    first = last;
+  }
+}
+
 std::size_t ProcessMemoryScanner::valueSizeFromSettings(const ScanSettings& settings,
                                                         std::size_t         queryByteLength) {
   switch (settings.valueType) {
@@ -509,107 +682,4 @@ std::size_t ProcessMemoryScanner::valueSizeFromSettings(const ScanSettings& sett
   return 0;
 }
 
-bool ProcessMemoryScanner::isNumericType(ScanValueType valueType) {
-  return valueType != ScanValueType::String;
-}
-
-bool ProcessMemoryScanner::matchesCondition(const ScanSettings&             settings,
-                                            const std::vector<std::uint8_t>& queryBytes,
-                                            const std::vector<std::uint8_t>& previous,
-                                            const std::vector<std::uint8_t>& current) const {
-  switch (settings.scanType) {
-    case ScanType::ExactValue:
-      if (settings.valueType == ScanValueType::String && !settings.caseSensitive) {
-        return equalCaseInsensitiveAscii(current, queryBytes);
-      }
-      return current == queryBytes;
-
-    case ScanType::ChangedValue:
-      return current != previous;
-
-    case ScanType::UnchangedValue:
-      return current == previous;
-
-    case ScanType::IncreasedValue:
-      if (!isNumericType(settings.valueType)) {
-        return false;
-      }
-      switch (settings.valueType) {
-        case ScanValueType::Int8:
-          return compareNumeric<std::int8_t>(settings.scanType, previous, current);
-        case ScanValueType::Int16:
-          return compareNumeric<std::int16_t>(settings.scanType, previous, current);
-        case ScanValueType::Int32:
-          return compareNumeric<std::int32_t>(settings.scanType, previous, current);
-        case ScanValueType::Int64:
-          return compareNumeric<std::int64_t>(settings.scanType, previous, current);
-        case ScanValueType::Float:
-          return compareNumeric<float>(settings.scanType, previous, current);
-        case ScanValueType::Double:
-          return compareNumeric<double>(settings.scanType, previous, current);
-        case ScanValueType::String:
-          return false;
-      }
-      return false;
-
-    case ScanType::DecreasedValue:
-      if (!isNumericType(settings.valueType)) {
-        return false;
-      }
-      switch (settings.valueType) {
-        case ScanValueType::Int8:
-          return compareNumeric<std::int8_t>(settings.scanType, previous, current);
-        case ScanValueType::Int16:
-          return compareNumeric<std::int16_t>(settings.scanType, previous, current);
-        case ScanValueType::Int32:
-          return compareNumeric<std::int32_t>(settings.scanType, previous, current);
-        case ScanValueType::Int64:
-          return compareNumeric<std::int64_t>(settings.scanType, previous, current);
-        case ScanValueType::Float:
-          return compareNumeric<float>(settings.scanType, previous, current);
-        case ScanValueType::Double:
-          return compareNumeric<double>(settings.scanType, previous, current);
-        case ScanValueType::String:
-          return false;
-      }
-      return false;
-  }
-
-  return false;
-}
-
-bool ProcessMemoryScanner::compareAsString(const ScanSettings&             settings,
-                                           const std::vector<std::uint8_t>& left,
-                                           const std::vector<std::uint8_t>& right) const {
-  if (settings.caseSensitive) {
-    return left == right;
-  }
-  return equalCaseInsensitiveAscii(left, right);
-}
-
-template <typename T>
-bool ProcessMemoryScanner::compareNumeric(ScanType scanType,
-                                          const std::vector<std::uint8_t>& previous,
-                                          const std::vector<std::uint8_t>& current) {
-  T previousValue{};
-  T currentValue{};
-  if (!readValue(previous, previousValue) || !readValue(current, currentValue)) {
-    return false;
-  }
-
-  if constexpr (std::is_floating_point_v<T>) {
-    if (std::isnan(previousValue) || std::isnan(currentValue)) {
-      return false;
-    }
-  }
-
-  if (scanType == ScanType::IncreasedValue) {
-    return currentValue > previousValue;
-  }
-  if (scanType == ScanType::DecreasedValue) {
-    return currentValue < previousValue;
-  }
-  return false;
-}
-
 } // namespace farcal::memory
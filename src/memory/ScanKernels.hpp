@@ -0,0 +1,337 @@
+#pragma once
+
+#include "farcal/memory/ProcessMemoryScanner.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+namespace farcal::memory::detail {
+
+// Scan kernels are instantiated per <ScanValueType, ScanType, Alignment> and picked once per scan
+// through the tables below, so the per-candidate loops carry no settings switches at all.
+
+inline constexpr std::size_t kMaxScanAlignment = 16;
+
+template <ScanValueType V>
+struct ValueTraits;
+
+template <>
+struct ValueTraits<ScanValueType::Int8> {
+  using type = std::int8_t;
+  using bits = std::uint8_t;
+};
+template <>
+struct ValueTraits<ScanValueType::Int16> {
+  using type = std::int16_t;
+  using bits = std::uint16_t;
+};
+template <>
+struct ValueTraits<ScanValueType::Int32> {
+  using type = std::int32_t;
+  using bits = std::uint32_t;
+};
+template <>
+struct ValueTraits<ScanValueType::Int64> {
+  using type = std::int64_t;
+  using bits = std::uint64_t;
+};
+template <>
+struct ValueTraits<ScanValueType::Float> {
+  using type = float;
+  using bits = std::uint32_t;
+};
+template <>
+struct ValueTraits<ScanValueType::Double> {
+  using type = double;
+  using bits = std::uint64_t;
+};
+
+template <typename T>
+[[nodiscard]] inline T loadValue(const std::uint8_t* bytes) noexcept {
+  T value;
+  std::memcpy(&value, bytes, sizeof(T));
+  return value;
+}
+
+[[nodiscard]] constexpr std::uint8_t foldAscii(std::uint8_t ch) noexcept {
+  return static_cast<std::uint8_t>(ch | ((static_cast<std::uint8_t>(ch - 'A') < 26u) ? 0x20u : 0u));
+}
+
+[[nodiscard]] inline bool equalFoldedAscii(const std::uint8_t* left,
+                                           const std::uint8_t* right,
+                                           std::size_t         size) noexcept {
+  std::uint8_t diff = 0;
+  for (std::size_t i = 0; i < size; ++i) {
+    diff |= static_cast<std::uint8_t>(foldAscii(left[i]) ^ foldAscii(right[i]));
+  }
+  return diff == 0;
+}
+
+template <std::size_t Alignment>
+[[nodiscard]] constexpr std::size_t firstAlignedOffset(std::uintptr_t base) noexcept {
+  const std::size_t misalignment = static_cast<std::size_t>(base % Alignment);
+  return misalignment == 0 ? 0 : Alignment - misalignment;
+}
+
+// First scan: walks `scanLimit` candidate offsets of `data` (which starts at `base`) and writes the
+// address of every match to `outAddresses`. The output must hold scanLimit / Alignment + 1 slots;
+// every candidate is stored and the cursor only advances on a match, which keeps the loop free of
+// data-dependent branches.
+using FirstScanKernel = std::size_t (*)(const std::uint8_t* data,
+                                        std::size_t         scanLimit,
+                                        std::uintptr_t      base,
+                                        const std::uint8_t* query,
+                                        std::size_t         valueSize,
+                                        std::uintptr_t*     outAddresses);
+
+template <ScanValueType V, std::size_t Alignment>
+std::size_t firstScanExact(const std::uint8_t* data,
+                           std::size_t         scanLimit,
+                           std::uintptr_t      base,
+                           const std::uint8_t* query,
+                           std::size_t /*valueSize*/,
+                           std::uintptr_t* outAddresses) {
+  // Exact matches compare the raw bit pattern, like the byte compare they replace.
+  using Bits        = typename ValueTraits<V>::bits;
+  const Bits needle = loadValue<Bits>(query);
+
+  std::size_t count = 0;
+  for (std::size_t offset = firstAlignedOffset<Alignment>(base); offset < scanLimit;
+       offset += Alignment) {
+    outAddresses[count] = base + offset;
+    count += static_cast<std::size_t>(loadValue<Bits>(data + offset) == needle);
+  }
+  return count;
+}
+
+template <bool CaseSensitive, std::size_t Alignment>
+std::size_t firstScanString(const std::uint8_t* data,
+                            std::size_t         scanLimit,
+                            std::uintptr_t      base,
+                            const std::uint8_t* query,
+                            std::size_t         valueSize,
+                            std::uintptr_t*     outAddresses) {
+  const std::uint8_t lead = CaseSensitive ? query[0] : foldAscii(query[0]);
+
+  std::size_t count = 0;
+  for (std::size_t offset = firstAlignedOffset<Alignment>(base); offset < scanLimit;
+       offset += Alignment) {
+    const std::uint8_t first = CaseSensitive ? data[offset] : foldAscii(data[offset]);
+    if (first != lead) {
+      continue;
+    }
+
+    bool match = false;
+    if constexpr (CaseSensitive) {
+      match = std::memcmp(data + offset, query, valueSize) == 0;
+    } else {
+      match = equalFoldedAscii(data + offset, query, valueSize);
+    }
+    outAddresses[count] = base + offset;
+    count += static_cast<std::size_t>(match);
+  }
+  return count;
+}
+
+// Pointer scan: `query` holds two pointer-sized bounds [low, high] and every pointer-aligned slot
+// whose value falls inside them is a match. One unsigned compare covers both bounds.
+inline std::size_t firstScanPointerRange(const std::uint8_t* data,
+                                         std::size_t         scanLimit,
+                                         std::uintptr_t      base,
+                                         const std::uint8_t* query,
+                                         std::size_t /*valueSize*/,
+                                         std::uintptr_t* outAddresses) {
+  constexpr std::size_t kAlignment = sizeof(std::uintptr_t);
+  const auto            low        = loadValue<std::uintptr_t>(query);
+  const auto            span       = loadValue<std::uintptr_t>(query + kAlignment) - low;
+
+  std::size_t count = 0;
+  for (std::size_t offset = firstAlignedOffset<kAlignment>(base); offset < scanLimit;
+       offset += kAlignment) {
+    outAddresses[count] = base + offset;
+    count += static_cast<std::size_t>(loadValue<std::uintptr_t>(data + offset) - low <= span);
+  }
+  return count;
+}
+
+// Next scan: compares the gathered `current` column against `previous` (and the query for exact
+// scans) and writes the indices of surviving entries to `outIndices`, which must hold `count`
+// slots. Entries whose `readable` flag is zero never survive.
+using NextScanKernel = std::size_t (*)(const std::uint8_t* previous,
+                                       const std::uint8_t* current,
+                                       const std::uint8_t* readable,
+                                       std::size_t         count,
+                                       const std::uint8_t* query,
+                                       std::size_t         valueSize,
+                                       std::size_t*        outIndices);
+
+template <ScanValueType V, ScanType S>
+std::size_t nextScanNumeric(const std::uint8_t* previous,
+                            const std::uint8_t* current,
+                            const std::uint8_t* readable,
+                            std::size_t         count,
+                            const std::uint8_t* query,
+                            std::size_t /*valueSize*/,
+                            std::size_t* outIndices) {
+  using T              = typename ValueTraits<V>::type;
+  using Bits           = typename ValueTraits<V>::bits;
+  constexpr auto width = sizeof(T);
+
+  Bits needle{};
+  if constexpr (S == ScanType::ExactValue) {
+    needle = loadValue<Bits>(query);
+  }
+
+  std::size_t kept = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    const std::uint8_t* prevBytes = previous + (i * width);
+    const std::uint8_t* curBytes  = current + (i * width);
+
+    bool match = false;
+    if constexpr (S == ScanType::ExactValue) {
+      match = loadValue<Bits>(curBytes) == needle;
+    } else if constexpr (S == ScanType::ChangedValue) {
+      match = loadValue<Bits>(curBytes) != loadValue<Bits>(prevBytes);
+    } else if constexpr (S == ScanType::UnchangedValue) {
+      match = loadValue<Bits>(curBytes) == loadValue<Bits>(prevBytes);
+    } else if constexpr (S == ScanType::IncreasedValue) {
+      // Ordered comparisons are false for NaN, so no separate NaN check is needed.
+      match = loadValue<T>(curBytes) > loadValue<T>(prevBytes);
+    } else {
+      match = loadValue<T>(curBytes) < loadValue<T>(prevBytes);
+    }
+
+    outIndices[kept] = i;
+    kept += static_cast<std::size_t>(match & (readable[i] != 0));
+  }
+  return kept;
+}
+
+template <ScanType S, bool CaseSensitive>
+std::size_t nextScanString(const std::uint8_t* previous,
+                           const std::uint8_t* current,
+                           const std::uint8_t* readable,
+                           std::size_t         count,
+                           const std::uint8_t* query,
+                           std::size_t         valueSize,
+                           std::size_t*        outIndices) {
+  if constexpr (S == ScanType::IncreasedValue || S == ScanType::DecreasedValue) {
+    // Strings have no ordering; these conditions never match.
+    (void)previous;
+    (void)current;
+    (void)readable;
+    (void)count;
+    (void)query;
+    (void)valueSize;
+    (void)outIndices;
+    return 0;
+  } else {
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+      const std::uint8_t* prevBytes = previous + (i * valueSize);
+      const std::uint8_t* curBytes  = current + (i * valueSize);
+
+      bool match = false;
+      if constexpr (S == ScanType::ExactValue) {
+        if constexpr (CaseSensitive) {
+          match = std::memcmp(curBytes, query, valueSize) == 0;
+        } else {
+          match = equalFoldedAscii(curBytes, query, valueSize);
+        }
+      } else if constexpr (S == ScanType::ChangedValue) {
+        match = std::memcmp(curBytes, prevBytes, valueSize) != 0;
+      } else {
+        match = std::memcmp(curBytes, prevBytes, valueSize) == 0;
+      }
+
+      outIndices[kept] = i;
+      kept += static_cast<std::size_t>(match & (readable[i] != 0));
+    }
+    return kept;
+  }
+}
+
+template <ScanValueType V, std::size_t... Alignments>
+constexpr std::array<FirstScanKernel, sizeof...(Alignments)> makeFirstScanRow(
+    std::index_sequence<Alignments...>) {
+  return {&firstScanExact<V, Alignments + 1>...};
+}
+
+template <bool CaseSensitive, std::size_t... Alignments>
+constexpr std::array<FirstScanKernel, sizeof...(Alignments)> makeFirstScanStringRow(
+    std::index_sequence<Alignments...>) {
+  return {&firstScanString<CaseSensitive, Alignments + 1>...};
+}
+
+template <ScanValueType V>
+constexpr std::array<NextScanKernel, 5> makeNextScanNumericRow() {
+  return {&nextScanNumeric<V, ScanType::ExactValue>,
+          &nextScanNumeric<V, ScanType::IncreasedValue>,
+          &nextScanNumeric<V, ScanType::DecreasedValue>,
+          &nextScanNumeric<V, ScanType::ChangedValue>,
+          &nextScanNumeric<V, ScanType::UnchangedValue>};
+}
+
+template <bool CaseSensitive>
+constexpr std::array<NextScanKernel, 5> makeNextScanStringRow() {
+  return {&nextScanString<ScanType::ExactValue, CaseSensitive>,
+          &nextScanString<ScanType::IncreasedValue, CaseSensitive>,
+          &nextScanString<ScanType::DecreasedValue, CaseSensitive>,
+          &nextScanString<ScanType::ChangedValue, CaseSensitive>,
+          &nextScanString<ScanType::UnchangedValue, CaseSensitive>};
+}
+
+// Returns the exact-value first-scan kernel for `settings`, or nullptr for unsupported input.
+[[nodiscard]] inline FirstScanKernel selectFirstScanKernel(const ScanSettings& settings) {
+  using Row = std::array<FirstScanKernel, kMaxScanAlignment>;
+  constexpr auto kAlignments = std::make_index_sequence<kMaxScanAlignment>{};
+  static constexpr std::array<Row, 6> kNumeric = {
+      makeFirstScanRow<ScanValueType::Int8>(kAlignments),
+      makeFirstScanRow<ScanValueType::Int16>(kAlignments),
+      makeFirstScanRow<ScanValueType::Int32>(kAlignments),
+      makeFirstScanRow<ScanValueType::Int64>(kAlignments),
+      makeFirstScanRow<ScanValueType::Float>(kAlignments),
+      makeFirstScanRow<ScanValueType::Double>(kAlignments)};
+  static constexpr Row kStringCaseSensitive = makeFirstScanStringRow<true>(kAlignments);
+  static constexpr Row kStringFolded        = makeFirstScanStringRow<false>(kAlignments);
+
+  if (settings.alignment == 0 || settings.alignment > kMaxScanAlignment) {
+    return nullptr;
+  }
+  const std::size_t column = settings.alignment - 1;
+
+  if (settings.valueType == ScanValueType::String) {
+    return settings.caseSensitive ? kStringCaseSensitive[column] : kStringFolded[column];
+  }
+  const auto row = static_cast<std::size_t>(settings.valueType);
+  return row < kNumeric.size() ? kNumeric[row][column] : nullptr;
+}
+
+// Returns the next-scan kernel for `settings`, or nullptr for unsupported input.
+[[nodiscard]] inline NextScanKernel selectNextScanKernel(const ScanSettings& settings) {
+  using Row = std::array<NextScanKernel, 5>;
+  static constexpr std::array<Row, 6> kNumeric = {makeNextScanNumericRow<ScanValueType::Int8>(),
+                                                  makeNextScanNumericRow<ScanValueType::Int16>(),
+                                                  makeNextScanNumericRow<ScanValueType::Int32>(),
+                                                  makeNextScanNumericRow<ScanValueType::Int64>(),
+                                                  makeNextScanNumericRow<ScanValueType::Float>(),
+                                                  makeNextScanNumericRow<ScanValueType::Double>()};
+  static constexpr Row kStringCaseSensitive = makeNextScanStringRow<true>();
+  static constexpr Row kStringFolded        = makeNextScanStringRow<false>();
+
+  const auto column = static_cast<std::size_t>(settings.scanType);
+  if (column >= kNumeric.front().size()) {
+    return nullptr;
+  }
+
+  if (settings.valueType == ScanValueType::String) {
+    return settings.caseSensitive ? kStringCaseSensitive[column] : kStringFolded[column];
+  }
+  const auto row = static_cast<std::size_t>(settings.valueType);
+  return row < kNumeric.size() ? kNumeric[row][column] : nullptr;
+}
+
+} // namespace farcal::memory::detail
@@ -0,0 +1,384 @@
+#include "farcal/memory/ProcessMemoryScanner.hpp"
+
+#include "MappedFile.hpp"
+
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <system_error>
+#include <type_traits>
+
+namespace farcal::memory {
+namespace {
+
+// Layout (native endianness, all offsets from the start of the file):
+//   SessionHeader | SetDescriptor[setCount] | columns...
+// Full sessions store every set (undo chain oldest first, current results last) as three
+// 64-byte aligned columns. Compact exports store one set as a count, the value size, LEB128
+// address deltas and the packed current values.
+constexpr std::array<char, 8> kSessionMagic{'F', 'C', 'S', 'E', 'S', 'S', 'N', '\0'};
+constexpr std::uint32_t       kSessionVersion  = 1;
+constexpr std::uint32_t       kFlagCompact     = 1u << 0u;
+constexpr std::uint64_t       kColumnAlignment = 64;
+
+struct SessionHeader {
+  std::array<char, 8> magic{};
+  std::uint32_t       version         = 0;
+  std::uint32_t       flags           = 0;
+  std::uint32_t       pointerSize     = 0;
+  std::uint32_t       setCount        = 0;
+  std::uint8_t        scanType        = 0;
+  std::uint8_t        valueType       = 0;
+  std::uint8_t        hexInput        = 0;
+  std::uint8_t        includeReadOnly = 0;
+  std::uint8_t        caseSensitive   = 0;
+  std::uint8_t        unicode         = 0;
+  std::uint8_t        reserved[2]{};
+  std::uint64_t       alignment = 0;
+};
+
+struct SetDescriptor {
+  std::uint64_t count           = 0;
+  std::uint64_t valueSize       = 0;
+  std::uint64_t addressesOffset = 0;
+  std::uint64_t previousOffset  = 0;
+  std::uint64_t currentOffset   = 0;
+  std::uint64_t reserved        = 0;
+};
+
+static_assert(std::is_trivially_copyable_v<SessionHeader>);
+static_assert(std::is_trivially_copyable_v<SetDescriptor>);
+
+std::uint64_t alignUp(std::uint64_t value) {
+  return (value + kColumnAlignment - 1) & ~(kColumnAlignment - 1);
+}
+
+SessionHeader makeHeader(const ScanSettings& settings, std::uint32_t flags, std::size_t setCount) {
+  SessionHeader header;
+  header.magic           = kSessionMagic;
+  header.version         = kSessionVersion;
+  header.flags           = flags;
+  header.pointerSize     = sizeof(std::uintptr_t);
+  header.setCount        = static_cast<std::uint32_t>(setCount);
+  header.scanType        = static_cast<std::uint8_t>(settings.scanType);
+  header.valueType       = static_cast<std::uint8_t>(settings.valueType);
+  header.hexInput        = settings.hexInput ? 1 : 0;
+  header.includeReadOnly = settings.includeReadOnly ? 1 : 0;
+  header.caseSensitive   = settings.caseSensitive ? 1 : 0;
+  header.unicode         = settings.unicode ? 1 : 0;
+  header.alignment       = settings.alignment;
+  return header;
+}
+
+bool readSettings(const SessionHeader& header, ScanSettings& outSettings) {
+  if (header.scanType > static_cast<std::uint8_t>(ScanType::UnchangedValue)
+      || header.valueType > static_cast<std::uint8_t>(ScanValueType::String)) {
+    return false;
+  }
+  outSettings.scanType        = static_cast<ScanType>(header.scanType);
+  outSettings.valueType       = static_cast<ScanValueType>(header.valueType);
+  outSettings.hexInput        = header.hexInput != 0;
+  outSettings.includeReadOnly = header.includeReadOnly != 0;
+  outSettings.caseSensitive   = header.caseSensitive != 0;
+  outSettings.unicode         = header.unicode != 0;
+  outSettings.alignment       = static_cast<std::size_t>(header.alignment);
+  return true;
+}
+
+template <typename T>
+void writePod(std::ofstream& out, const T& value) {
+  out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void writeBytes(std::ofstream& out, const void* data, std::size_t size) {
+  if (size != 0) {
+    out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+  }
+}
+
+void padTo(std::ofstream& out, std::uint64_t offset) {
+  static constexpr std::array<char, kColumnAlignment> kZeros{};
+  const auto position = static_cast<std::uint64_t>(out.tellp());
+  if (offset > position) {
+    out.write(kZeros.data(), static_cast<std::streamsize>(offset - position));
+  }
+}
+
+// Checks that `count` elements of `elementSize` bytes at `offset` lie inside a file of `fileSize`.
+bool rangeFits(std::uint64_t offset,
+               std::uint64_t count,
+               std::uint64_t elementSize,
+               std::uint64_t fileSize) {
+  if (elementSize != 0 && count > std::numeric_limits<std::uint64_t>::max() / elementSize) {
+    return false;
+  }
+  const std::uint64_t bytes = count * elementSize;
+  return offset <= fileSize && bytes <= fileSize - offset;
+}
+
+// Writes to a sibling temporary file and renames it over `path`, so an interrupted save never
+// destroys the previous session.
+template <typename Writer>
+bool writeAtomically(const std::filesystem::path& path, Writer&& writer) {
+  std::filesystem::path temporary = path;
+  temporary += ".tmp";
+
+  {
+    std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+    if (!out || !writer(out)) {
+      return false;
+    }
+    out.flush();
+    if (!out) {
+      return false;
+    }
+  }
+
+  std::error_code error;
+  std::filesystem::rename(temporary, path, error);
+  if (error) {
+    std::filesystem::remove(temporary, error);
+    return false;
+  }
+  return true;
+}
+
+} // namespace
+
+bool ProcessMemoryScanner::saveSession(const std::filesystem::path& path) {
+  m_lastError.clear();
+
+#ifdef _WIN32
+  // A mapped view keeps its file from being replaced, and the session may be saved over the file
+  // it was loaded from; take the columns back into memory first.
+  for (ScanResultSet& set : m_history) {
+    set.detach();
+  }
+  m_results.detach();
+#endif
+
+  std::vector<const ScanResultSet*> sets;
+  sets.reserve(m_history.size() + 1);
+  for (const ScanResultSet& set : m_history) {
+    sets.push_back(&set);
+  }
+  sets.push_back(&m_results);
+
+  std::vector<SetDescriptor> descriptors(sets.size());
+  std::uint64_t offset = sizeof(SessionHeader) + (sizeof(SetDescriptor) * descriptors.size());
+  for (std::size_t i = 0; i < sets.size(); ++i) {
+    const std::uint64_t count      = sets[i]->size();
+    const std::uint64_t valueBytes = count * sets[i]->valueSize();
+
+    SetDescriptor& descriptor  = descriptors[i];
+    descriptor.count           = count;
+    descriptor.valueSize       = sets[i]->valueSize();
+    descriptor.addressesOffset = alignUp(offset);
+    descriptor.previousOffset  = alignUp(descriptor.addressesOffset + (count * sizeof(std::uintptr_t)));
+    descriptor.currentOffset   = alignUp(descriptor.previousOffset + valueBytes);
+    offset                     = descriptor.currentOffset + valueBytes;
+  }
+
+  const SessionHeader header = makeHeader(m_lastSettings, 0, sets.size());
+  const bool          saved  = writeAtomically(path, [&](std::ofstream& out) {
+    writePod(out, header);
+    for (const SetDescriptor& descriptor : descriptors) {
+      writePod(out, descriptor);
+    }
+    for (std::size_t i = 0; i < sets.size(); ++i) {
+      const auto addresses = sets[i]->addresses();
+      const auto previous  = sets[i]->previousColumn();
+      const auto current   = sets[i]->currentColumn();
+      padTo(out, descriptors[i].addressesOffset);
+      writeBytes(out, addresses.data(), addresses.size_bytes());
+      padTo(out, descriptors[i].previousOffset);
+      writeBytes(out, previous.data(), previous.size_bytes());
+      padTo(out, descriptors[i].currentOffset);
+      writeBytes(out, current.data(), current.size_bytes());
+    }
+    return static_cast<bool>(out);
+  });
+
+  if (!saved) {
+    m_lastError = "Failed to write scan session file.";
+  }
+  return saved;
+}
+
+bool ProcessMemoryScanner::exportCompact(const std::filesystem::path& path) {
+  m_lastError.clear();
+
+  const auto addresses = m_results.addresses();
+  const auto current   = m_results.currentColumn();
+
+  std::vector<std::uint8_t> encoded;
+  encoded.reserve(addresses.size() * 2);
+  std::uintptr_t previousAddress = 0;
+  for (const std::uintptr_t address : addresses) {
+    // Addresses are ascending, so deltas are small and mostly fit in one or two bytes.
+    std::uint64_t delta = static_cast<std::uint64_t>(address - previousAddress);
+    previousAddress     = address;
+    do {
+      const auto low = static_cast<std::uint8_t>(delta & 0x7Fu);
+      delta >>= 7u;
+      encoded.push_back(static_cast<std::uint8_t>(low | (delta != 0 ? 0x80u : 0u)));
+    } while (delta != 0);
+  }
+
+  const SessionHeader header = makeHeader(m_lastSettings, kFlagCompact, 1);
+  const std::uint64_t count     = addresses.size();
+  const std::uint64_t valueSize = m_results.valueSize();
+  const bool          saved     = writeAtomically(path, [&](std::ofstream& out) {
+    writePod(out, header);
+    writePod(out, count);
+    writePod(out, valueSize);
+    writeBytes(out, encoded.data(), encoded.size());
+    writeBytes(out, current.data(), current.size_bytes());
+    return static_cast<bool>(out);
+  });
+
+  if (!saved) {
+    m_lastError = "Failed to write compact scan export.";
+  }
+  return saved;
+}
+
+bool ProcessMemoryScanner::loadSession(const std::filesystem::path& path) {
+  m_lastError.clear();
+
+  const auto file = detail::MappedFile::open(path);
+  if (file == nullptr) {
+    m_lastError = "Failed to open scan session file.";
+    return false;
+  }
+
+  const std::uint8_t* data     = file->data();
+  const std::uint64_t fileSize = file->size();
+
+  SessionHeader header;
+  if (fileSize < sizeof(header)) {
+    m_lastError = "Scan session file is truncated.";
+    return false;
+  }
+  std::memcpy(&header, data, sizeof(header));
+
+  ScanSettings settings;
+  if (header.magic != kSessionMagic || !readSettings(header, settings)) {
+    m_lastError = "Not a scan session file.";
+    return false;
+  }
+  if (header.version != kSessionVersion) {
+    m_lastError = "Unsupported scan session version.";
+    return false;
+  }
+  if (header.pointerSize != sizeof(std::uintptr_t)) {
+    m_lastError = "Scan session was saved by a build with a different pointer size.";
+    return false;
+  }
+
+  // Every set of a session holds values of the header's type; only string values vary in size.
+  const std::size_t typeSize    = valueSizeFromSettings(settings, 0);
+  const auto        sizeMatches = [&settings, typeSize](std::uint64_t valueSize) {
+    return settings.valueType == ScanValueType::String ? valueSize != 0 : valueSize == typeSize;
+  };
+
+  std::vector<ScanResultSet> sets;
+
+  if ((header.flags & kFlagCompact) != 0) {
+    std::uint64_t count     = 0;
+    std::uint64_t valueSize = 0;
+    std::uint64_t cursor    = sizeof(header);
+    if (!rangeFits(cursor, 2, sizeof(std::uint64_t), fileSize)) {
+      m_lastError = "Scan session file is truncated.";
+      return false;
+    }
+    std::memcpy(&count, data + cursor, sizeof(count));
+    std::memcpy(&valueSize, data + cursor + sizeof(count), sizeof(valueSize));
+    cursor += 2 * sizeof(std::uint64_t);
+
+    if (!sizeMatches(valueSize)) {
+      m_lastError = "Scan session file is corrupt.";
+      return false;
+    }
+
+    // Every entry needs at least one delta byte plus its value.
+    if (!rangeFits(cursor, count, valueSize + 1, fileSize)) {
+      m_lastError = "Scan session file is truncated.";
+      return false;
+    }
+
+    ScanResultSet& set = sets.emplace_back();
+    set.reset(static_cast<std::size_t>(valueSize));
+    set.m_addresses.reserve(static_cast<std::size_t>(count));
+
+    std::uintptr_t address = 0;
+    for (std::uint64_t i = 0; i < count; ++i) {
+      std::uint64_t delta = 0;
+      unsigned      shift = 0;
+      std::uint8_t  byte  = 0x80;
+      while ((byte & 0x80u) != 0) {
+        if (cursor >= fileSize || shift >= 64) {
+          m_lastError = "Scan session file is corrupt.";
+          return false;
+        }
+        byte = data[cursor++];
+        delta |= static_cast<std::uint64_t>(byte & 0x7Fu) << shift;
+        shift += 7;
+      }
+      address += static_cast<std::uintptr_t>(delta);
+      set.m_addresses.push_back(address);
+    }
+
+    if (!rangeFits(cursor, count, valueSize, fileSize)) {
+      m_lastError = "Scan session file is truncated.";
+      return false;
+    }
+    const std::uint8_t* values = data + cursor;
+    set.m_current.assign(values, values + (count * valueSize));
+    set.m_previous = set.m_current;
+  } else {
+    const std::uint64_t tableOffset = sizeof(header);
+    if (header.setCount == 0
+        || !rangeFits(tableOffset, header.setCount, sizeof(SetDescriptor), fileSize)) {
+      m_lastError = "Scan session file is truncated.";
+      return false;
+    }
+
+    // The sets alias the mapping; it stays alive as long as any of them does.
+    const std::shared_ptr<const void> backing = file;
+    sets.reserve(header.setCount);
+    for (std::uint32_t i = 0; i < header.setCount; ++i) {
+      SetDescriptor descriptor;
+      std::memcpy(&descriptor, data + tableOffset + (i * sizeof(SetDescriptor)), sizeof(descriptor));
+
+      if (!sizeMatches(descriptor.valueSize)
+          || descriptor.addressesOffset % alignof(std::uintptr_t) != 0
+          || !rangeFits(descriptor.addressesOffset, descriptor.count, sizeof(std::uintptr_t), fileSize)
+          || !rangeFits(descriptor.previousOffset, descriptor.count, descriptor.valueSize, fileSize)
+          || !rangeFits(descriptor.currentOffset, descriptor.count, descriptor.valueSize, fileSize)) {
+        m_lastError = "Scan session file is corrupt.";
+        return false;
+      }
+
+      ScanResultSet& set = sets.emplace_back();
+      set.reset(static_cast<std::size_t>(descriptor.valueSize));
+
+      ScanResultSet::MappedColumns columns;
+      columns.backing   = backing;
+      columns.addresses = reinterpret_cast<const std::uintptr_t*>(data + descriptor.addressesOffset);
+      columns.previous  = data + descriptor.previousOffset;
+      columns.current   = data + descriptor.currentOffset;
+      columns.count     = static_cast<std::size_t>(descriptor.count);
+      set.m_mapped      = std::move(columns);
+    }
+  }
+
+  m_results = std::move(sets.back());
+  sets.pop_back();
+  m_history      = std::move(sets);
+  m_lastSettings = settings;
+  return true;
+}
+
+} // namespace farcal::memory
@@ -24,6 +24,8 @@
 #include <QDir>
 #include <QEvent>
 #include <QFile>
+#include <QFileDialog>
+#include <QFileInfo>
 #include <QFont>
 #include <QFrame>
 #include <QGridLayout>
@@ -59,6 +61,7 @@
 #include <algorithm>
 #include <cstdint>
 #include <cstring>
+#include <filesystem>
 #include <limits>
 #include <optional>
 #include <utility>
@@ -75,6 +78,12 @@
 #endif
 namespace farcal::ui {
 
+namespace {
+
+constexpr std::size_t kMaxVisibleScanRows = 20000;
+
+}  // namespace
+
 MainWindow::MainWindow(QWidget* parent)
   : QMainWindow(parent),
     m_memoryReader(std::make_unique<memory::MemoryReader>()),
@@ -104,10 +113,17 @@ MainWindow::MainWindow(QWidget* parent)
 
 MainWindow::~MainWindow() {
   if (m_scanThread != nullptr) {
+    m_scanStopSource.request_stop();
     m_scanThread->quit();
     m_scanThread->wait();
     m_scanThread = nullptr;
   }
+
+  // Keep the narrowing session across restarts; "Restore Last Scan Session" reloads it.
+  const QString sessionPath = lastScanSessionFilePath();
+  if (m_homeScanner != nullptr && !m_homeScanner->results().empty() && !sessionPath.isEmpty()) {
+    (void)m_homeScanner->saveSession(std::filesystem::path(sessionPath.toStdWString()));
+  }
 }
 
 bool MainWindow::eventFilter(QObject* watched, QEvent* event) {
@@ -326,12 +342,21 @@ void MainWindow::configureMenuBar() {
   m_attachToProcessAction   = fileMenu->addAction(("Attach To Process"));
   m_attachLastProcessAction = fileMenu->addAction(("Attach Last Process"));
   fileMenu->addSeparator();
+  auto* saveSessionAction    = fileMenu->addAction(("Save Scan Session..."));
+  auto* loadSessionAction    = fileMenu->addAction(("Load Scan Session..."));
+  auto* restoreSessionAction = fileMenu->addAction(("Restore Last Scan Session"));
+  auto* exportCompactAction  = fileMenu->addAction(("Export Compact Scan Results..."));
+  fileMenu->addSeparator();
   auto* settingsAction = fileMenu->addAction(("Settings"));
 
   connect(
       m_attachToProcessAction, &QAction::triggered, this, &MainWindow::showAttachToProcessDialog);
   connect(m_attachLastProcessAction, &QAction::triggered, this, &MainWindow::showAttachLastProcess);
   connect(settingsAction, &QAction::triggered, this, &MainWindow::showSettingsWindow);
+  connect(saveSessionAction, &QAction::triggered, this, &MainWindow::saveScanSession);
+  connect(loadSessionAction, &QAction::triggered, this, &MainWindow::loadScanSession);
+  connect(restoreSessionAction, &QAction::triggered, this, &MainWindow::restoreLastScanSession);
+  connect(exportCompactAction, &QAction::triggered, this, &MainWindow::exportCompactScanResults);
 
   auto* memoryViewMenu     = topMenu->addMenu(("Memory View"));
   auto* memoryViewerAction = memoryViewMenu->addAction(("Memory Viewer"));
@@ -384,6 +409,12 @@ void MainWindow::showMemoryViewerWindow() {
 void MainWindow::showRttiWindow() {
   if (m_rttiWindow == nullptr) {
     m_rttiWindow = std::make_unique<RttiWindow>(this);
+    m_rttiWindow->setScanFinishedHandler(
+        [this](std::uint32_t processId, const std::vector<memory::RttiScanner::TypeInfo>& types) {
+          if (m_structureDissectorWindow != nullptr) {
+            m_structureDissectorWindow->setKnownRttiTypes(processId, types);
+          }
+        });
   }
 
   if (m_attachedProcessId != 0 && !m_attachedProcessName.isEmpty()) {
@@ -468,6 +499,9 @@ void MainWindow::showStructureDissectorWindow() {
 
   if (m_attachedProcessId != 0 && !m_attachedProcessName.isEmpty()) {
     m_structureDissectorWindow->setAttachedProcess(m_attachedProcessId, m_attachedProcessName);
+    if (m_rttiWindow != nullptr && !m_rttiWindow->entries().empty()) {
+      m_structureDissectorWindow->setKnownRttiTypes(m_rttiWindow->processId(), m_rttiWindow->entries());
+    }
   }
 
   m_structureDissectorWindow->show();
@@ -578,10 +612,13 @@ QWidget* MainWindow::buildScanPanel() {
   m_nextScanButton  = new QPushButton(("Next Scan"), panel);
   m_undoScanButton  = new QPushButton(("Undo Scan"), panel);
   m_newScanButton   = new QPushButton(("New Scan"), panel);
+  m_cancelScanButton = new QPushButton(("Cancel Scan"), panel);
+  m_cancelScanButton->setEnabled(false);
   buttons->addWidget(m_firstScanButton, 0, 0);
   buttons->addWidget(m_nextScanButton, 0, 1);
   buttons->addWidget(m_undoScanButton, 1, 0);
   buttons->addWidget(m_newScanButton, 1, 1);
+  buttons->addWidget(m_cancelScanButton, 2, 0, 1, 2);
   layout->addLayout(buttons);
 
   m_scanProgressBar = new QProgressBar(panel);
@@ -589,6 +626,9 @@ QWidget* MainWindow::buildScanPanel() {
   m_scanProgressBar->setValue(0);
   layout->addWidget(m_scanProgressBar);
 
+  m_scanRateLabel = new QLabel(panel);
+  layout->addWidget(m_scanRateLabel);
+
   m_foundLabel = new QLabel(("Found: 0"), panel);
   layout->addWidget(m_foundLabel);
   layout->addStretch(1);
@@ -597,6 +637,7 @@ QWidget* MainWindow::buildScanPanel() {
   connect(m_nextScanButton, &QPushButton::clicked, this, &MainWindow::onNextScanClicked);
   connect(m_undoScanButton, &QPushButton::clicked, this, &MainWindow::onUndoScanClicked);
   connect(m_newScanButton, &QPushButton::clicked, this, &MainWindow::onNewScanClicked);
+  connect(m_cancelScanButton, &QPushButton::clicked, this, &MainWindow::onCancelScanClicked);
   connect(m_valueTypeCombo, &QComboBox::currentIndexChanged, this, [this](int) {
     updateScanToggleState();
   });
@@ -934,23 +975,58 @@ void MainWindow::runScan(bool firstScan) {
   const std::string query =
       (m_valueInput == nullptr) ? std::string() : m_valueInput->text().trimmed().toStdString();
 
-  m_scanBusy = true;
+  m_scanBusy           = true;
+  m_activeScanSettings = settings;
+  m_scanStopSource     = std::stop_source();
   setScanUiBusy(true);
   if (m_scanProgressBar != nullptr) {
     m_scanProgressBar->setValue(0);
   }
+  if (m_scanRateLabel != nullptr) {
+    m_scanRateLabel->clear();
+  }
+  if (m_scanResultsTable != nullptr) {
+    m_scanResultsTable->setRowCount(0);
+  }
 
   QPointer<MainWindow> self(this);
-  m_scanThread = QThread::create([this, self, firstScan, settings, query]() {
-    const auto progress = [self](std::size_t completed, std::size_t total) {
+  const std::stop_token stopToken = m_scanStopSource.get_token();
+  m_scanThread = QThread::create([this, self, firstScan, settings, query, stopToken]() {
+    memory::ProcessMemoryScanner::Observer observer;
+    observer.stopToken = stopToken;
+    observer.progress  = [self](const memory::ScanProgress& progress) {
       if (self == nullptr) {
         return;
       }
       QMetaObject::invokeMethod(
           self,
-          [self, completed, total]() {
+          [self, progress]() {
             if (self != nullptr) {
-              self->updateScanProgress(completed, total);
+              self->updateScanProgress(progress);
+            }
+          },
+          Qt::QueuedConnection);
+    };
+    // Only the rows the table can show are copied out of the running scan.
+    observer.results = [self](const memory::ScanResultSet& partial, std::size_t firstNewIndex) {
+      if (self == nullptr || firstNewIndex >= kMaxVisibleScanRows) {
+        return;
+      }
+
+      const std::size_t last  = std::min(partial.size(), kMaxVisibleScanRows);
+      auto              batch = std::make_shared<memory::ScanResultSet>();
+      batch->reset(partial.valueSize());
+      batch->reserve(last - firstNewIndex);
+      for (std::size_t i = firstNewIndex; i < last; ++i) {
+        batch->push(
+            partial.address(i), partial.previousValue(i).data(), partial.currentValue(i).data());
+      }
+
+      QMetaObject::invokeMethod(
+          self,
+          [self, batch]() {
+            if (self != nullptr) {
+              self->appendScanResultRows(*batch);
             }
           },
           Qt::QueuedConnection);
@@ -958,12 +1034,13 @@ void MainWindow::runScan(bool firstScan) {
 
     bool success = false;
     if (firstScan) {
-      success = m_homeScanner->firstScan(settings, query, progress);
+      success = m_homeScanner->firstScan(settings, query, observer);
     } else {
-      success = m_homeScanner->nextScan(settings, query, progress);
+      success = m_homeScanner->nextScan(settings, query, observer);
     }
 
-    QString errorMessage;
+    const bool cancelled = !success && m_homeScanner->lastScanCancelled();
+    QString    errorMessage;
     if (!success) {
       errorMessage = QString::fromStdString(m_homeScanner->lastError());
     }
@@ -971,9 +1048,9 @@ void MainWindow::runScan(bool firstScan) {
     if (self != nullptr) {
       QMetaObject::invokeMethod(
           self,
-          [self, success, errorMessage]() {
+          [self, success, cancelled, errorMessage]() {
             if (self != nullptr) {
-              self->onScanFinished(success, errorMessage);
+              self->onScanFinished(success, cancelled, errorMessage);
             }
           },
           Qt::QueuedConnection);
@@ -985,28 +1062,154 @@ void MainWindow::runScan(bool firstScan) {
   m_scanThread->start();
 }
 
-void MainWindow::onScanFinished(bool success, const QString& errorMessage) {
+void MainWindow::onCancelScanClicked() {
+  if (!m_scanBusy) {
+    return;
+  }
+  m_scanStopSource.request_stop();
+  if (m_cancelScanButton != nullptr) {
+    m_cancelScanButton->setEnabled(false);
+  }
+  if (m_scanRateLabel != nullptr) {
+    m_scanRateLabel->setText(("Cancelling..."));
+  }
+}
+
+void MainWindow::onScanFinished(bool success, bool cancelled, const QString& errorMessage) {
   m_scanBusy = false;
   setScanUiBusy(false);
   if (m_scanProgressBar != nullptr) {
     m_scanProgressBar->setValue(success ? 100 : 0);
   }
+  if (m_scanRateLabel != nullptr && cancelled) {
+    m_scanRateLabel->setText(("Scan cancelled."));
+  }
 
-  if (!success) {
+  if (!success && !cancelled) {
     QMessageBox::warning(this, ("Scan"), errorMessage);
   }
 
   refreshScanResults();
 }
 
-void MainWindow::updateScanProgress(std::size_t completed, std::size_t total) {
-  if (m_scanProgressBar == nullptr || total == 0) {
+void MainWindow::saveScanSession() {
+  if (m_scanBusy || m_homeScanner == nullptr) {
+    return;
+  }
+
+  const QString path = QFileDialog::getSaveFileName(
+      this, ("Save Scan Session"), QString(), ("Farcal scan session (*.fcscan)"));
+  if (path.isEmpty()) {
+    return;
+  }
+
+  if (!m_homeScanner->saveSession(std::filesystem::path(path.toStdWString()))) {
+    QMessageBox::warning(
+        this, ("Save Scan Session"), QString::fromStdString(m_homeScanner->lastError()));
+  }
+}
+
+void MainWindow::loadScanSession() {
+  if (m_scanBusy || m_homeScanner == nullptr) {
+    return;
+  }
+
+  const QString path = QFileDialog::getOpenFileName(
+      this, ("Load Scan Session"), QString(), ("Farcal scan session (*.fcscan *.fcscanc)"));
+  if (path.isEmpty()) {
+    return;
+  }
+
+  if (!m_homeScanner->loadSession(std::filesystem::path(path.toStdWString()))) {
+    QMessageBox::warning(
+        this, ("Load Scan Session"), QString::fromStdString(m_homeScanner->lastError()));
+    return;
+  }
+  refreshScanResults();
+}
+
+void MainWindow::restoreLastScanSession() {
+  if (m_scanBusy || m_homeScanner == nullptr) {
     return;
   }
 
-  const std::size_t safeCompleted = std::min(completed, total);
-  const int         percent       = static_cast<int>((safeCompleted * 100) / total);
-  m_scanProgressBar->setValue(percent);
+  const QString path = lastScanSessionFilePath();
+  if (path.isEmpty() || !QFile::exists(path)) {
+    QMessageBox::information(
+        this, ("Restore Last Scan Session"), ("No saved scan session was found."));
+    return;
+  }
+
+  if (!m_homeScanner->loadSession(std::filesystem::path(path.toStdWString()))) {
+    QMessageBox::warning(
+        this, ("Restore Last Scan Session"), QString::fromStdString(m_homeScanner->lastError()));
+    return;
+  }
+  refreshScanResults();
+}
+
+void MainWindow::exportCompactScanResults() {
+  if (m_scanBusy || m_homeScanner == nullptr) {
+    return;
+  }
+
+  const QString path = QFileDialog::getSaveFileName(
+      this, ("Export Compact Scan Results"), QString(), ("Farcal compact scan (*.fcscanc)"));
+  if (path.isEmpty()) {
+    return;
+  }
+
+  if (!m_homeScanner->exportCompact(std::filesystem::path(path.toStdWString()))) {
+    QMessageBox::warning(
+        this, ("Export Compact Scan Results"), QString::fromStdString(m_homeScanner->lastError()));
+  }
+}
+
+void MainWindow::updateScanProgress(const memory::ScanProgress& progress) {
+  if (!m_scanBusy) {
+    return;
+  }
+
+  if (m_scanProgressBar != nullptr && progress.bytesTotal > 0) {
+    const std::uint64_t done    = std::min(progress.bytesDone, progress.bytesTotal);
+    const int           percent = static_cast<int>((done * 100) / progress.bytesTotal);
+    m_scanProgressBar->setValue(percent);
+  }
+
+  if (m_scanRateLabel != nullptr) {
+    const double megabytesPerSecond = progress.bytesPerSecond / (1024.0 * 1024.0);
+    m_scanRateLabel->setText(QString(("%1 MB/s  |  ETA %2 s"))
+                                 .arg(megabytesPerSecond, 0, 'f', 1)
+                                 .arg(progress.etaSeconds, 0, 'f', 1));
+  }
+
+  if (m_foundLabel != nullptr) {
+    m_foundLabel->setText(QString(("Found: %1 (scanning...)")).arg(progress.resultCount));
+  }
+}
+
+void MainWindow::appendScanResultRows(const memory::ScanResultSet& batch) {
+  if (!m_scanBusy || m_scanResultsTable == nullptr || batch.empty()) {
+    return;
+  }
+
+  const int         firstRow = m_scanResultsTable->rowCount();
+  const std::size_t room =
+      kMaxVisibleScanRows - std::min(static_cast<std::size_t>(firstRow), kMaxVisibleScanRows);
+  const std::size_t count = std::min(batch.size(), room);
+
+  m_scanResultsTable->setRowCount(firstRow + static_cast<int>(count));
+  for (std::size_t i = 0; i < count; ++i) {
+    const int row         = firstRow + static_cast<int>(i);
+    auto*     addressItem = new QTableWidgetItem(
+        QString(("0x%1")).arg(static_cast<qulonglong>(batch.address(i)), 0, 16).toUpper());
+    auto* valueItem = new QTableWidgetItem(formatScanValue(batch.currentValue(i), m_activeScanSettings));
+    auto* previousItem =
+        new QTableWidgetItem(formatScanValue(batch.previousValue(i), m_activeScanSettings));
+    m_scanResultsTable->setItem(row, 0, addressItem);
+    m_scanResultsTable->setItem(row, 1, valueItem);
+    m_scanResultsTable->setItem(row, 2, previousItem);
+  }
 }
 
 void MainWindow::setScanUiBusy(bool busy) {
@@ -1022,6 +1225,9 @@ void MainWindow::setScanUiBusy(bool busy) {
   if (m_newScanButton != nullptr) {
     m_newScanButton->setEnabled(!busy);
   }
+  if (m_cancelScanButton != nullptr) {
+    m_cancelScanButton->setEnabled(busy);
+  }
 }
 
 void MainWindow::refreshScanResults() {
@@ -1036,25 +1242,24 @@ void MainWindow::refreshScanResults() {
     return;
   }
 
-  const auto&           entries         = m_homeScanner->results();
-  constexpr std::size_t kMaxVisibleRows = 20000;
-  const std::size_t     visibleRows     = std::min(entries.size(), kMaxVisibleRows);
+  const auto&       entries     = m_homeScanner->results();
+  const auto&       settings    = m_homeScanner->lastSettings();
+  const std::size_t visibleRows = std::min(entries.size(), kMaxVisibleScanRows);
 
   m_scanResultsTable->setRowCount(static_cast<int>(visibleRows));
   for (std::size_t i = 0; i < visibleRows; ++i) {
-    const auto& entry       = entries[i];
-    auto*       addressItem = new QTableWidgetItem(
-        QString(("0x%1")).arg(static_cast<qulonglong>(entry.address), 0, 16).toUpper());
-    auto* valueItem    = new QTableWidgetItem(formatScanValue(entry.currentValue));
-    auto* previousItem = new QTableWidgetItem(formatScanValue(entry.previousValue));
+    auto* addressItem = new QTableWidgetItem(
+        QString(("0x%1")).arg(static_cast<qulonglong>(entries.address(i)), 0, 16).toUpper());
+    auto* valueItem    = new QTableWidgetItem(formatScanValue(entries.currentValue(i), settings));
+    auto* previousItem = new QTableWidgetItem(formatScanValue(entries.previousValue(i), settings));
     m_scanResultsTable->setItem(static_cast<int>(i), 0, addressItem);
     m_scanResultsTable->setItem(static_cast<int>(i), 1, valueItem);
     m_scanResultsTable->setItem(static_cast<int>(i), 2, previousItem);
   }
 
-  if (entries.size() > kMaxVisibleRows) {
+  if (entries.size() > kMaxVisibleScanRows) {
     m_foundLabel->setText(
-        QString(("Found: %1 (showing first %2)")).arg(entries.size()).arg(kMaxVisibleRows));
+        QString(("Found: %1 (showing first %2)")).arg(entries.size()).arg(kMaxVisibleScanRows));
   } else {
     m_foundLabel->setText(QString(("Found: %1")).arg(entries.size()));
   }
@@ -1122,13 +1327,12 @@ memory::ScanSettings MainWindow::buildScanSettings() const {
   return settings;
 }
 
-QString MainWindow::formatScanValue(const std::vector<std::uint8_t>& bytes) const {
-  if (m_homeScanner == nullptr || bytes.empty()) {
+QString MainWindow::formatScanValue(std::span<const std::uint8_t> bytes,
+                                    const memory::ScanSettings&   settings) const {
+  if (bytes.empty()) {
     return ("-");
   }
 
-  const auto settings = m_homeScanner->lastSettings();
-
   switch (settings.valueType) {
     case memory::ScanValueType::Int8: {
       std::int8_t value = 0;
@@ -2088,7 +2292,7 @@ void MainWindow::refreshScanResultsLiveValues() {
       continue;
     }
 
-    const std::uintptr_t address      = entries[static_cast<std::size_t>(row)].address;
+    const std::uintptr_t address      = entries.address(static_cast<std::size_t>(row));
     const QString        updatedValue = readLiveValueForScanRow(address, row);
     if (!updatedValue.isEmpty()) {
       valueItem->setText(updatedValue);
@@ -2235,7 +2439,7 @@ QString MainWindow::readLiveValueForScanRow(std::uintptr_t address, int row) con
   }
 
   const auto        settings = m_homeScanner->lastSettings();
-  const std::size_t size     = entries[static_cast<std::size_t>(row)].currentValue.size();
+  const std::size_t size     = entries.valueSize();
   if (size == 0) {
     return {};
   }
@@ -2444,6 +2648,14 @@ QString MainWindow::lastProcessFilePath() const {
   return baseDir.filePath(relativeDir + ("/last_process.json"));
 }
 
+QString MainWindow::lastScanSessionFilePath() const {
+  const QString processFilePath = lastProcessFilePath();
+  if (processFilePath.isEmpty()) {
+    return {};
+  }
+  return QFileInfo(processFilePath).dir().filePath(("last_session.fcscan"));
+}
+
 void MainWindow::persistLastAttachedProcess(std::uint32_t  processId,
                                             const QString& processName) const {
   if (processId == 0 || processName.trimmed().isEmpty()) {
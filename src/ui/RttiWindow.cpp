@@ -1,20 +1,26 @@
 #include "farcal/ui/RttiWindow.hpp"
 #include "q_lit.hpp"
 
+#include "farcal/memory/InstanceFinder.hpp"
 #include "farcal/memory/MemoryReader.hpp"
 
 #include <QAbstractItemView>
 #include <QAbstractTableModel>
 #include <QApplication>
 #include <QClipboard>
+#include <QDialog>
+#include <QDir>
 #include <QFrame>
 #include <QHBoxLayout>
 #include <QHeaderView>
 #include <QLabel>
 #include <QLineEdit>
+#include <QListWidget>
 #include <QMenu>
 #include <QMetaObject>
+#include <QPointer>
 #include <QPushButton>
+#include <QStandardPaths>
 #include <QStringList>
 #include <QTableView>
 #include <QThread>
@@ -22,7 +28,7 @@
 #include <QWidget>
 
 #include <algorithm>
-#include <iterator>
+#include <filesystem>
 #include <memory>
 #include <unordered_map>
 #include <utility>
@@ -63,45 +69,32 @@ QString formatVftables(const std::vector<std::uintptr_t>& vftables) {
   return text;
 }
 
-std::size_t countEntriesWithVftables(const std::vector<memory::RttiScanner::TypeInfo>& entries) {
-  return static_cast<std::size_t>(
-      std::count_if(entries.begin(), entries.end(), [](const memory::RttiScanner::TypeInfo& entry) {
-        return !entry.vftables.empty();
-      }));
+void mergeVftables(std::vector<std::uintptr_t>& target, const std::vector<std::uintptr_t>& incoming) {
+  for (const auto vftable : incoming) {
+    if (std::find(target.begin(), target.end(), vftable) == target.end()) {
+      target.push_back(vftable);
+    }
+  }
 }
 
-void mergeScanResults(std::vector<memory::RttiScanner::TypeInfo>&  base,
-                      std::vector<memory::RttiScanner::TypeInfo>&& extra) {
-  if (extra.empty()) {
-    return;
+// Per-module RTTI indexes live next to the other settings files.
+std::filesystem::path rttiCacheDirectory() {
+  QString localAppData = qEnvironmentVariable("LOCALAPPDATA");
+  if (localAppData.isEmpty()) {
+    localAppData = QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation);
   }
 
-  std::unordered_map<std::uintptr_t, std::size_t> typeToIndex;
-  typeToIndex.reserve(base.size() + extra.size());
-  for (std::size_t i = 0; i < base.size(); ++i) {
-    typeToIndex.emplace(base[i].type_descriptor, i);
+  if (localAppData.isEmpty()) {
+    return {};
   }
 
-  for (auto& incoming : extra) {
-    const auto found = typeToIndex.find(incoming.type_descriptor);
-    if (found == typeToIndex.end()) {
-      typeToIndex.emplace(incoming.type_descriptor, base.size());
-      base.push_back(std::move(incoming));
-      continue;
-    }
-
-    auto& target = base[found->second];
-    if (target.demangled_name.empty() && !incoming.demangled_name.empty()) {
-      target.demangled_name = std::move(incoming.demangled_name);
-    }
-
-    for (const auto vftable : incoming.vftables) {
-      if (std::find(target.vftables.begin(), target.vftables.end(), vftable)
-          == target.vftables.end()) {
-        target.vftables.push_back(vftable);
-      }
-    }
+  QDir          baseDir(localAppData);
+  const QString relativeDir = ("farcalenginev2/rtti-cache");
+  if (!baseDir.mkpath(relativeDir)) {
+    return {};
   }
+
+  return std::filesystem::path(baseDir.filePath(relativeDir).toStdWString());
 }
 
 }  // namespace
@@ -118,6 +111,14 @@ class RttiTableModel final : public QAbstractTableModel {
     endResetModel();
   }
 
+  // Vftables of existing entries changed in place; rows and names are unchanged.
+  void refresh_vftables() {
+    const int rows = rowCount();
+    if (rows > 0) {
+      emit dataChanged(index(0, 2), index(rows - 1, 2), {Qt::DisplayRole});
+    }
+  }
+
   int rowCount(const QModelIndex& parent = QModelIndex()) const override {
     if (parent.isValid() || m_visibleRows == nullptr) {
       return 0;
@@ -197,6 +198,11 @@ RttiWindow::~RttiWindow() {
     delete m_scanThread;
     m_scanThread = nullptr;
   }
+  if (m_instanceThread != nullptr) {
+    m_instanceThread->wait();
+    delete m_instanceThread;
+    m_instanceThread = nullptr;
+  }
 }
 
 void RttiWindow::setAttachedProcess(std::uint32_t processId, const QString& processName) {
@@ -205,6 +211,7 @@ void RttiWindow::setAttachedProcess(std::uint32_t processId, const QString& proc
 
   if (m_processId == 0 || m_processName.isEmpty()) {
     m_entries.clear();
+    m_entryIndex.clear();
     m_filteredRows.clear();
     if (m_tableModel != nullptr) {
       m_tableModel->set_data_sources(&m_entries, &m_filteredRows);
@@ -216,6 +223,10 @@ void RttiWindow::setAttachedProcess(std::uint32_t processId, const QString& proc
   refreshScan();
 }
 
+void RttiWindow::setScanFinishedHandler(ScanFinishedHandler handler) {
+  m_scanFinishedHandler = std::move(handler);
+}
+
 void RttiWindow::applyTheme() {
   setStyleSheet((R"(QMainWindow {
   background-color: #22242a;
@@ -330,9 +341,25 @@ QWidget* RttiWindow::buildCentralArea() {
       return;
     }
 
+    const int viewRow   = index.row();
+    const int sourceRow = viewRow >= 0 && viewRow < static_cast<int>(m_filteredRows.size())
+                              ? m_filteredRows[static_cast<std::size_t>(viewRow)]
+                              : -1;
+    const bool hasVftables = sourceRow >= 0 && sourceRow < static_cast<int>(m_entries.size())
+                             && !m_entries[static_cast<std::size_t>(sourceRow)].vftables.empty();
+
     QMenu    menu(this);
-    QAction* copyAction   = menu.addAction(("Copy"));
+    QAction* copyAction      = menu.addAction(("Copy"));
+    QAction* instancesAction = menu.addAction(("Find Instances"));
+    QAction* subclassInstancesAction = menu.addAction(("Find Instances (Including Subclasses)"));
+    instancesAction->setEnabled(hasVftables && m_instanceThread == nullptr);
+    subclassInstancesAction->setEnabled(sourceRow >= 0 && m_instanceThread == nullptr);
     QAction* chosenAction = menu.exec(m_table->viewport()->mapToGlobal(pos));
+    if (chosenAction == instancesAction || chosenAction == subclassInstancesAction) {
+      findInstances(m_entries[static_cast<std::size_t>(sourceRow)],
+                    chosenAction == subclassInstancesAction);
+      return;
+    }
     if (chosenAction != copyAction) {
       return;
     }
@@ -349,6 +376,7 @@ QWidget* RttiWindow::buildCentralArea() {
 void RttiWindow::refreshScan() {
   if (m_processId == 0 || m_processName.isEmpty()) {
     m_entries.clear();
+    m_entryIndex.clear();
     applyFilter({});
     updateWindowState();
     return;
@@ -364,6 +392,7 @@ void RttiWindow::refreshScan() {
   const std::uint64_t generation = ++m_scanGeneration;
 
   m_entries.clear();
+  m_entryIndex.clear();
   m_filteredRows.clear();
   if (m_tableModel != nullptr) {
     m_tableModel->set_data_sources(&m_entries, &m_filteredRows);
@@ -383,6 +412,42 @@ void RttiWindow::refreshScan() {
       return;
     }
 
+    // Both passes stream into the table as they go: types first, then their vftables. The
+    // callbacks are serialized by the scanner, so the counters need no locking.
+    constexpr std::size_t kBatchSize   = 1500;
+    std::size_t           typeCount    = 0;
+    std::size_t           withVftables = 0;
+
+    const auto onTypes = [this, generation, &typeCount, &withVftables](
+                             std::vector<memory::RttiScanner::TypeInfo>&& batch) {
+      typeCount += batch.size();
+      for (const auto& entry : batch) {
+        withVftables += entry.vftables.empty() ? 0 : 1;
+      }
+
+      auto batchPtr =
+          std::make_shared<std::vector<memory::RttiScanner::TypeInfo>>(std::move(batch));
+      QMetaObject::invokeMethod(
+          this,
+          [this, generation, batchPtr]() mutable {
+            appendScanBatch(generation, std::move(*batchPtr));
+          },
+          Qt::QueuedConnection);
+    };
+    const auto onVftables = [this, generation, &withVftables](
+                                std::vector<memory::RttiScanner::VftableUpdate>&& batch) {
+      withVftables += batch.size();
+
+      auto batchPtr =
+          std::make_shared<std::vector<memory::RttiScanner::VftableUpdate>>(std::move(batch));
+      QMetaObject::invokeMethod(
+          this,
+          [this, generation, batchPtr]() mutable {
+            applyVftableBatch(generation, std::move(*batchPtr));
+          },
+          Qt::QueuedConnection);
+    };
+
     memory::RttiScanner              scanner(&reader);
     memory::RttiScanner::ScanOptions fast_options{};
     fast_options.max_results                   = 60000;
@@ -393,12 +458,12 @@ void RttiWindow::refreshScan() {
     fast_options.require_executable_first_slot = true;
     fast_options.include_writable_regions      = false;
     fast_options.demangle_names                = true;
+    fast_options.cache_directory               = rttiCacheDirectory();
 
-    auto results = scanner.find_all(fast_options);
+    scanner.find_all_batched(fast_options, kBatchSize, onTypes, onVftables);
 
-    const std::size_t withVftables = countEntriesWithVftables(results);
-    const bool        sparseVftables = !results.empty() && (withVftables * 5 < results.size());
-    if (results.empty() || sparseVftables) {
+    const bool sparseVftables = typeCount != 0 && (withVftables * 5 < typeCount);
+    if (typeCount == 0 || sparseVftables) {
       memory::RttiScanner::ScanOptions fallback_options{};
       fallback_options.max_results                   = 60000;
       fallback_options.max_candidates                = 16 * 1024 * 1024;
@@ -408,33 +473,11 @@ void RttiWindow::refreshScan() {
       fallback_options.require_executable_first_slot = true;
       fallback_options.include_writable_regions      = true;
       fallback_options.demangle_names                = true;
+      // Sweep every committed region, which also covers images the loader does not list.
+      fallback_options.scope_to_module_sections      = false;
 
-      auto fallbackResults = scanner.find_all(fallback_options);
-      if (results.empty()) {
-        results = std::move(fallbackResults);
-      } else {
-        mergeScanResults(results, std::move(fallbackResults));
-      }
-    }
-
-    constexpr std::size_t kBatchSize = 1500;
-    for (std::size_t offset = 0; offset < results.size(); offset += kBatchSize) {
-      const std::size_t count = (std::min)(kBatchSize, results.size() - offset);
-      std::vector<memory::RttiScanner::TypeInfo> batch;
-      batch.reserve(count);
-      batch.insert(
-          batch.end(),
-          std::make_move_iterator(results.begin() + static_cast<std::ptrdiff_t>(offset)),
-          std::make_move_iterator(results.begin() + static_cast<std::ptrdiff_t>(offset + count)));
-
-      auto batchPtr =
-          std::make_shared<std::vector<memory::RttiScanner::TypeInfo>>(std::move(batch));
-      QMetaObject::invokeMethod(
-          this,
-          [this, generation, batchPtr]() mutable {
-            appendScanBatch(generation, std::move(*batchPtr));
-          },
-          Qt::QueuedConnection);
+      // Types the first pass already delivered are merged into their rows by appendScanBatch.
+      scanner.find_all_batched(fallback_options, kBatchSize, onTypes, onVftables);
     }
   });
 
@@ -465,6 +508,131 @@ void RttiWindow::refreshScan() {
   thread->start();
 }
 
+void RttiWindow::findInstances(const memory::RttiScanner::TypeInfo& entry, bool includeSubclasses) {
+  if (m_processId == 0 || (entry.vftables.empty() && !includeSubclasses)
+      || m_instanceThread != nullptr) {
+    return;
+  }
+
+  auto* dialog = new QDialog(this);
+  dialog->setAttribute(Qt::WA_DeleteOnClose);
+  dialog->setWindowTitle(QString(("Instances of %1")).arg(displayDemangledName(entry)));
+  dialog->resize(520, 420);
+
+  auto* layout = new QVBoxLayout(dialog);
+  auto* status = new QLabel(("Scanning writable memory..."), dialog);
+  auto* list   = new QListWidget(dialog);
+  list->setUniformItemSizes(true);
+  list->setSelectionMode(QAbstractItemView::ExtendedSelection);
+  list->setContextMenuPolicy(Qt::CustomContextMenu);
+  layout->addWidget(status);
+  layout->addWidget(list, 1);
+
+  connect(list, &QWidget::customContextMenuRequested, dialog, [list](const QPoint& pos) {
+    const auto selected = list->selectedItems();
+    if (selected.isEmpty()) {
+      return;
+    }
+
+    QMenu    menu(list);
+    QAction* copyAction = menu.addAction(("Copy"));
+    if (menu.exec(list->viewport()->mapToGlobal(pos)) != copyAction) {
+      return;
+    }
+
+    QStringList lines;
+    for (const auto* item : selected) {
+      lines.push_back(item->text());
+    }
+    QApplication::clipboard()->setText(lines.join(('\n')));
+  });
+
+  dialog->show();
+
+  // Secondary vftables mark base-class subobjects and subclasses have vftables of their own, so
+  // the matching vftable is shown whenever there is more than one.
+  constexpr std::size_t       kMaxInstances  = 200000;
+  const bool                  showVftable    = includeSubclasses || entry.vftables.size() > 1;
+  const std::uintptr_t        typeDescriptor = entry.type_descriptor;
+  const std::uint32_t         processId      = m_processId;
+  const QPointer<QListWidget> listGuard(list);
+
+  // Subclasses come from a hierarchy extracted on the worker, from a copy of the scan result.
+  auto types = std::make_shared<std::vector<memory::RttiScanner::TypeInfo>>();
+  if (includeSubclasses) {
+    *types = m_entries;
+  }
+
+  QThread* thread = QThread::create([this,
+                                     processId,
+                                     vftables = entry.vftables,
+                                     types,
+                                     typeDescriptor,
+                                     showVftable,
+                                     listGuard]() mutable {
+    memory::MemoryReader reader;
+    if (!reader.attach(static_cast<memory::Process::Id>(processId))) {
+      return;
+    }
+
+    if (!types->empty()) {
+      auto              hierarchy = memory::RttiScanner(&reader).extract_hierarchy(*types);
+      const std::size_t index     = hierarchy.find(typeDescriptor);
+      if (index == memory::ClassHierarchy::npos) {
+        return;
+      }
+      vftables = hierarchy.vftablesOf(index, true);
+    }
+
+    memory::InstanceFinder::ScanOptions options{};
+    options.max_results = kMaxInstances;
+    options.batch_size  = 2048;
+
+    memory::InstanceFinder(&reader).find_all_batched(
+        vftables,
+        options,
+        [this, showVftable, listGuard](std::vector<memory::InstanceFinder::Instance>&& batch) {
+          QStringList lines;
+          lines.reserve(static_cast<int>(batch.size()));
+          for (const auto& instance : batch) {
+            QString line = formatAddressInternal(instance.address);
+            if (showVftable) {
+              line += QString(("  (vftable %1)")).arg(formatAddressInternal(instance.vftable));
+            }
+            lines.push_back(line);
+          }
+
+          QMetaObject::invokeMethod(
+              this,
+              [listGuard, lines = std::move(lines)]() {
+                if (listGuard != nullptr) {
+                  listGuard->addItems(lines);
+                }
+              },
+              Qt::QueuedConnection);
+        });
+  });
+
+  m_instanceThread = thread;
+  const QPointer<QLabel> statusGuard(status);
+  connect(thread, &QThread::finished, this, [this, thread, statusGuard, listGuard]() {
+    if (m_instanceThread == thread) {
+      m_instanceThread = nullptr;
+    }
+    thread->deleteLater();
+
+    if (statusGuard == nullptr || listGuard == nullptr) {
+      return;
+    }
+    const int count = listGuard->count();
+    statusGuard->setText(count >= static_cast<int>(kMaxInstances)
+                             ? QString(("%1 instances (limit reached)")).arg(count)
+                             : QString(("%1 instances")).arg(count));
+  });
+
+  thread->start();
+}
+
 void RttiWindow::appendScanBatch(std::uint64_t                                generation,
                                  std::vector<memory::RttiScanner::TypeInfo>&& batch) {
   if (generation != m_scanGeneration || batch.empty()) {
@@ -475,24 +643,27 @@ void RttiWindow::appendScanBatch(std::uint64_t                                ge
       m_filterInput == nullptr ? QString{} : m_filterInput->text().trimmed();
   const bool filterEmpty = activeFilter.isEmpty();
 
-  const int start = static_cast<int>(m_entries.size());
-  m_entries.insert(m_entries.end(),
-                   std::make_move_iterator(batch.begin()),
-                   std::make_move_iterator(batch.end()));
+  m_entries.reserve(m_entries.size() + batch.size());
+  for (auto& incoming : batch) {
+    const auto [found, inserted] =
+        m_entryIndex.try_emplace(incoming.type_descriptor, m_entries.size());
+    if (!inserted) {
+      // Seen by an earlier pass: keep its row and merge the name and vftables.
+      auto& target = m_entries[found->second];
+      if (target.demangled_name.empty() && !incoming.demangled_name.empty()) {
+        target.demangled_name = std::move(incoming.demangled_name);
+      }
+      mergeVftables(target.vftables, incoming.vftables);
+      continue;
+    }
 
-  if (filterEmpty) {
-    m_filteredRows.reserve(m_entries.size());
-    for (int row = start; row < static_cast<int>(m_entries.size()); ++row) {
+    const int row = static_cast<int>(m_entries.size());
+    m_entries.push_back(std::move(incoming));
+    if (filterEmpty
+        || QString::fromStdString(m_entries.back().demangled_name)
+               .contains(activeFilter, Qt::CaseInsensitive)) {
       m_filteredRows.push_back(row);
     }
-  } else {
-    for (int row = start; row < static_cast<int>(m_entries.size()); ++row) {
-      const auto&   entry     = m_entries[static_cast<std::size_t>(row)];
-      const QString demangled = QString::fromStdString(entry.demangled_name);
-      if (demangled.contains(activeFilter, Qt::CaseInsensitive)) {
-        m_filteredRows.push_back(row);
-      }
-    }
   }
 
   if (m_tableModel != nullptr) {
@@ -502,12 +673,45 @@ void RttiWindow::appendScanBatch(std::uint64_t                                ge
   updateWindowState();
 }
 
+void RttiWindow::applyVftableBatch(std::uint64_t                                     generation,
+                                   std::vector<memory::RttiScanner::VftableUpdate>&& batch) {
+  if (generation != m_scanGeneration || batch.empty()) {
+    return;
+  }
+
+  for (const auto& update : batch) {
+    const auto found = m_entryIndex.find(update.type_descriptor);
+    if (found != m_entryIndex.end()) {
+      mergeVftables(m_entries[found->second].vftables, update.vftables);
+    }
+  }
+
+  if (m_tableModel != nullptr) {
+    m_tableModel->refresh_vftables();
+  }
+}
+
 void RttiWindow::onScanFinished(std::uint64_t generation) {
   if (generation != m_scanGeneration) {
     return;
   }
+
+  // Batches arrive in discovery order; the finished table is in address order.
+  std::sort(m_entries.begin(),
+            m_entries.end(),
+            [](const memory::RttiScanner::TypeInfo& a, const memory::RttiScanner::TypeInfo& b) {
+              return a.type_descriptor < b.type_descriptor;
+            });
+  m_entryIndex.clear();
+  for (std::size_t i = 0; i < m_entries.size(); ++i) {
+    m_entryIndex.emplace(m_entries[i].type_descriptor, i);
+  }
   applyFilter(m_filterInput == nullptr ? QString{} : m_filterInput->text());
   updateWindowState();
+
+  if (m_scanFinishedHandler) {
+    m_scanFinishedHandler(m_processId, m_entries);
+  }
 }
 
 void RttiWindow::applyFilter(const QString& query) {
@@ -2,19 +2,26 @@
 #include "q_lit.hpp"
 
 #include "farcal/memory/MemoryReader.hpp"
+#include "farcal/memory/XrefFinder.hpp"
 
 #include <QAbstractItemView>
 #include <QAbstractTableModel>
 #include <QApplication>
+#include <QCheckBox>
 #include <QClipboard>
+#include <QDialog>
 #include <QFrame>
 #include <QHBoxLayout>
 #include <QHeaderView>
+#include <QItemSelectionModel>
 #include <QLabel>
 #include <QLineEdit>
+#include <QListWidget>
 #include <QMenu>
 #include <QMetaObject>
+#include <QPointer>
 #include <QPushButton>
+#include <QStringList>
 #include <QTableView>
 #include <QThread>
 #include <QVBoxLayout>
@@ -23,6 +30,8 @@
 #include <algorithm>
 #include <iterator>
 #include <memory>
+#include <string_view>
+#include <unordered_map>
 #include <utility>
 
 namespace farcal::ui {
@@ -36,11 +45,34 @@ QString formatAddressInternal(std::uintptr_t address) {
       .toUpper();
 }
 
-bool stringMatchesFilter(const std::string& text, const QString& query) {
-  if (query.isEmpty()) {
-    return true;
+QString toQString(std::string_view text) {
+  return QString::fromUtf8(text.data(), static_cast<qsizetype>(text.size()));
+}
+
+constexpr std::size_t kMaxStrings = 250000;
+
+std::string foldedQuery(const QString& query) {
+  return memory::StringIndex::fold(query.trimmed().toStdString());
+}
+
+// The record a change is shown as: the old one for a removed string, the new one otherwise.
+const memory::StringScanner::StringRecord& changedRecord(
+    const memory::StringSnapshot::Change&                   change,
+    const std::vector<memory::StringScanner::StringRecord>& before,
+    const std::vector<memory::StringScanner::StringRecord>& after) {
+  return change.kind == memory::StringSnapshot::ChangeKind::Removed ? before[change.before_row]
+                                                                     : after[change.after_row];
+}
+
+QString changeName(memory::StringSnapshot::ChangeKind kind) {
+  switch (kind) {
+    case memory::StringSnapshot::ChangeKind::Added:
+      return ("Added");
+    case memory::StringSnapshot::ChangeKind::Removed:
+      return ("Removed");
+    default:
+      return ("Modified");
   }
-  return QString::fromStdString(text).contains(query, Qt::CaseInsensitive);
 }
 
 }  // namespace
@@ -49,11 +81,17 @@ class StringsTableModel final : public QAbstractTableModel {
  public:
   explicit StringsTableModel(QObject* parent = nullptr) : QAbstractTableModel(parent) {}
 
-  void set_data_sources(const std::vector<memory::StringScanner::StringEntry>* entries,
-                        const std::vector<int>*                                visible_rows) {
+  // With `changes`, visible rows index the changes, whose records come from `baseline` (removed)
+  // or `entries`, and a third column names the change.
+  void set_data_sources(const std::vector<memory::StringScanner::StringRecord>* entries,
+                        const std::vector<int>*                                 visible_rows,
+                        const std::vector<memory::StringSnapshot::Change>*      changes  = nullptr,
+                        const std::vector<memory::StringScanner::StringRecord>* baseline = nullptr) {
     beginResetModel();
     m_entries     = entries;
     m_visibleRows = visible_rows;
+    m_changes     = changes;
+    m_baseline    = baseline;
     endResetModel();
   }
 
@@ -68,12 +106,12 @@ class StringsTableModel final : public QAbstractTableModel {
     if (parent.isValid()) {
       return 0;
     }
-    return 2;
+    return m_changes != nullptr ? 3 : 2;
   }
 
   QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override {
-    if (!index.isValid() || role != Qt::DisplayRole || m_entries == nullptr
-        || m_visibleRows == nullptr) {
+    if (!index.isValid() || (role != Qt::DisplayRole && role != Qt::ToolTipRole)
+        || m_entries == nullptr || m_visibleRows == nullptr) {
       return {};
     }
 
@@ -83,19 +121,29 @@ class StringsTableModel final : public QAbstractTableModel {
     }
 
     const int sourceRow = (*m_visibleRows)[static_cast<std::size_t>(viewRow)];
-    if (sourceRow < 0 || sourceRow >= static_cast<int>(m_entries->size())) {
-      return {};
+    if (m_changes != nullptr) {
+      if (sourceRow < 0 || sourceRow >= static_cast<int>(m_changes->size())) {
+        return {};
+      }
+
+      const auto& change = (*m_changes)[static_cast<std::size_t>(sourceRow)];
+      if (role == Qt::ToolTipRole) {
+        if (index.column() != 1 || change.kind != memory::StringSnapshot::ChangeKind::Modified) {
+          return {};
+        }
+        return QString(("Was: %1")).arg(toQString((*m_baseline)[change.before_row].text()));
+      }
+      if (index.column() == 2) {
+        return changeName(change.kind);
+      }
+      return describe(changedRecord(change, *m_baseline, *m_entries), index.column());
     }
 
-    const auto& entry = (*m_entries)[static_cast<std::size_t>(sourceRow)];
-    switch (index.column()) {
-      case 0:
-        return formatAddressInternal(entry.address);
-      case 1:
-        return QString::fromStdString(entry.text);
-      default:
-        return {};
+    if (role != Qt::DisplayRole || sourceRow < 0
+        || sourceRow >= static_cast<int>(m_entries->size())) {
+      return {};
     }
+    return describe((*m_entries)[static_cast<std::size_t>(sourceRow)], index.column());
   }
 
   QVariant headerData(int             section,
@@ -110,14 +158,29 @@ class StringsTableModel final : public QAbstractTableModel {
         return ("Address");
       case 1:
         return ("String");
+      case 2:
+        return ("Change");
       default:
         return {};
     }
   }
 
  private:
-  const std::vector<memory::StringScanner::StringEntry>* m_entries     = nullptr;
-  const std::vector<int>*                                m_visibleRows = nullptr;
+  static QVariant describe(const memory::StringScanner::StringRecord& entry, int column) {
+    switch (column) {
+      case 0:
+        return formatAddressInternal(entry.address);
+      case 1:
+        return toQString(entry.text());
+      default:
+        return {};
+    }
+  }
+
+  const std::vector<memory::StringScanner::StringRecord>* m_entries     = nullptr;
+  const std::vector<int>*                                 m_visibleRows = nullptr;
+  const std::vector<memory::StringSnapshot::Change>*      m_changes     = nullptr;
+  const std::vector<memory::StringScanner::StringRecord>* m_baseline    = nullptr;
 };
 
 StringsWindow::StringsWindow(QWidget* parent) : QMainWindow(parent) {
@@ -132,6 +195,11 @@ StringsWindow::~StringsWindow() {
     delete m_scanThread;
     m_scanThread = nullptr;
   }
+  if (m_xrefThread != nullptr) {
+    m_xrefThread->wait();
+    delete m_xrefThread;
+    m_xrefThread = nullptr;
+  }
 }
 
 void StringsWindow::setAttachedProcess(std::uint32_t processId, const QString& processName) {
@@ -140,10 +208,11 @@ void StringsWindow::setAttachedProcess(std::uint32_t processId, const QString& p
 
   if (m_processId == 0 || m_processName.isEmpty()) {
     m_entries.clear();
+    m_pool.clear();
+    m_index.clear();
     m_filteredRows.clear();
-    if (m_tableModel != nullptr) {
-      m_tableModel->set_data_sources(&m_entries, &m_filteredRows);
-    }
+    clearSnapshots();
+    resetTableModel();
     updateWindowState();
     return;
   }
@@ -185,6 +254,21 @@ QPushButton:hover {
 QPushButton:pressed {
   background-color: #3a3e47;
 }
+QCheckBox {
+  color: #e8eaed;
+  spacing: 8px;
+}
+QCheckBox::indicator {
+  width: 17px;
+  height: 17px;
+  border: 1px solid #626876;
+  border-radius: 2px;
+  background: #23252b;
+}
+QCheckBox::indicator:checked {
+  background: #5b86c5;
+  border-color: #7ea4db;
+}
 QTableView {
   background-color: #1a1c21;
   color: #e8eaed;
@@ -228,6 +312,9 @@ QWidget* StringsWindow::buildCentralArea() {
   m_filterInput->setPlaceholderText(("Filter strings..."));
   topRow->addWidget(m_filterInput, 1);
 
+  m_changesCheckBox = new QCheckBox(("Changes since last scan"), panel);
+  topRow->addWidget(m_changesCheckBox);
+
   m_refreshButton = new QPushButton(("Refresh"), panel);
   topRow->addWidget(m_refreshButton);
   panelLayout->addLayout(topRow);
@@ -237,12 +324,12 @@ QWidget* StringsWindow::buildCentralArea() {
 
   m_table      = new QTableView(panel);
   m_tableModel = new StringsTableModel(m_table);
-  m_tableModel->set_data_sources(&m_entries, &m_filteredRows);
-
   m_table->setModel(m_tableModel);
+  resetTableModel();
+
   m_table->setEditTriggers(QAbstractItemView::NoEditTriggers);
   m_table->setSelectionBehavior(QAbstractItemView::SelectRows);
-  m_table->setSelectionMode(QAbstractItemView::SingleSelection);
+  m_table->setSelectionMode(QAbstractItemView::ExtendedSelection);
   m_table->setSortingEnabled(false);
   m_table->verticalHeader()->setVisible(false);
   m_table->horizontalHeader()->setSectionResizeMode(0, QHeaderView::ResizeToContents);
@@ -254,6 +341,7 @@ QWidget* StringsWindow::buildCentralArea() {
 
   connect(m_filterInput, &QLineEdit::textChanged, this, &StringsWindow::applyFilter);
   connect(m_refreshButton, &QPushButton::clicked, this, &StringsWindow::refreshScan);
+  connect(m_changesCheckBox, &QCheckBox::toggled, this, &StringsWindow::setShowChanges);
   connect(m_table, &QWidget::customContextMenuRequested, this, [this](const QPoint& pos) {
     if (m_table == nullptr) {
       return;
@@ -264,9 +352,22 @@ QWidget* StringsWindow::buildCentralArea() {
       return;
     }
 
+    std::vector<const memory::StringScanner::StringRecord*> selected;
+    for (const QModelIndex& row : m_table->selectionModel()->selectedRows()) {
+      if (const auto* record = recordAtRow(row.row()); record != nullptr) {
+        selected.push_back(record);
+      }
+    }
+
     QMenu    menu(this);
-    QAction* copyAction   = menu.addAction(("Copy"));
+    QAction* copyAction       = menu.addAction(("Copy"));
+    QAction* referencesAction = menu.addAction(("Find References"));
+    referencesAction->setEnabled(!selected.empty() && m_xrefThread == nullptr);
     QAction* chosenAction = menu.exec(m_table->viewport()->mapToGlobal(pos));
+    if (chosenAction == referencesAction) {
+      findReferences(selected);
+      return;
+    }
     if (chosenAction != copyAction) {
       return;
     }
@@ -283,6 +384,9 @@ QWidget* StringsWindow::buildCentralArea() {
 void StringsWindow::refreshScan() {
   if (m_processId == 0 || m_processName.isEmpty()) {
     m_entries.clear();
+    m_pool.clear();
+    m_index.clear();
+    clearSnapshots();
     applyFilter({});
     updateWindowState();
     return;
@@ -297,11 +401,49 @@ void StringsWindow::refreshScan() {
   m_rescanPending                = false;
   const std::uint64_t generation = ++m_scanGeneration;
 
-  m_entries.clear();
-  m_filteredRows.clear();
-  if (m_tableModel != nullptr) {
-    m_tableModel->set_data_sources(&m_entries, &m_filteredRows);
+  // A finished scan of the same process becomes the baseline the new one is compared with. Unless
+  // the last scan hit the string cap or most of its rows have been replaced already, only the
+  // strings around the pages written since are scanned again (see beginIncrementalScan).
+  const bool        sameProcess = m_scannedProcessId == m_processId;
+  const std::size_t live        = liveEntryCount();
+  const bool        incremental = sameProcess && m_pageHashes != nullptr && !m_pageHashes->spans.empty() &&
+                           live < kMaxStrings && m_index.erasedCount() <= live;
+  if (incremental) {
+    m_baselineEntries.clear();
+    m_baselinePool.clear();
+    m_hasBaseline     = true;
+    m_firstScannedRow = m_entries.size();
+    if (m_showChanges) {
+      m_filteredRows.clear();
+    }
+  } else {
+    if (sameProcess) {
+      // Only the live rows are the previous scan's strings.
+      std::size_t kept = 0;
+      for (std::size_t row = 0; row < m_entries.size(); ++row) {
+        if (!m_index.erased(static_cast<std::uint32_t>(row))) {
+          m_entries[kept++] = m_entries[row];
+        }
+      }
+      m_entries.resize(kept);
+      m_baselineEntries = std::move(m_entries);
+      m_baselinePool    = std::move(m_pool);
+      m_hasBaseline     = true;
+    } else {
+      clearSnapshots();
+    }
+    m_entries.clear();
+    m_pool.clear();
+    m_index.clear();
+    m_filteredRows.clear();
+    m_activeQuery     = m_filterInput == nullptr ? std::string{} : foldedQuery(m_filterInput->text());
+    m_firstScannedRow = 0;
+    m_pageHashes      = std::make_shared<memory::StringScanner::PageHashes>();
   }
+  m_scannedProcessId = 0;
+  m_scanProcessId    = m_processId;
+  m_changes.clear();
+  resetTableModel();
 
   if (m_refreshButton != nullptr) {
     m_refreshButton->setEnabled(false);
@@ -310,8 +452,9 @@ void StringsWindow::refreshScan() {
     m_statusLabel->setText(("Scanning strings..."));
   }
 
-  const std::uint32_t processId = m_processId;
-  QThread*            thread    = QThread::create([this, processId, generation]() {
+  const std::uint32_t processId  = m_processId;
+  const auto          pageHashes = m_pageHashes;
+  QThread*            thread     = QThread::create([this, processId, generation, incremental, pageHashes]() {
     memory::MemoryReader reader;
     if (!reader.attach(static_cast<memory::Process::Id>(processId))) {
       return;
@@ -321,28 +464,50 @@ void StringsWindow::refreshScan() {
     memory::StringScanner::ScanOptions options{};
     options.min_length               = 4;
     options.max_length               = 512;
-    options.max_results              = 250000;
+    options.max_results              = kMaxStrings;
     options.chunk_size               = 1024 * 1024;
     options.scan_ascii               = true;
     options.scan_utf16               = true;
+    options.scan_utf8                = true;
     options.include_writable_regions = true;
     options.worker_threads =
         static_cast<std::size_t>((std::max)(1, QThread::idealThreadCount() - 1));
-    scanner.find_all_batched(
-        options, 4000, [this, generation](std::vector<memory::StringScanner::StringEntry>&& batch) {
-          if (batch.empty()) {
-            return;
-          }
+    const auto onBatch = [this, generation](memory::StringScanner::StringBatch&& batch) {
+      if (batch.records.empty()) {
+        return;
+      }
 
-          auto batchPtr =
-              std::make_shared<std::vector<memory::StringScanner::StringEntry>>(std::move(batch));
-          QMetaObject::invokeMethod(
-              this,
-              [this, generation, batchPtr]() mutable {
-                appendScanBatch(generation, std::move(*batchPtr));
-              },
-              Qt::QueuedConnection);
-        });
+      // Index the batch here, off the UI thread; the window only merges the postings.
+      auto segment = std::make_shared<memory::StringIndex::Segment>(
+          memory::StringIndex::buildSegment(batch.records.size(), [&batch](std::size_t id) {
+            return batch.records[id].text();
+          }));
+      auto batchPtr = std::make_shared<memory::StringScanner::StringBatch>(std::move(batch));
+      QMetaObject::invokeMethod(
+          this,
+          [this, generation, batchPtr, segment]() mutable {
+            appendScanBatch(generation, std::move(*batchPtr), std::move(*segment));
+          },
+          Qt::QueuedConnection);
+    };
+
+    // Hashed before scanning, so a page written while it is being scanned counts as changed the
+    // next time.
+    auto hashes = scanner.hashPages(options);
+    if (!incremental) {
+      *pageHashes = std::move(hashes);
+      scanner.find_all_batched(options, 4000, onBatch);
+      return;
+    }
+
+    auto ranges = std::make_shared<std::vector<memory::StringScanner::AddressRange>>(
+        memory::StringScanner::affectedRanges(memory::StringScanner::changedRanges(*pageHashes, hashes), options));
+    *pageHashes = std::move(hashes);
+    QMetaObject::invokeMethod(
+        this,
+        [this, generation, ranges]() { beginIncrementalScan(generation, *ranges); },
+        Qt::QueuedConnection);
+    scanner.find_in_ranges_batched(options, *ranges, 4000, onBatch);
   });
 
   m_scanThread = thread;
@@ -372,22 +537,26 @@ void StringsWindow::refreshScan() {
   thread->start();
 }
 
-void StringsWindow::appendScanBatch(std::uint64_t                                     generation,
-                                    std::vector<memory::StringScanner::StringEntry>&& batch) {
-  if (generation != m_scanGeneration || batch.empty()) {
+void StringsWindow::appendScanBatch(std::uint64_t                        generation,
+                                    memory::StringScanner::StringBatch&& batch,
+                                    memory::StringIndex::Segment&&       segment) {
+  if (generation != m_scanGeneration || batch.records.empty()) {
     return;
   }
 
-  const QString activeFilter =
-      m_filterInput == nullptr ? QString{} : m_filterInput->text().trimmed();
-  const bool filterEmpty = activeFilter.isEmpty();
-
+  // The records point into the batch's pool, so keep its blocks alive with ours.
   const int start = static_cast<int>(m_entries.size());
-  m_entries.insert(m_entries.end(),
-                   std::make_move_iterator(batch.begin()),
-                   std::make_move_iterator(batch.end()));
+  m_pool.adopt(std::move(batch.pool));
+  m_entries.insert(m_entries.end(), batch.records.begin(), batch.records.end());
+  m_index.append(segment);
+
+  // Changes are only known once the scan has finished.
+  if (m_showChanges) {
+    updateWindowState();
+    return;
+  }
 
-  if (filterEmpty) {
+  if (m_activeQuery.empty()) {
     m_filteredRows.reserve(m_entries.size());
     for (int row = start; row < static_cast<int>(m_entries.size()); ++row) {
       m_filteredRows.push_back(row);
@@ -395,16 +564,43 @@ void StringsWindow::appendScanBatch(std::uint64_t
   } else {
     for (int row = start; row < static_cast<int>(m_entries.size()); ++row) {
       const auto& entry = m_entries[static_cast<std::size_t>(row)];
-      if (stringMatchesFilter(entry.text, activeFilter)) {
+      if (memory::StringIndex::containsFolded(entry.text(), m_activeQuery)) {
         m_filteredRows.push_back(row);
       }
     }
   }
 
-  if (m_tableModel != nullptr) {
-    m_tableModel->set_data_sources(&m_entries, &m_filteredRows);
+  resetTableModel();
+  updateWindowState();
+}
+
+// Takes the strings of the rescanned ranges out of the previous scan: they become the baseline the
+// rescan's strings are compared with, and the rows stay in m_entries only as erased index ids.
+void StringsWindow::beginIncrementalScan(std::uint64_t                                            generation,
+                                         const std::vector<memory::StringScanner::AddressRange>& ranges) {
+  if (generation != m_scanGeneration || ranges.empty()) {
+    return;
   }
 
+  const auto inRanges = [&ranges](std::uintptr_t address) {
+    const auto next = std::upper_bound(
+        ranges.begin(), ranges.end(), address, [](std::uintptr_t value, const auto& range) {
+          return value < range.begin;
+        });
+    return next != ranges.begin() && address < std::prev(next)->end;
+  };
+  for (std::size_t row = 0; row < m_firstScannedRow; ++row) {
+    const auto id = static_cast<std::uint32_t>(row);
+    if (!m_index.erased(id) && inRanges(m_entries[row].address)) {
+      m_index.erase(id);
+      m_baselineEntries.push_back(m_entries[row]);
+    }
+  }
+
+  if (!m_showChanges) {
+    std::erase_if(m_filteredRows, [this](int row) { return m_index.erased(static_cast<std::uint32_t>(row)); });
+    resetTableModel();
+  }
   updateWindowState();
 }
 
@@ -412,31 +608,229 @@ void StringsWindow::onScanFinished(std::uint64_t generation) {
   if (generation != m_scanGeneration) {
     return;
   }
+
+  // An incremental scan only replaced the strings of the ranges it rescanned, so comparing those
+  // with what it found there is the whole difference.
+  m_scannedProcessId = m_scanProcessId;
+  if (m_hasBaseline) {
+    m_changes = memory::StringSnapshot::diff(memory::StringSnapshot::build(m_baselineEntries),
+                                             memory::StringSnapshot::build(m_entries, m_firstScannedRow));
+  }
   applyFilter(m_filterInput == nullptr ? QString{} : m_filterInput->text());
   updateWindowState();
 }
 
 void StringsWindow::applyFilter(const QString& query) {
-  m_filteredRows.clear();
-  m_filteredRows.reserve(m_entries.size());
+  const std::string folded = foldedQuery(query);
 
-  const QString normalized = query.trimmed();
-  for (std::size_t i = 0; i < m_entries.size(); ++i) {
-    const auto&   entry   = m_entries[i];
-    const QString text    = QString::fromStdString(entry.text);
-    const bool    matches = normalized.isEmpty() || text.contains(normalized, Qt::CaseInsensitive);
-    if (matches) {
-      m_filteredRows.push_back(static_cast<int>(i));
+  // The changes are few next to the whole scan, so they are just checked one by one.
+  if (m_showChanges) {
+    m_filteredRows.clear();
+    for (std::size_t i = 0; i < m_changes.size(); ++i) {
+      const auto& entry = changedRecord(m_changes[i], m_baselineEntries, m_entries);
+      if (folded.empty() || memory::StringIndex::containsFolded(entry.text(), folded)) {
+        m_filteredRows.push_back(static_cast<int>(i));
+      }
     }
+    m_activeQuery = folded;
+    resetTableModel();
+    updateWindowState();
+    return;
   }
 
-  if (m_tableModel != nullptr) {
-    m_tableModel->set_data_sources(&m_entries, &m_filteredRows);
+  // m_filteredRows holds the matches of m_activeQuery over all entries, so a query extending it
+  // only has to recheck those.
+  std::vector<std::uint32_t> previous;
+  const bool narrowing = !m_activeQuery.empty() && folded.find(m_activeQuery) != std::string::npos;
+  if (narrowing) {
+    previous.assign(m_filteredRows.begin(), m_filteredRows.end());
   }
 
+  const auto matches = m_index.find(
+      folded,
+      [this](std::uint32_t id) { return m_entries[id].text(); },
+      narrowing ? &previous : nullptr);
+  m_filteredRows.assign(matches.begin(), matches.end());
+  m_activeQuery = folded;
+
+  resetTableModel();
   updateWindowState();
 }
 
+void StringsWindow::setShowChanges(bool enabled) {
+  if (m_showChanges == enabled) {
+    return;
+  }
+
+  // m_filteredRows is about to index the other list, so the next query cannot narrow it.
+  m_showChanges = enabled;
+  m_activeQuery.clear();
+  applyFilter(m_filterInput == nullptr ? QString{} : m_filterInput->text());
+}
+
+void StringsWindow::clearSnapshots() {
+  m_baselineEntries.clear();
+  m_baselinePool.clear();
+  m_hasBaseline      = false;
+  m_scannedProcessId = 0;
+  m_changes.clear();
+  m_pageHashes.reset();
+}
+
+void StringsWindow::resetTableModel() {
+  if (m_tableModel == nullptr) {
+    return;
+  }
+
+  if (!m_showChanges) {
+    m_tableModel->set_data_sources(&m_entries, &m_filteredRows);
+    return;
+  }
+
+  m_tableModel->set_data_sources(&m_entries, &m_filteredRows, &m_changes, &m_baselineEntries);
+  if (m_table != nullptr) {
+    m_table->horizontalHeader()->setSectionResizeMode(2, QHeaderView::ResizeToContents);
+  }
+}
+
+const memory::StringScanner::StringRecord* StringsWindow::recordAtRow(int viewRow) const {
+  if (viewRow < 0 || viewRow >= static_cast<int>(m_filteredRows.size())) {
+    return nullptr;
+  }
+
+  const auto sourceRow = static_cast<std::size_t>(m_filteredRows[static_cast<std::size_t>(viewRow)]);
+  if (m_showChanges) {
+    return sourceRow < m_changes.size()
+               ? &changedRecord(m_changes[sourceRow], m_baselineEntries, m_entries)
+               : nullptr;
+  }
+  return sourceRow < m_entries.size() ? &m_entries[sourceRow] : nullptr;
+}
+
+void StringsWindow::findReferences(
+    const std::vector<const memory::StringScanner::StringRecord*>& records) {
+  if (m_processId == 0 || records.empty() || m_xrefThread != nullptr) {
+    return;
+  }
+
+  auto* dialog = new QDialog(this);
+  dialog->setAttribute(Qt::WA_DeleteOnClose);
+  dialog->setWindowTitle(records.size() == 1
+                             ? QString(("References to %1")).arg(formatAddressInternal(records.front()->address))
+                             : QString(("References to %1 strings")).arg(records.size()));
+  dialog->resize(620, 460);
+
+  auto* layout = new QVBoxLayout(dialog);
+  auto* status = new QLabel(("Scanning readable memory and code..."), dialog);
+  auto* list   = new QListWidget(dialog);
+  list->setUniformItemSizes(true);
+  list->setSelectionMode(QAbstractItemView::ExtendedSelection);
+  list->setContextMenuPolicy(Qt::CustomContextMenu);
+  layout->addWidget(status);
+  layout->addWidget(list, 1);
+
+  connect(list, &QWidget::customContextMenuRequested, dialog, [list](const QPoint& pos) {
+    const auto selected = list->selectedItems();
+    if (selected.isEmpty()) {
+      return;
+    }
+
+    QMenu    menu(list);
+    QAction* copyAction = menu.addAction(("Copy"));
+    if (menu.exec(list->viewport()->mapToGlobal(pos)) != copyAction) {
+      return;
+    }
+
+    QStringList lines;
+    for (const auto* item : selected) {
+      lines.push_back(item->text().trimmed());
+    }
+    QApplication::clipboard()->setText(lines.join(('\n')));
+  });
+
+  dialog->show();
+
+  // The records may be gone by the time results arrive, so the headers are taken from copies.
+  constexpr std::size_t kMaxReferences = 200000;
+  auto texts = std::make_shared<std::unordered_map<std::uintptr_t, QString>>();
+  std::vector<std::uintptr_t> targets;
+  targets.reserve(records.size());
+  for (const auto* record : records) {
+    targets.push_back(record->address);
+    texts->emplace(record->address, toQString(record->text()));
+  }
+
+  const std::uint32_t         processId = m_processId;
+  const QPointer<QListWidget> listGuard(list);
+  auto                        references = std::make_shared<std::size_t>(0);
+
+  QThread* thread = QThread::create(
+      [this, processId, targets = std::move(targets), texts, listGuard, references]() {
+    memory::MemoryReader reader;
+    if (!reader.attach(static_cast<memory::Process::Id>(processId))) {
+      return;
+    }
+
+    memory::XrefFinder::ScanOptions options{};
+    options.max_results = kMaxReferences;
+    options.batch_size  = 2048;
+
+    // Batches arrive grouped by target, one at a time, so a header goes before the first
+    // reference to each target even when its group spans batches.
+    memory::XrefFinder(&reader).find_all_batched(
+        targets,
+        options,
+        [this, texts, listGuard, references, lastTarget = std::uintptr_t{0}](
+            std::vector<memory::XrefFinder::Reference>&& batch) mutable {
+          QStringList lines;
+          lines.reserve(static_cast<int>(batch.size()));
+          for (const auto& reference : batch) {
+            if (reference.target != lastTarget) {
+              lastTarget = reference.target;
+              lines.push_back(QString(("%1  \"%2\""))
+                                  .arg(formatAddressInternal(reference.target), texts->at(reference.target)));
+            }
+            lines.push_back(QString(("    %1  %2"))
+                                .arg(formatAddressInternal(reference.address))
+                                .arg(reference.kind == memory::XrefFinder::Kind::Code ? QString(("code"))
+                                                                                       : QString(("pointer"))));
+          }
+          *references += batch.size();
+
+          QMetaObject::invokeMethod(
+              this,
+              [listGuard, lines = std::move(lines)]() {
+                if (listGuard != nullptr) {
+                  listGuard->addItems(lines);
+                }
+              },
+              Qt::QueuedConnection);
+        });
+  });
+
+  m_xrefThread = thread;
+  const QPointer<QLabel> statusGuard(status);
+  connect(thread, &QThread::finished, this, [this, thread, statusGuard, references]() {
+    if (m_xrefThread == thread) {
+      m_xrefThread = nullptr;
+    }
+    thread->deleteLater();
+
+    if (statusGuard == nullptr) {
+      return;
+    }
+    statusGuard->setText(*references >= kMaxReferences
+                             ? QString(("%1 references (limit reached)")).arg(*references)
+                             : QString(("%1 references")).arg(*references));
+  });
+
+  thread->start();
+}
+
+std::size_t StringsWindow::liveEntryCount() const {
+  return m_entries.size() - m_index.erasedCount();
+}
+
 void StringsWindow::updateWindowState() {
   if (m_processId != 0 && !m_processName.isEmpty()) {
     setWindowTitle(QString(("String Scanner - %1")).arg(m_processName));
@@ -459,10 +853,37 @@ void StringsWindow::updateWindowState() {
     return;
   }
 
+  if (m_showChanges) {
+    if (!m_hasBaseline) {
+      m_statusLabel->setText(
+          QString(("Attached: %1 (PID %2)  |  Strings: %3  |  Refresh to compare with this scan"))
+              .arg(m_processName)
+              .arg(m_processId)
+              .arg(liveEntryCount()));
+      return;
+    }
+
+    std::size_t counts[3] = {};
+    for (const auto& change : m_changes) {
+      ++counts[static_cast<std::size_t>(change.kind)];
+    }
+    m_statusLabel->setText(
+        QString(("Attached: %1 (PID %2)  |  Strings: %3  |  Added: %4  Removed: %5  Modified: %6  |  "
+                 "Visible: %7"))
+            .arg(m_processName)
+            .arg(m_processId)
+            .arg(liveEntryCount())
+            .arg(counts[0])
+            .arg(counts[1])
+            .arg(counts[2])
+            .arg(m_filteredRows.size()));
+    return;
+  }
+
   m_statusLabel->setText(QString(("Attached: %1 (PID %2)  |  Strings: %3  |  Visible: %4"))
                              .arg(m_processName)
                              .arg(m_processId)
-                             .arg(m_entries.size())
+                             .arg(liveEntryCount())
                              .arg(m_filteredRows.size()));
 }
 
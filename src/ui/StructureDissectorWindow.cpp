@@ -18,6 +18,7 @@
 #include <QMessageBox>
 #include <QMetaObject>
 #include <QPushButton>
+#include <QStringList>
 #include <QThread>
 #include <QTreeWidget>
 #include <QTreeWidgetItem>
@@ -29,6 +30,7 @@
 #include <cmath>
 #include <cstring>
 #include <memory>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -214,7 +216,7 @@ bool isValidRttiName(const std::string& value) {
   return false;
 }
 
-QString resolvePointerRtti(const memory::RttiScanner&                   scanner,
+QString resolvePointerRtti(memory::RttiLookup&                          lookup,
                            const memory::MemoryReader&                  reader,
                            std::uintptr_t                               candidate,
                            std::uintptr_t                               minAddress,
@@ -241,7 +243,7 @@ QString resolvePointerRtti(const memory::RttiScanner&                   scanner,
     }
 
     QString    resolvedRtti;
-    const auto rttiName = scanner.get_rtti_of_address(address, true);
+    const auto rttiName = lookup.nameOfAddress(address);
     if (rttiName.has_value() && isValidRttiName(*rttiName)) {
       resolvedRtti = QString::fromStdString(*rttiName);
     }
@@ -309,7 +311,8 @@ QString resolvePointerRtti(const memory::RttiScanner&                   scanner,
 StructureDissectorWindow::StructureDissectorWindow(QWidget* parent)
   : QMainWindow(parent),
     m_memoryReader(std::make_unique<memory::MemoryReader>()),
-    m_rttiScanner(std::make_unique<memory::RttiScanner>(m_memoryReader.get())) {
+    m_rttiScanner(std::make_unique<memory::RttiScanner>(m_memoryReader.get())),
+    m_rttiLookup(std::make_unique<memory::RttiLookup>(m_rttiScanner.get())) {
   applyTheme();
   configureWindow();
   updateWindowState();
@@ -328,6 +331,18 @@ StructureDissectorWindow::~StructureDissectorWindow() {
   }
 }
 
+void StructureDissectorWindow::setKnownRttiTypes(
+    std::uint32_t processId, const std::vector<memory::RttiScanner::TypeInfo>& types) {
+  if (processId == 0 || processId != m_processId) {
+    return;
+  }
+
+  m_knownRttiTypes = std::make_shared<const std::vector<memory::RttiScanner::TypeInfo>>(types);
+  m_knownHierarchy.reset();
+  m_rttiLookup->clear();
+  m_rttiLookup->seed(*m_knownRttiTypes);
+}
+
 void StructureDissectorWindow::setAttachedProcess(std::uint32_t  processId,
                                                   const QString& processName) {
   m_shouldStop.store(true, std::memory_order_release);
@@ -345,10 +360,20 @@ void StructureDissectorWindow::setAttachedProcess(std::uint32_t  processId,
   m_refillPending  = false;
   m_shouldStop.store(false, std::memory_order_release);
 
+  if (processId != m_processId) {
+    m_knownRttiTypes.reset();
+    m_knownHierarchy.reset();
+  }
   m_processId   = processId;
   m_processName = processName;
   ++m_fillGeneration;
 
+  // Vftables resolved for the previous attach may not be vftables any more.
+  m_rttiLookup->clear();
+  if (m_knownRttiTypes) {
+    m_rttiLookup->seed(*m_knownRttiTypes);
+  }
+
   if (m_memoryReader == nullptr || processId == 0 || processName.isEmpty()) {
     if (m_memoryReader != nullptr) {
       m_memoryReader->detach();
@@ -607,10 +632,13 @@ void StructureDissectorWindow::startFillAddressTable(std::uintptr_t startAddress
   }
   m_tree->clear();
 
-  const std::uint32_t                processId = m_processId;
+  const std::uint32_t                processId      = m_processId;
+  const auto                         knownTypes     = m_knownRttiTypes;
+  const auto                         knownHierarchy = m_knownHierarchy;
   QPointer<StructureDissectorWindow> self(this);
 
-  QThread* thread = QThread::create([self, processId, startAddress, generation]() {
+  QThread* thread = QThread::create(
+      [self, processId, knownTypes, knownHierarchy, startAddress, generation]() {
     if (!self || self->m_shouldStop.load(std::memory_order_acquire)) {
       return;
     }
@@ -634,11 +662,31 @@ void StructureDissectorWindow::startFillAddressTable(std::uintptr_t startAddress
     LOG_INFO(QString(("Structure Dissector: Attached to process %1")).arg(processId));
 
     memory::RttiScanner scanner(&reader);
+    memory::RttiLookup  lookup(&scanner);
+    if (knownTypes) {
+      lookup.seed(*knownTypes);
+    }
     LOG_INFO(("Structure Dissector: RttiScanner initialized"));
     std::unordered_map<std::uintptr_t, QString> rttiCache;
     rttiCache.reserve(1024);
 
 #ifdef Q_OS_WIN
+    std::shared_ptr<const KnownHierarchy> hierarchy = knownHierarchy;
+    if (knownTypes && !hierarchy) {
+      hierarchy = buildKnownHierarchy(scanner, *knownTypes);
+      if (self) {
+        QMetaObject::invokeMethod(
+            self,
+            [self, knownTypes, hierarchy]() {
+              // Unless a newer scan result replaced the one this was extracted from.
+              if (self && self->m_knownRttiTypes == knownTypes) {
+                self->m_knownHierarchy = hierarchy;
+              }
+            },
+            Qt::QueuedConnection);
+      }
+    }
+
     SYSTEM_INFO systemInfo{};
     ::GetSystemInfo(&systemInfo);
     const std::uintptr_t minAddress =
@@ -762,10 +810,13 @@ void StructureDissectorWindow::startFillAddressTable(std::uintptr_t startAddress
 
             LOG_DEBUG(QString(("Attempting RTTI lookup for pointer 0x%1")).arg(candidate, 0, 16));
             display.rtti =
-                resolvePointerRtti(scanner, reader, candidate, minAddress, maxAddress, rttiCache);
+                resolvePointerRtti(lookup, reader, candidate, minAddress, maxAddress, rttiCache);
             if (!display.rtti.isEmpty()) {
               LOG_INFO(
                   QString(("RTTI found for 0x%1: %2")).arg(candidate, 0, 16).arg(display.rtti));
+              if (hierarchy) {
+                display.rttiBases = baseChainOf(*hierarchy, display.rtti);
+              }
             } else {
               LOG_DEBUG(QString(("No RTTI found for 0x%1")).arg(candidate, 0, 16));
             }
@@ -860,6 +911,9 @@ void StructureDissectorWindow::appendRowBatch(
     auto* item = new QTreeWidgetItem();
     item->setText(0, row.address);
     item->setText(1, row.rtti);
+    if (!row.rttiBases.isEmpty()) {
+      item->setToolTip(1, row.rttiBases);
+    }
     item->setText(2, row.offset);
     item->setText(3, row.type);
     item->setText(4, row.byteValue);
@@ -915,6 +969,38 @@ QString StructureDissectorWindow::formatAddress(std::uintptr_t address) {
   return QString(("0x%1")).arg(static_cast<qulonglong>(address), kWidth, 16, QChar('0')).toUpper();
 }
 
+std::shared_ptr<const StructureDissectorWindow::KnownHierarchy>
+StructureDissectorWindow::buildKnownHierarchy(
+    const memory::RttiScanner& scanner, const std::vector<memory::RttiScanner::TypeInfo>& types) {
+  auto known       = std::make_shared<KnownHierarchy>();
+  known->hierarchy = scanner.extract_hierarchy(types);
+  known->byName.reserve(known->hierarchy.size());
+  for (std::size_t index = 0; index < known->hierarchy.size(); ++index) {
+    known->byName.try_emplace(known->hierarchy[index].name, index);
+  }
+  return known;
+}
+
+// A resolved type name followed by all its known bases ("Derived : Base : Root"); empty when the
+// type has none.
+QString StructureDissectorWindow::baseChainOf(const KnownHierarchy& known, const QString& rtti) {
+  const auto it = known.byName.find(rtti.toStdString());
+  if (it == known.byName.end()) {
+    return {};
+  }
+
+  const auto bases = known.hierarchy.allBasesOf(it->second, true);
+  if (bases.size() < 2) {
+    return {};
+  }
+  QStringList names;
+  names.reserve(static_cast<int>(bases.size()));
+  for (const std::size_t base : bases) {
+    names.push_back(QString::fromStdString(known.hierarchy[base].name));
+  }
+  return names.join((" : "));
+}
+
 void StructureDissectorWindow::showRebaseDialog() {
   auto* dialog = new QDialog(this);
   dialog->setWindowTitle(("Rebase Addresses"));
@@ -1116,6 +1202,7 @@ void StructureDissectorWindow::loadChildrenForItem(QTreeWidgetItem* item, int ch
     QString type         = decoded.type;
     QString valueDisplay = decoded.display;
     QString rtti;
+    QString rttiBases;
     bool    isPointer = false;
     if (hasQword && qwordValue != 0) {
 #ifdef Q_OS_WIN
@@ -1130,11 +1217,14 @@ void StructureDissectorWindow::loadChildrenForItem(QTreeWidgetItem* item, int ch
                       .arg(qwordValue, 0, 16));
 
         // Try to get RTTI for this pointer
-        if (m_rttiScanner) {
+        if (m_rttiLookup) {
           rtti = resolvePointerRtti(
-              *m_rttiScanner, *m_memoryReader, candidate, minAddress, maxAddress, rttiCache);
+              *m_rttiLookup, *m_memoryReader, candidate, minAddress, maxAddress, rttiCache);
           if (!rtti.isEmpty()) {
             LOG_INFO(QString(("Child RTTI found for 0x%1: %2")).arg(qwordValue, 0, 16).arg(rtti));
+            if (m_knownHierarchy) {
+              rttiBases = baseChainOf(*m_knownHierarchy, rtti);
+            }
           } else {
             LOG_DEBUG(QString(("No child RTTI for 0x%1")).arg(qwordValue, 0, 16));
           }
@@ -1146,6 +1236,9 @@ void StructureDissectorWindow::loadChildrenForItem(QTreeWidgetItem* item, int ch
     auto* childItem = new QTreeWidgetItem();
     childItem->setText(0, formatAddress(address));
     childItem->setText(1, rtti);
+    if (!rttiBases.isEmpty()) {
+      childItem->setToolTip(1, rttiBases);
+    }
     childItem->setText(2, QString(("0x%1")).arg(i, 0, 16).toUpper());
     childItem->setText(3, type);
     childItem->setText(
@@ -0,0 +1,43 @@
+#include "farcal/memory/ClassHierarchy.hpp"
+
+#include "TestSupport.hpp"
+
+#include <vector>
+
+namespace farcal::tests {
+
+namespace {
+
+using memory::ClassHierarchy;
+
+// Classes added after a subclass query must show up in the next one instead of indexing past the
+// reverse adjacency built for the smaller graph.
+void addAfterSubclassQuery() {
+  ClassHierarchy hierarchy;
+  const std::size_t base    = hierarchy.add(0x1000, "Base");
+  const std::size_t derived = hierarchy.add(0x2000, "Derived");
+  hierarchy.setBases(derived, {ClassHierarchy::Base{base}});
+
+  check(hierarchy.directSubclassesOf(base).size() == 1, "Base has one direct subclass");
+
+  const std::size_t leaf = hierarchy.add(0x3000, "Leaf");
+  check(hierarchy.directSubclassesOf(leaf).empty(), "a class added after a query has no subclasses");
+  check(hierarchy.allSubclassesOf(leaf).empty(), "a class added after a query has no descendants");
+
+  hierarchy.setBases(leaf, {ClassHierarchy::Base{derived}});
+  const std::size_t other = hierarchy.add(0x4000, "Other");
+  check(hierarchy.directSubclassesOf(other).empty(), "a class added after setBases has no subclasses");
+  check(hierarchy.allSubclassesOf(base) == std::vector<std::size_t>{derived, leaf},
+        "Base reaches Derived and Leaf");
+
+  check(hierarchy.add(0x1000, "Base again") == base, "adding a known type descriptor returns its index");
+  check(hierarchy.allSubclassesOf(base).size() == 2, "re-adding a known class keeps the index valid");
+}
+
+}  // namespace
+
+void runClassHierarchyTests() {
+  addAfterSubclassQuery();
+}
+
+}  // namespace farcal::tests
@@ -0,0 +1,63 @@
+#include "farcal/memory/ItaniumDemangler.hpp"
+
+#include "TestSupport.hpp"
+
+#include <optional>
+#include <string>
+
+namespace farcal::tests {
+
+namespace {
+
+using memory::ItaniumDemangler;
+
+struct DemangleCase {
+  const char*                mangled;
+  std::optional<std::string> expected;  // nullopt: rejected
+};
+
+// Expected names are what __cxa_demangle prints for the same strings.
+const DemangleCase kDemangleCases[] = {
+    {"3Foo", "Foo"},
+    {"N4game6PlayerE", "game::Player"},
+    {"N4game5Actor4NodeE", "game::Actor::Node"},
+    {"St4pairIiiE", "std::pair<int, int>"},
+    {"St6vectorIiSaIiEE", "std::vector<int, std::allocator<int> >"},
+    {"NSt7__cxx1112basic_stringIcSt11char_traitsIcESaIcEEE",
+     "std::__cxx11::basic_string<char, std::char_traits<char>, std::allocator<char> >"},
+    {"St10unique_ptrIN4game6PlayerESt14default_deleteIS1_EE",
+     "std::unique_ptr<game::Player, std::default_delete<game::Player> >"},
+    {"N3foo3BarIiLi3EEE", "foo::Bar<int, 3>"},
+    {"PKc", "char const*"},
+    {"RKN4game6PlayerE", "game::Player const&"},
+    {"PFivE", "int (*)()"},
+    {"FvPiE", "void (int*)"},
+    {"A3_i", "int [3]"},
+    {"Z4mainvE5Local", "main()::Local"},
+    {"ZN4game5Actor6updateEvE4Node", "game::Actor::update()::Node"},
+    {"Z4mainvEUlvE_", "main()::{lambda()#1}"},
+    // GCC's internal-linkage marker is dropped.
+    {"*N12_GLOBAL__N_14ImplE", "(anonymous namespace)::Impl"},
+    // Only complete types are accepted.
+    {"", std::nullopt},
+    {"*", std::nullopt},
+    {"N4game", std::nullopt},
+    {"4game6Player", std::nullopt},
+    {"N4game6PlayerE5extra", std::nullopt},
+    {"N4game6PlayerD1Ev", std::nullopt},
+};
+
+void demangleKnownTypes() {
+  for (const DemangleCase& test : kDemangleCases) {
+    const auto demangled = ItaniumDemangler::demangleType(test.mangled);
+    check(demangled == test.expected, std::string("demangleType(\"") + test.mangled + "\")");
+  }
+}
+
+}  // namespace
+
+void runItaniumDemanglerTests() {
+  demangleKnownTypes();
+}
+
+}  // namespace farcal::tests
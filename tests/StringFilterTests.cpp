@@ -0,0 +1,55 @@
+#include "farcal/memory/StringFilter.hpp"
+
+#include "TestSupport.hpp"
+
+#include <string>
+#include <vector>
+
+namespace farcal::tests {
+
+namespace {
+
+using memory::StringFilter;
+
+struct LiteralsCase {
+  const char*              pattern;
+  std::vector<std::string> expected;
+};
+
+const LiteralsCase kLiteralsCases[] = {
+    {"", {}},
+    {"hello", {"hello"}},
+    {"foo.*bar", {"foo", "bar"}},
+    // `+` keeps one copy of its atom but ends the run; other quantifiers drop the atom.
+    {"ab+c", {"ab", "c"}},
+    {"a+?b", {"a", "b"}},
+    {"colou?r", {"colo", "r"}},
+    {"a{2,3}b", {"b"}},
+    // Classes, groups and class escapes end a run.
+    {"[abc]def", {"def"}},
+    {"x(ab)y", {"x", "y"}},
+    {"(a|b)c", {"c"}},
+    {"\\d+px", {"px"}},
+    {"\\x41BC", {"BC"}},
+    {"^Player_\\d{3}$", {"Player_"}},
+    // Escaped metacharacters are literal.
+    {"\\.dll$", {".dll"}},
+    // A top-level alternation requires nothing.
+    {"a|b", {}},
+    {"error|warning", {}},
+};
+
+void requiredLiteralsOfPatterns() {
+  for (const LiteralsCase& test : kLiteralsCases) {
+    check(StringFilter::requiredLiterals(test.pattern) == test.expected,
+          std::string("requiredLiterals(\"") + test.pattern + "\")");
+  }
+}
+
+}  // namespace
+
+void runStringFilterTests() {
+  requiredLiteralsOfPatterns();
+}
+
+}  // namespace farcal::tests
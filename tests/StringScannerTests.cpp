@@ -0,0 +1,139 @@
+#include "farcal/memory/StringScanner.hpp"
+
+#include "TestSupport.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace farcal::tests {
+
+namespace {
+
+using memory::StringScanner;
+using Range = StringScanner::AddressRange;
+
+constexpr std::uintptr_t kPage = StringScanner::kPageSize;
+
+struct Page {
+  std::uintptr_t address;
+  std::uint64_t  hash;
+};
+
+// Pages in ascending order; consecutive pages share a span.
+StringScanner::PageHashes hashesOf(const std::vector<Page>& pages) {
+  StringScanner::PageHashes hashes;
+  for (const Page& page : pages) {
+    if (hashes.spans.empty()
+        || hashes.spans.back().base + hashes.spans.back().pages * kPage != page.address) {
+      hashes.spans.push_back({page.address, hashes.hashes.size(), 0});
+    }
+    ++hashes.spans.back().pages;
+    hashes.hashes.push_back(page.hash);
+  }
+  return hashes;
+}
+
+bool sameRanges(const std::vector<Range>& actual, const std::vector<Range>& expected) {
+  if (actual.size() != expected.size()) {
+    return false;
+  }
+  for (std::size_t i = 0; i < actual.size(); ++i) {
+    if (actual[i].begin != expected[i].begin || actual[i].end != expected[i].end) {
+      return false;
+    }
+  }
+  return true;
+}
+
+struct ChangedCase {
+  const char*        name;
+  std::vector<Page>  before;
+  std::vector<Page>  after;
+  std::vector<Range> expected;
+};
+
+const ChangedCase kChangedCases[] = {
+    {"both empty", {}, {}, {}},
+    {"unchanged", {{0x10000, 1}, {0x11000, 2}}, {{0x10000, 1}, {0x11000, 2}}, {}},
+    {"one page rewritten",
+     {{0x10000, 1}, {0x11000, 2}, {0x12000, 3}},
+     {{0x10000, 1}, {0x11000, 9}, {0x12000, 3}},
+     {{0x11000, 0x12000}}},
+    {"adjacent pages merge",
+     {{0x10000, 1}, {0x11000, 2}, {0x12000, 3}},
+     {{0x10000, 7}, {0x11000, 8}, {0x12000, 3}},
+     {{0x10000, 0x12000}}},
+    {"separate pages stay separate",
+     {{0x10000, 1}, {0x11000, 2}, {0x12000, 3}},
+     {{0x10000, 7}, {0x11000, 2}, {0x12000, 9}},
+     {{0x10000, 0x11000}, {0x12000, 0x13000}}},
+    {"mapped in between",
+     {{0x10000, 1}},
+     {{0x10000, 1}, {0x20000, 5}, {0x21000, 6}},
+     {{0x20000, 0x22000}}},
+    {"released in between",
+     {{0x10000, 1}, {0x11000, 2}, {0x30000, 3}},
+     {{0x10000, 1}},
+     {{0x11000, 0x12000}, {0x30000, 0x31000}}},
+    {"a released page next to a rewritten one merges",
+     {{0x10000, 1}, {0x11000, 2}},
+     {{0x10000, 4}},
+     {{0x10000, 0x12000}}},
+};
+
+void changedRangesOfPageHashes() {
+  for (const ChangedCase& test : kChangedCases) {
+    check(sameRanges(StringScanner::changedRanges(hashesOf(test.before), hashesOf(test.after)),
+                     test.expected),
+          std::string("changedRanges: ") + test.name);
+  }
+}
+
+struct AffectedCase {
+  const char*        name;
+  std::size_t        max_length;
+  std::vector<Range> changed;
+  std::vector<Range> expected;
+};
+
+// A string is affected from up to max_length * 4 + 4 bytes before a change (its lookahead) to the
+// 4 lead bytes after it.
+const AffectedCase kAffectedCases[] = {
+    {"nothing changed", 512, {}, {}},
+    {"one range", 512, {{0x10000, 0x11000}}, {{0x10000 - 2052, 0x11004}}},
+    {"shorter strings reach less far", 16, {{0x10000, 0x11000}}, {{0x10000 - 68, 0x11004}}},
+    {"ranges within reach merge",
+     512,
+     {{0x10000, 0x11000}, {0x11800, 0x12000}},
+     {{0x10000 - 2052, 0x12004}}},
+    {"ranges out of reach stay apart",
+     16,
+     {{0x10000, 0x11000}, {0x12000, 0x13000}},
+     {{0x10000 - 68, 0x11004}, {0x12000 - 68, 0x13004}}},
+    {"clamped at zero", 512, {{0x0, 0x1000}}, {{0x0, 0x1004}}},
+    {"clamped at the top of the address space",
+     16,
+     {{(std::numeric_limits<std::uintptr_t>::max)() - 0x1000 + 1,
+       (std::numeric_limits<std::uintptr_t>::max)()}},
+     {{(std::numeric_limits<std::uintptr_t>::max)() - 0x1000 + 1 - 68,
+       (std::numeric_limits<std::uintptr_t>::max)()}}},
+};
+
+void affectedRangesOfChanges() {
+  for (const AffectedCase& test : kAffectedCases) {
+    StringScanner::ScanOptions options{};
+    options.max_length = test.max_length;
+    check(sameRanges(StringScanner::affectedRanges(test.changed, options), test.expected),
+          std::string("affectedRanges: ") + test.name);
+  }
+}
+
+}  // namespace
+
+void runStringScannerTests() {
+  changedRangesOfPageHashes();
+  affectedRangesOfChanges();
+}
+
+}  // namespace farcal::tests
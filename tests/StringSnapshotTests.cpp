@@ -0,0 +1,111 @@
+#include "farcal/memory/StringSnapshot.hpp"
+
+#include "TestSupport.hpp"
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace farcal::tests {
+
+namespace {
+
+using memory::StringScanner;
+using memory::StringSnapshot;
+using Kind = StringSnapshot::ChangeKind;
+
+struct Row {
+  std::uintptr_t          address;
+  std::string_view        text;
+  StringScanner::Encoding encoding = StringScanner::Encoding::Ascii;
+};
+
+struct DiffCase {
+  const char*                         name;
+  std::vector<Row>                    before;
+  std::vector<Row>                    after;
+  std::vector<StringSnapshot::Change> expected;
+};
+
+std::vector<StringScanner::StringRecord> recordsOf(const std::vector<Row>& rows) {
+  std::vector<StringScanner::StringRecord> records;
+  for (const Row& row : rows) {
+    records.push_back(StringScanner::StringRecord{
+        row.address, row.text.data(), static_cast<std::uint32_t>(row.text.size()), row.encoding});
+  }
+  return records;
+}
+
+bool sameChanges(const std::vector<StringSnapshot::Change>& actual,
+                 const std::vector<StringSnapshot::Change>& expected) {
+  if (actual.size() != expected.size()) {
+    return false;
+  }
+  for (std::size_t i = 0; i < actual.size(); ++i) {
+    if (actual[i].kind != expected[i].kind
+        || (actual[i].kind != Kind::Added && actual[i].before_row != expected[i].before_row)
+        || (actual[i].kind != Kind::Removed && actual[i].after_row != expected[i].after_row)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+const DiffCase kDiffCases[] = {
+    {"both empty", {}, {}, {}},
+    {"unchanged", {{0x1000, "alpha"}, {0x2000, "beta"}}, {{0x1000, "alpha"}, {0x2000, "beta"}}, {}},
+    {"all added",
+     {},
+     {{0x1000, "alpha"}, {0x2000, "beta"}},
+     {{Kind::Added, 0, 0}, {Kind::Added, 0, 1}}},
+    {"all removed",
+     {{0x1000, "alpha"}, {0x2000, "beta"}},
+     {},
+     {{Kind::Removed, 0, 0}, {Kind::Removed, 1, 0}}},
+    {"rewritten in place",
+     {{0x1000, "alpha"}, {0x2000, "beta"}},
+     {{0x1000, "alpha"}, {0x2000, "BETA"}},
+     {{Kind::Modified, 1, 1}}},
+    {"same text in another encoding",
+     {{0x1000, "alpha"}},
+     {{0x1000, "alpha", StringScanner::Encoding::Utf16}},
+     {{Kind::Modified, 0, 0}}},
+    {"moved text is removed and added",
+     {{0x1000, "alpha"}, {0x3000, "gamma"}},
+     {{0x1000, "alpha"}, {0x4000, "gamma"}},
+     {{Kind::Removed, 1, 0}, {Kind::Added, 0, 1}}},
+    // Rows are the records' positions, whatever order the scan produced them in.
+    {"ascending by address, rows kept",
+     {{0x3000, "gamma"}, {0x1000, "alpha"}, {0x2000, "beta"}},
+     {{0x2000, "beta!"}, {0x4000, "delta"}, {0x1000, "alpha"}},
+     {{Kind::Modified, 2, 0}, {Kind::Removed, 0, 0}, {Kind::Added, 0, 1}}},
+};
+
+void diffSnapshots() {
+  for (const DiffCase& test : kDiffCases) {
+    const auto before  = recordsOf(test.before);
+    const auto after   = recordsOf(test.after);
+    const auto changes =
+        StringSnapshot::diff(StringSnapshot::build(before), StringSnapshot::build(after));
+    check(sameChanges(changes, test.expected), std::string("diff: ") + test.name);
+  }
+}
+
+// An incremental rescan snapshots only its appended records; their rows still count from the front.
+void diffSnapshotOfAppendedRecords() {
+  const auto before = recordsOf({{0x1000, "alpha"}});
+  const auto after  = recordsOf({{0x1000, "stale"}, {0x1000, "alpha"}, {0x2000, "beta"}});
+
+  const auto changes =
+      StringSnapshot::diff(StringSnapshot::build(before), StringSnapshot::build(after, 1));
+  check(sameChanges(changes, {{Kind::Added, 0, 2}}), "diff against records appended after row 1");
+}
+
+}  // namespace
+
+void runStringSnapshotTests() {
+  diffSnapshots();
+  diffSnapshotOfAppendedRecords();
+}
+
+}  // namespace farcal::tests
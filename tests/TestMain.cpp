@@ -0,0 +1,20 @@
+#include "TestSupport.hpp"
+
+#include <cstdio>
+
+int main() {
+  using namespace farcal::tests;
+
+  runClassHierarchyTests();
+  runItaniumDemanglerTests();
+  runStringFilterTests();
+  runStringScannerTests();
+  runStringSnapshotTests();
+
+  if (g_failures != 0) {
+    std::fprintf(stderr, "%d check(s) failed\n", g_failures);
+    return 1;
+  }
+  std::puts("all checks passed");
+  return 0;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdio>
+#include <string_view>
+
+namespace farcal::tests {
+
+inline int g_failures = 0;
+
+inline void check(bool condition, std::string_view what) {
+  if (!condition) {
+    std::fprintf(stderr, "FAILED: %.*s\n", static_cast<int>(what.size()), what.data());
+    ++g_failures;
+  }
+}
+
+// One per test file, called from TestMain.cpp.
+void runClassHierarchyTests();
+void runItaniumDemanglerTests();
+void runStringFilterTests();
+void runStringScannerTests();
+void runStringSnapshotTests();
+
+}  // namespace farcal::tests